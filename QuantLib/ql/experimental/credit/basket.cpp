@@ -218,10 +218,12 @@ namespace QuantLib {
         QL_REQUIRE(d >= refDate_, "Target date lies before basket inception");
         vector<Real> prob;
         const std::vector<Size>& alive = liveList();
+        // the keys are built by the pool on each call, fetch them once
+        const std::vector<DefaultProbKey> defaultKeys = pool_->defaultKeys();
 
         for(Size i=0; i<alive.size(); i++)
             prob.push_back(pool_->get(pool_->names()[i]).defaultProbability(
-                pool_->defaultKeys()[i])->defaultProbability(d, true));
+                defaultKeys[i])->defaultProbability(d, true));
         return prob;
     }
 
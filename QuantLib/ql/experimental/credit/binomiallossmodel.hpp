@@ -83,13 +83,44 @@ namespace QuantLib {
             expectedDistribution(const Date& date) const {
             // precal date conditional magnitudes:
             std::vector<Real> notionals = basket_->remainingNotionals(date);
-            std::vector<Probability> invProbs = 
+            std::vector<Probability> probs = 
                 basket_->remainingProbabilities(date);
+            return expectedDistribution(date, notionals, probs);
+        }
+        //! attainable loss points this model provides
+        Disposable<std::vector<Real> > lossPoints(const Date&) const;
+        //! Returns the cumulative full loss distribution
+        Disposable<std::map<Real, Probability> > 
+            lossDistribution(const Date& d) const;
+        //! Loss level for this percentile
+        Real percentile(const Date& d, Real percentile) const;
+        Real expectedShortfall(const Date&d, Real percentile) const;
+        Real expectedTrancheLoss(const Date& d) const;
+    protected:
+        // Model internal workings ----------------
+        /* As the above, on the remaining basket magnitudes at the date;
+           these are not cheap to query so callers needing both the loss
+           points and their probabilities fetch them once. */
+        Disposable<std::vector<Real> > 
+            expectedDistribution(const Date& date, 
+                const std::vector<Real>& notionals,
+                const std::vector<Probability>& probs) const {
+            // the distribution does not depend on the tranche, other 
+            //   tranches on the same pool might have computed it already
+            const std::vector<Real>* cached = distributionCache_.find(date, 
+                probs, notionals, copula_->factorWeights());
+            if(cached) {
+                std::vector<Real> distribution(*cached);
+                return distribution;
+            }
+
+            std::vector<Real> invProbs(probs.size());
             for(Size iName=0; iName<invProbs.size(); iName++)
                 invProbs[iName] = 
-                    copula_->inverseCumulativeY(invProbs[iName], iName);
+                    copula_->inverseCumulativeY(probs[iName], iName);
 
-            return copula_->integratedExpectedValue(
+            std::vector<Real> distribution = 
+                copula_->integratedExpectedValue(
                 boost::function<Disposable<std::vector<Real> > (
                   const std::vector<Real>& v1)>(
                     boost::bind(
@@ -101,18 +132,13 @@ namespace QuantLib {
                         _1)
                     )
                 );
+            distributionCache_.store(date, probs, notionals, 
+                copula_->factorWeights(), distribution);
+            return distribution;
         }
-        //! attainable loss points this model provides
-        Disposable<std::vector<Real> > lossPoints(const Date&) const;
-        //! Returns the cumulative full loss distribution
-        Disposable<std::map<Real, Probability> > 
-            lossDistribution(const Date& d) const;
-        //! Loss level for this percentile
-        Real percentile(const Date& d, Real percentile) const;
-        Real expectedShortfall(const Date&d, Real percentile) const;
-        Real expectedTrancheLoss(const Date& d) const;
-    protected:
-        // Model internal workings ----------------
+        Disposable<std::vector<Real> > lossPoints(const Date&,
+            const std::vector<Real>& notionals,
+            const std::vector<Probability>& probs) const;
         //! Average loss per credit.
         Real averageLoss(const Date&, const std::vector<Real>& reminingNots, 
             const std::vector<Real>&) const;
@@ -149,6 +175,9 @@ namespace QuantLib {
         // cached arguments:
         // remaining basket magnitudes:
         mutable Real attachAmount_, detachAmount_;
+        // tranche independent results, by date:
+        mutable detail::LossDistributionCache lossPointsCache_, 
+            distributionCache_;
     };
 
     //-------------------------------------------------------------------------
@@ -175,26 +204,25 @@ namespace QuantLib {
             1-RR_i
         */
         // conditional fractional LGD expected as given by the recovery model 
-        //   for the ramaining(live) names at the current eval date.
-        std::vector<Real> fractionalEL = expConditionalLgd(date, mktFactors);
-        std::vector<Real> lgdsLeft;
-        std::transform(fractionalEL.begin(), fractionalEL.end(), 
-            bsktNots.begin(), std::back_inserter(lgdsLeft), 
-            std::multiplies<Real>());
-        Real avgLgd = 
-            std::accumulate(lgdsLeft.begin(), lgdsLeft.end(), Real(0.)) /
-                bsktSize;
-
-        std::vector<Probability> condDefProb(bsktSize, 0.);
-        for(Size j=0; j<bsktSize; j++)//transform
-            condDefProb[j] = 
+        //   for the ramaining(live) names at the current eval date. The 
+        //   moments of the loss are accumulated in a single pass over the 
+        //   names, in the same order as the former per-moment transforms.
+        const std::vector<Size>& evalDateLives = basket_->liveList();
+        Real sumLgds = 0., sumProbLgds = 0., variance = 0.;
+        for(Size j=0; j<bsktSize; j++) {
+            Real lgd = (1.-copula_->conditionalRecovery(date, 
+                evalDateLives[j], mktFactors)) * bsktNots[j];
+            Probability condDefProb = 
                 copula_->conditionalDefaultProbabilityInvP(uncondDefProbInv[j],
                     j, mktFactors);
+            sumLgds += lgd;
+            sumProbLgds += condDefProb * lgd;
+            variance += (condDefProb * (1. - condDefProb)) * (lgd * lgd);
+        }
+        Real avgLgd = sumLgds / bsktSize;
         // of full portfolio:
         Real avgProb = avgLgd <= QL_EPSILON ? 0. : // only if all are 0
-                std::inner_product(condDefProb.begin(), 
-                    condDefProb.end(), lgdsLeft.begin(), 0.)
-                / (avgLgd * bsktSize);
+                sumProbLgds / (avgLgd * bsktSize);
         // model parameters:
         Real m = avgProb * bsktSize;
         Real floorAveProb = std::min(Real(bsktSize-1), std::floor(Real(m)));
@@ -202,20 +230,6 @@ namespace QuantLib {
         // nu_A
         Real varianceBinom = avgProb * (1. - avgProb)/bsktSize;
         // nu_E
-        std::vector<Probability> oneMinusDefProb;//: 1.-condDefProb[j]
-        std::transform(condDefProb.begin(), condDefProb.end(), 
-            std::back_inserter(oneMinusDefProb), 
-            std::bind1st(std::minus<Real>(), 1.));
-
-        //breaks condDefProb and lgdsLeft to spare memory
-        std::transform(condDefProb.begin(), condDefProb.end(), 
-            oneMinusDefProb.begin(), condDefProb.begin(), 
-            std::multiplies<Real>());
-        std::transform(lgdsLeft.begin(), lgdsLeft.end(), 
-            lgdsLeft.begin(), lgdsLeft.begin(), std::multiplies<Real>());
-        Real variance = std::inner_product(condDefProb.begin(), 
-            condDefProb.end(), lgdsLeft.begin(), 0.);
-
         variance = avgLgd <= QL_EPSILON ? 0. : 
             variance / (bsktSize * bsktSize * avgLgd * avgLgd );
         Real sumAves = -std::pow(ceilAveProb-m, 2) 
@@ -287,6 +301,22 @@ namespace QuantLib {
         BinomialLossModel<LLM>::lossPoints(const Date& d) const 
     {
         std::vector<Real> notionals = basket_->remainingNotionals(d);
+        std::vector<Probability> probs = basket_->remainingProbabilities(d);
+        return lossPoints(d, notionals, probs);
+    }
+
+    template< class LLM>
+    Disposable<std::vector<Real> >
+        BinomialLossModel<LLM>::lossPoints(const Date& d,
+            const std::vector<Real>& notionals,
+            const std::vector<Probability>& probs) const 
+    {
+        const std::vector<Real>* cached = lossPointsCache_.find(d, probs, 
+            notionals, copula_->factorWeights());
+        if(cached) {
+            std::vector<Real> data(*cached);
+            return data;
+        }
 
         Real aveLossFrct = copula_->integratedExpectedValue(
             boost::function<Real (const std::vector<Real>& v1)>(
@@ -306,6 +336,8 @@ namespace QuantLib {
         Real outsNot = basket_->remainingNotional(d);
         for(Size i=0; i<dataSize; i++)
             data.push_back(i * aveLossFrct * outsNot);
+        lossPointsCache_.store(d, probs, notionals, copula_->factorWeights(),
+            data);
         return data;
     }
 
@@ -329,26 +361,25 @@ namespace QuantLib {
         return suma;
     }
 
+    /* The loss points do not depend on the market factor, so integrating
+    condTrancheLoss is the same as weighting the payoff on the loss points 
+    by their unconditional probabilities.
+    */
     template< class LLM>
     Real BinomialLossModel<LLM>::expectedTrancheLoss(const Date& d) const {
-        std::vector<Real> lossVals  = lossPoints(d);
         std::vector<Real> notionals = basket_->remainingNotionals(d);
-        std::vector<Probability> invProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size iName=0; iName<invProbs.size(); iName++)
-            invProbs[iName] = 
-                copula_->inverseCumulativeY(invProbs[iName], iName);
-            
-        return copula_->integratedExpectedValue(
-            boost::function<Real (const std::vector<Real>& v1)>(
-                boost::bind(&BinomialLossModel<LLM>::condTrancheLoss,
-                            this,
-                            boost::cref(d), 
-                            boost::cref(lossVals), 
-                            boost::cref(notionals), 
-                            boost::cref(invProbs), 
-                            _1))
-            );
+        std::vector<Probability> probs = basket_->remainingProbabilities(d);
+        std::vector<Real> lossVals  = lossPoints(d, notionals, probs);
+        std::vector<Real> lossProbs = 
+            expectedDistribution(d, notionals, probs);
+
+        Real suma = 0.;
+        for(Size i=0; i<lossVals.size(); i++) { 
+            suma += lossProbs[i] * 
+                std::min(std::max(lossVals[i]
+                 - attachAmount_, 0.), detachAmount_ - attachAmount_);
+        }
+        return suma;
     }
 
 
@@ -357,8 +388,10 @@ namespace QuantLib {
         BinomialLossModel<LLM>::lossDistribution(const Date& d) const 
     {
         std::map<Real, Probability> distrib;
-        std::vector<Real> lossPts = lossPoints(d);
-        std::vector<Real> values  = expectedDistribution(d);
+        std::vector<Real> notionals = basket_->remainingNotionals(d);
+        std::vector<Probability> probs = basket_->remainingProbabilities(d);
+        std::vector<Real> lossPts = lossPoints(d, notionals, probs);
+        std::vector<Real> values  = expectedDistribution(d, notionals, probs);
         Real sum = 0.;
         for(Size i=0; i<lossPts.size(); i++) {
             distrib.insert(std::make_pair(lossPts[i], 
@@ -44,9 +44,11 @@ namespace QuantLib {
             const std::vector<std::vector<Real> >& factorWeights,
             const std::vector<Real>& recoveries,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
-            const initTraits& ini = initTraits()            
+            const initTraits& ini = initTraits(),
+            Size sparseGridLevel = 8
             ) 
-        : DefaultLatentModel<copulaPolicy>(factorWeights, integralType, ini),
+        : DefaultLatentModel<copulaPolicy>(factorWeights, integralType, ini,
+                                           sparseGridLevel),
           recoveries_(recoveries) {
 
               QL_REQUIRE(recoveries.size() == factorWeights.size(), 
@@ -58,10 +60,12 @@ namespace QuantLib {
             const std::vector<Real>& recoveries,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
             Size nVariables,
-            const initTraits& ini = initTraits()            
+            const initTraits& ini = initTraits(),
+            Size sparseGridLevel = 8
             ) 
         : DefaultLatentModel<copulaPolicy>(mktCorrel, nVariables,
-                                           integralType, ini),
+                                           integralType, ini,
+                                           sparseGridLevel),
           recoveries_(recoveries) {
             // actually one could define the other and get rid of the variable 
             // here and in other similar models
@@ -125,9 +129,10 @@ namespace QuantLib {
             const std::vector<Real>& recoveries,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
             const typename copulaPolicy::initTraits& ini = 
-                copulaPolicy::initTraits()) 
+                copulaPolicy::initTraits(),
+            Size sparseGridLevel = 8) 
         : ConstantLossLatentmodel<copulaPolicy>(factorWeights, recoveries, 
-            integralType, ini) {}
+            integralType, ini, sparseGridLevel) {}
 
         ConstantLossModel(
             const Handle<Quote>& mktCorrel,
@@ -135,9 +140,10 @@ namespace QuantLib {
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
             Size nVariables,
             const typename copulaPolicy::initTraits& ini = 
-                copulaPolicy::initTraits()) 
+                copulaPolicy::initTraits(),
+            Size sparseGridLevel = 8) 
         : ConstantLossLatentmodel<copulaPolicy>(mktCorrel, recoveries, 
-            integralType, nVariables,ini) {}
+            integralType, nVariables,ini, sparseGridLevel) {}
 
     protected:
         //Disposable<std::vector<Probability> > probsBeingNthEvent(
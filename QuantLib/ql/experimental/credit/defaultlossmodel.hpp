@@ -27,6 +27,7 @@
 #include <ql/experimental/credit/basket.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <map>
 
 /* Intended to replace LossDistribution in 
     ql/experimental/credit/lossdistribution, not sure its covering all the 
@@ -35,6 +36,62 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* Unconditional loss distributions by date, for models whose
+        distribution does not depend on the tranche limits. The tranches of
+        an index written on the same pool reset the model to a new basket
+        but share the distribution; an entry is reused only if the inputs
+        it was computed from (live probabilities and notionals, factor
+        loadings) are unchanged.
+        */
+        class LossDistributionCache {
+          public:
+            //! null if there's no valid entry for the date
+            const std::vector<Real>* find(
+                const Date& d,
+                const std::vector<Probability>& probabilities,
+                const std::vector<Real>& notionals,
+                const std::vector<std::vector<Real> >& factorWeights) const {
+                std::map<Date, Entry>::const_iterator i = entries_.find(d);
+                if (i == entries_.end() || i->second.inputs != 
+                    inputs(probabilities, notionals, factorWeights))
+                    return 0;
+                return &i->second.distribution;
+            }
+            const std::vector<Real>& store(
+                const Date& d,
+                const std::vector<Probability>& probabilities,
+                const std::vector<Real>& notionals,
+                const std::vector<std::vector<Real> >& factorWeights,
+                const std::vector<Real>& distribution) {
+                Entry& entry = entries_[d];
+                entry.inputs = inputs(probabilities, notionals, factorWeights);
+                entry.distribution = distribution;
+                return entry.distribution;
+            }
+            void clear() { entries_.clear(); }
+          private:
+            struct Entry {
+                std::vector<Real> inputs, distribution;
+            };
+            static std::vector<Real> inputs(
+                const std::vector<Probability>& probabilities,
+                const std::vector<Real>& notionals,
+                const std::vector<std::vector<Real> >& factorWeights) {
+                std::vector<Real> result(probabilities);
+                result.insert(result.end(), notionals.begin(), 
+                    notionals.end());
+                for(Size i=0; i<factorWeights.size(); i++)
+                    result.insert(result.end(), factorWeights[i].begin(), 
+                        factorWeights[i].end());
+                return result;
+            }
+            std::map<Date, Entry> entries_;
+        };
+
+    }
+
     /*! Default loss model interface definition.
     Allows communication between the basket and specific algorithms. Intended to
     hold any kind of portfolio joint loss, latent models, top-down,....
@@ -64,27 +64,32 @@ namespace QuantLib {
             variable.
         @param integralType Integration type.
         @param ini Copula initialization if any.
+        @param sparseGridLevel Level of the sparse grid integration types;
+            ignored by the other types.
 
         \warning Baskets with realized defaults not tested/WIP.
         */
         DefaultLatentModel(
             const std::vector<std::vector<Real> >& factorWeights,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
-            const initTraits& ini = initTraits()
+            const initTraits& ini = initTraits(),
+            Size sparseGridLevel = 8
             ) 
         : LatentModel<copulaPolicy>(factorWeights, ini),
           integration_(LatentModel<copulaPolicy>::IntegrationFactory::
-            createLMIntegration(factorWeights[0].size(), integralType))
+            createLMIntegration(factorWeights[0].size(), integralType,
+                                sparseGridLevel))
         { }
         DefaultLatentModel(
             const Handle<Quote>& mktCorrel,
             Size nVariables,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
-            const initTraits& ini = initTraits()
+            const initTraits& ini = initTraits(),
+            Size sparseGridLevel = 8
             )
         : LatentModel<copulaPolicy>(mktCorrel, nVariables, ini),
           integration_(LatentModel<copulaPolicy>::IntegrationFactory::
-            createLMIntegration(1, integralType))
+            createLMIntegration(1, integralType, sparseGridLevel))
         { }
         /* \todo
             Add other constructors as in LatentModel for ease of use. (less 
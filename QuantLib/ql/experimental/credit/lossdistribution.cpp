@@ -19,6 +19,8 @@
 
 #include <ql/experimental/credit/lossdistribution.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
 
 using namespace std;
 
@@ -298,6 +300,78 @@ namespace QuantLib {
         return nBuckets_;
     }
 
+    //--------------------------------------------------------------------------
+    Distribution LossDistFFT::operator()(const vector<Real>& nominals,
+                                    const vector<Real>& probabilities) const {
+    //--------------------------------------------------------------------------
+        QL_REQUIRE (nominals.size() == probabilities.size(), "sizes differ: "
+                    << nominals.size() << " vs " << probabilities.size());
+        QL_REQUIRE (nBuckets_ > 0, "no buckets given");
+
+        Real dx = maximum_ / nBuckets_;
+        vector<Size> units (nominals.size());
+        Size totalUnits = 0;
+        for (Size i = 0; i < nominals.size(); i++) {
+            QL_REQUIRE (nominals[i] >= 0.0, "negative volume "
+                        << nominals[i] << " at i=" << i);
+            units[i] = Size(std::floor(0.5 + nominals[i] / dx));
+            totalUnits += units[i];
+        }
+
+        // without aliasing the grid only needs to cover the buckets;
+        // otherwise it is made eight times larger and the transform
+        // damped by theta^k, so that the mass folding back from beyond
+        // the grid is reduced by a factor 1e-24 while the round-off
+        // amplification on the buckets stays below 1e3
+        Size order = std::max<Size>(FastFourierTransform::min_order(nBuckets_),
+                                    1);
+        Real theta = 1.0;
+        if (totalUnits >= (Size(1) << order)) {
+            order += 3;
+            theta = std::pow(1.0e-24, 1.0 / (Size(1) << order));
+        }
+        FastFourierTransform fft(order);
+        const Size N = fft.output_size();
+
+        vector<std::complex<Real> > roots (N);
+        for (Size m = 0; m < N; m++)
+            roots[m] = std::complex<Real>(std::cos(2.0 * M_PI * m / N),
+                                          -std::sin(2.0 * M_PI * m / N));
+        vector<Real> dampedUnits (nominals.size());
+        for (Size i = 0; i < nominals.size(); i++)
+            dampedUnits[i] = std::pow(theta, Real(units[i]));
+
+        // damped characteristic function; the loss is real, so that the
+        // upper half of the frequencies are the conjugates of the lower
+        vector<std::complex<Real> > phi (N);
+        for (Size j = 0; j <= N/2; j++) {
+            std::complex<Real> prod (1.0, 0.0);
+            for (Size i = 0; i < nominals.size(); i++) {
+                Real P = probabilities[i];
+                prod *= (1.0 - P) + P * dampedUnits[i]
+                                      * roots[(j * (units[i] % N)) % N];
+            }
+            phi[j] = prod;
+            if (j > 0 && j < N/2)
+                phi[N-j] = std::conj(prod);
+        }
+
+        vector<std::complex<Real> > p (N);
+        fft.inverse_transform(phi.begin(), phi.end(), p.begin());
+
+        Distribution dist (nBuckets_, 0.0, maximum_);
+        Real damping = 1.0;
+        for (Size k = 0; k < nBuckets_; k++) {
+            // remove round-off negatives
+            Real pk = std::max(p[k].real() / N / damping, 0.0);
+            dist.addDensity (k, pk / dx);
+            dist.addAverage (k, dx * k);
+            damping *= theta;
+        }
+
+        return dist;
+    }
+
     //--------------------------------------------------------------------------
     Distribution LossDistMonteCarlo::operator()(const vector<Real>& nominals,
                                    const vector<Real>& probabilities) const {
@@ -197,6 +197,42 @@ namespace QuantLib {
         Real epsilon_;
     };
 
+    //! Loss distribution by Fourier inversion
+    /*! Loss distribution for varying volumes and probabilities of default, 
+      independence assumed.
+
+      Volumes are rounded to the nearest multiple of the bucket width
+      maximum/nBuckets, and the distribution of the resulting lattice 
+      loss is recovered with an inverse FFT from its characteristic 
+      function, the product of the single credit ones. The cost is 
+      proportional to the number of credits times the number of buckets, 
+      while the recursive convolutions above grow quadratically in the 
+      latter. Losses beyond the maximum would alias into the grid; the 
+      characteristic function is exponentially damped to suppress them,
+      following
+
+      Paul Embrechts and Marco Frei, "Panjer recursion versus FFT for 
+      compound distributions", Mathematical Methods of Operations 
+      Research 69, 3, 2009
+
+      As in LossDistBucketing, the probability of losses beyond the 
+      maximum is not assigned to any bucket.
+
+      \ingroup probability
+    */
+    class LossDistFFT : public LossDist {
+    public:
+        LossDistFFT (Size nBuckets, Real maximum)
+            : nBuckets_(nBuckets), maximum_(maximum) {}
+        Distribution operator()(const std::vector<Real>& volumes, 
+                                const std::vector<Real>& probabilities) const;
+        Size buckets () const { return nBuckets_; }
+        Real maximum () const { return maximum_; }
+    private:
+        Size nBuckets_;
+        Real maximum_;
+    };
+
     //! Loss distribution with Monte Carlo simulation
     /*!
       Loss distribution for varying volumes and probabilities of default
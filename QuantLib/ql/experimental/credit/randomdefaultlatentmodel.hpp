@@ -35,6 +35,7 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <string>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -73,10 +74,17 @@ namespace QuantLib {
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    The simulations can be split among several workers, run in parallel if
+    OpenMP is enabled. Each worker owns its factor sampler, positioned at
+    the beginning of its own block of the sequence, and its own events
+    buffer; buffers are then moved into the store in worker order. Thus the
+    stored simulations are the same as those of the single-threaded run.
+    nextSample must not modify the model; all lazy calculations (e.g. the
+    default curves) must be triggered by initDates.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -107,7 +115,7 @@ namespace QuantLib {
             Size nSims,
             BigNatural seed)
         : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars),
-          nSims_(nSims), copula_(copula) {}
+          nSims_(nSims), nWorkers_(1), copula_(copula) {}
 
         void update() {
             simsBuffer_.clear();
@@ -124,13 +132,59 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
+            if(nWorkers_ > 1 && nSims_ > 1) {
+                performParallelSimulations();
+                return;
+            }
+            simsBuffer_.reserve(nSims_);
             // Next sequence should determine the event and push it into buffer
             for(Size i=nSims_; i; i--) {
                 const std::vector<Real>& sample =
                     copulasRng_->nextSequence().value;
+                simsBuffer_.push_back(std::vector<simEvent<
+                    derivedRandomLM<copulaPolicy, USNG> > >());
                 static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+                    this)->nextSample(sample, simsBuffer_.back());
+            }
+        }
+
+        void performParallelSimulations() const {
+            typedef std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >
+                events_type;
+            const Size nWorkers = std::min(nWorkers_, nSims_);
+            std::vector<std::vector<events_type> > buffers(nWorkers);
+            std::vector<std::string> failures(nWorkers);
+
+            #pragma omp parallel for schedule(static,1)
+            for(long w=0; w<(long)nWorkers; w++) {
+                try {
+                    // contiguous blocks of the sequence
+                    Size first = w*(nSims_/nWorkers)
+                        + std::min(Size(w), nSims_%nWorkers);
+                    Size n = nSims_/nWorkers
+                        + (Size(w) < nSims_%nWorkers ? 1 : 0);
+                    copulaRNG_type rng(copula_, seed_);
+                    rng.skipTo(first);
+                    buffers[w].reserve(n);
+                    for(Size i=0; i<n; i++) {
+                        buffers[w].push_back(events_type());
+                        static_cast<const derivedRandomLM<copulaPolicy,
+                            USNG>* >(this)->nextSample(
+                                rng.nextSequence().value, buffers[w].back());
+                    }
+                } catch (std::exception& e) {
+                    failures[w] = e.what();
+                }
+            }
+
+            simsBuffer_.reserve(nSims_);
+            for(Size w=0; w<nWorkers; w++) {
+                QL_REQUIRE(failures[w].empty(),
+                    "simulation worker #" << w << ": " << failures[w]);
+                for(Size i=0; i<buffers[w].size(); i++) {
+                    simsBuffer_.push_back(events_type());
+                    simsBuffer_.back().swap(buffers[w][i]);
+                }
             }
         }
 
@@ -207,6 +261,17 @@ namespace QuantLib {
         //@}
     public:
         virtual ~RandomLM() {}
+        /*! Sets the number of workers among which the simulations are
+            split. The results do not depend on this number.
+        */
+        void setNumberOfWorkers(Size n) {
+            QL_REQUIRE(n > 0, "at least one worker required");
+            if(n != nWorkers_) {
+                nWorkers_ = n;
+                update();
+            }
+        }
+        Size numberOfWorkers() const { return nWorkers_; }
     private:
         BigNatural seed_;
     protected:
@@ -214,6 +279,7 @@ namespace QuantLib {
         const Size numLMVars_;
 
         const Size nSims_;
+        Size nWorkers_;
 
         mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
             USNG > > > > simsBuffer_;
@@ -874,7 +940,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+                        std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -933,11 +1000,11 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
         // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
@@ -965,8 +1032,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
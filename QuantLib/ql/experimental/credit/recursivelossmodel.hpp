@@ -84,6 +84,14 @@ namespace QuantLib {
         Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate, 
             //const Date& date,
             const std::vector<Real>& mktFactor) const;
+        /*! Conditional probabilities of the losses in loss units, i.e. the
+        k-th value is the probability of losing k times the loss unit; 
+        unattainable losses have a zero probability. The recursion runs on a
+        contiguous buffer instead of a map of attainable losses.
+        */
+        Disposable<std::vector<Real> > conditionalLossDensityInvP(
+            const std::vector<Real>& invpDefDate, 
+            const std::vector<Real>& mktFactor) const;
     protected:
         void resetModel();
     public:
@@ -103,6 +111,16 @@ namespace QuantLib {
             makes it easier this way.
         */
        Real expectedTrancheLoss(const Date& date) const;
+       /*! Probabilities of the pool losses in loss units, the k-th value
+           being the probability of losing k times the loss unit. 
+           Unattainable losses are included with a zero probability, so 
+           that lossDistribution, percentile and expectedShortfall place 
+           each probability at its actual loss amount also for pools whose
+           loss weights are not consecutive multiples of the loss unit 
+           (formerly only the attainable losses were returned, and they 
+           were then taken to lie on consecutive loss units). The 
+           densities are cached by date and pool state.
+       */
        Disposable<std::vector<Real> > lossProbability(const Date& date) const;
        // REMEBER THIS HAS TO BE MOVED TO A DISTRIBUTION OBJECT.............
        Disposable<std::map<Real, Probability> > lossDistribution(
@@ -130,6 +148,8 @@ namespace QuantLib {
             notional_;
         mutable Size remainingBsktSize_;
         mutable std::vector<Real> notionals_;
+        // unconditional loss densities by date; tranche independent.
+        mutable detail::LossDistributionCache densityCache_;
     };
 
 
@@ -177,22 +197,20 @@ namespace QuantLib {
             );
             */
 /**/
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-        std::vector<Real> invProb;
-        for(Size i=0; i<uncDefProb.size(); ++i)
-           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
-           ///  invProb.push_back(CP::inverseCumulativeY(uncDefProb[i], i));//<-static call
-        return copula_->integratedExpectedValue(
-            boost::function<Real (const std::vector<Real>& v1)>(
-                boost::bind(
-                    &RecursiveLossModel::expectedConditionalLossInvP,
-                    this,
-                    boost::cref(invProb),
-                    _1)
-                )
-            );
-            
+        /* Summation and integration are swapped back: the payoff is 
+        applied to the unconditional density instead of integrating 
+        expectedConditionalLossInvP over the market factor.
+        */
+        std::vector<Real> density = lossProbability(date);
+
+        Real expLoss = 0.;
+        for(Size k=0; k<density.size(); ++k) {
+            Real loss = k * lossUnit_;
+            loss = std::min(std::max(loss - attachAmount_, 0.), 
+                detachAmount_ - attachAmount_);
+            expLoss += loss * density[k];
+        }
+        return expLoss;
     }
 
     template<class CP>
@@ -201,15 +219,29 @@ namespace QuantLib {
 
         std::vector<Probability> uncDefProb = 
             basket_->remainingProbabilities(date);
-        return copula_->integratedExpectedValue(
-            boost::function<Disposable<std::vector<Real> > (const std::vector<Real>& v1)>(
+        const std::vector<Real>* cached = densityCache_.find(date, 
+            uncDefProb, notionals_, copula_->factorWeights());
+        if(cached) {
+            std::vector<Real> density(*cached);
+            return density;
+        }
+
+        std::vector<Real> invProb;
+        for(Size i=0; i<uncDefProb.size(); ++i)
+           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
+        std::vector<Real> density = copula_->integratedExpectedValue(
+            boost::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>& v1)>(
                 boost::bind(
-                    &RecursiveLossModel::conditionalLossProb,
+                    &RecursiveLossModel::conditionalLossDensityInvP,
                     this,
-                    boost::cref(uncDefProb),
+                    boost::cref(invProb),
                     _1)
                 )
             );
+        densityCache_.store(date, uncDefProb, notionals_, 
+            copula_->factorWeights(), density);
+        return density;
     }
 
     // -------------------------------------------------------------------
@@ -227,6 +259,7 @@ namespace QuantLib {
         copula_->resetBasket(basket_.currentLink());
 
         std::vector<Real> lgdsTmp, lgds;
+        wk_.clear();
         for(Size i=0; i<remainingBsktSize_; ++i)
             lgds.push_back(notionals_[i]*(1.-copula_->recoveries()[i]));
         lgdsTmp = lgds;
@@ -475,32 +508,50 @@ namespace QuantLib {
                                  //const Date& date,
                                  const std::vector<Real>& mktFactor) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistribInvP(invPDefDate, mktFactor);
+        std::vector<Real> density =
+            conditionalLossDensityInvP(invPDefDate, mktFactor);
 
         // get the expected value subject to the value of the market
         //   factor.
         Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        std::map<Real, Probability>::iterator distIt =
-            pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-   //         loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
+        for(Size k=0; k<density.size(); ++k) {
+            Real loss = k * lossUnit_;
             loss = std::min(std::max(loss - attachAmount_, 0.), 
                 detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....???
-            expLoss += loss * distIt->second;
-            ++distIt;
+            expLoss += loss * density[k];
         }
         return expLoss ;
     }
 
+    template<class CP>
+    Disposable<std::vector<Real> > 
+        RecursiveLossModel<CP>::conditionalLossDensityInvP(
+            const std::vector<Real>& invpDefDate, 
+            const std::vector<Real>& mktFactor) const 
+    {
+        // eq. 10 p.68, the loss weights are integers in loss units
+        Size maxLoss = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            maxLoss += static_cast<Size>(wk_[iName]);
+        std::vector<Real> density(maxLoss+1, 0.);
+        density[0] = 1.;
+        Size top = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
+            Size wk = static_cast<Size>(wk_[iName]);
+            if(wk == 0) continue;
+            Probability pDef =
+                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
+                    iName, mktFactor);
+            // downwards, so that each loss is shifted before being updated
+            for(Size k=top+1; k>0; --k) {
+                density[k-1+wk] += density[k-1] * pDef;
+                density[k-1] *= (1.-pDef);
+            }
+            top += wk;
+        }
+        return density;
+    }
+
     template<class CP>
     Disposable<std::vector<Real> > RecursiveLossModel<CP>::conditionalLossProb(
         const std::vector<Probability>& pDefDate, 
@@ -140,6 +140,25 @@ namespace QuantLib {
             const std::vector<Real>& invUncondProbs,
             Real saddle, 
             const std::vector<Real>&  mktFactor) const;
+        /*! Conditional default probabilities and losses given default (in 
+        fractional portfolio units) of the live names; these are the only
+        inputs depending on the market factor in the derivatives above.
+        */
+        void conditionalExposures(
+            const std::vector<Real>& invUncondProbs,
+            const std::vector<Real>& mktFactor,
+            std::vector<Probability>& condProbs,
+            std::vector<Real>& lossesInDef) const;
+        //! First derivative on precomputed conditional exposures.
+        static Real CumGen1stDerivativeCond(
+            const std::vector<Probability>& condProbs,
+            const std::vector<Real>& lossesInDef,
+            Real saddle);
+        //! Second derivative on precomputed conditional exposures.
+        static Real CumGen2ndDerivativeCond(
+            const std::vector<Probability>& condProbs,
+            const std::vector<Real>& lossesInDef,
+            Real saddle);
         Real CumGen3rdDerivativeCond(
             const std::vector<Real>& invUncondProbs,
             Real saddle, 
@@ -174,31 +193,30 @@ namespace QuantLib {
         Real CumGen4thDerivative(const Date& date, Real s) const;
         
         // -------- Saddle point search functions ---------------------------
+        /* Works on the conditional exposures, computed once for each market
+        factor value rather than at every solver iteration. */
         class SaddleObjectiveFunction : 
             public std::unary_function<Real, Real> {
-            const SaddlePointLossModel& me_;
             Real targetValue_;
-            const std::vector<Real>& mktFactor_;
-            const std::vector<Real>& invUncondProbs_;
+            const std::vector<Probability>& condProbs_;
+            const std::vector<Real>& lossesInDef_;
         public:
             //! The passed target is in fractional loss units
-            SaddleObjectiveFunction(const SaddlePointLossModel& me,
-                                    const Real target,
-                                    const std::vector<Real>& invUncondProbs,
-                                    const std::vector<Real>& mktFactor
+            SaddleObjectiveFunction(const Real target,
+                                    const std::vector<Probability>& condProbs,
+                                    const std::vector<Real>& lossesInDef
                                     )
-            : me_(me), 
-              targetValue_(target), 
-              mktFactor_(mktFactor), 
-              invUncondProbs_(invUncondProbs)
+            : targetValue_(target), 
+              condProbs_(condProbs), 
+              lossesInDef_(lossesInDef)
             {}
             Real operator()(const Real x) const {
-                return me_.CumGen1stDerivativeCond(invUncondProbs_, x, 
-                    mktFactor_) - targetValue_;
+                return SaddlePointLossModel::CumGen1stDerivativeCond(
+                    condProbs_, lossesInDef_, x) - targetValue_;
             }
             Real derivative(Real x) const {
-                return me_.CumGen2ndDerivativeCond(invUncondProbs_, x, 
-                    mktFactor_);
+                return SaddlePointLossModel::CumGen2ndDerivativeCond(
+                    condProbs_, lossesInDef_, x);
             }
         };
 
@@ -649,17 +667,57 @@ namespace QuantLib {
         Real saddle,
         const std::vector<Real>&  mktFactor) const 
     {
-        const Size nNames = remainingNotionals_.size();
-        Real sum = 0.;
+        std::vector<Probability> condProbs;
+        std::vector<Real> lossesInDef;
+        conditionalExposures(invUncondProbs, mktFactor, condProbs, 
+            lossesInDef);
+        return CumGen1stDerivativeCond(condProbs, lossesInDef, saddle);
+    }
+
+    template<class CP>
+    Real SaddlePointLossModel<CP>::CumGen2ndDerivativeCond(
+        const std::vector<Real>& invUncondProbs,
+        Real saddle, 
+        const std::vector<Real>&  mktFactor) const 
+    {
+        std::vector<Probability> condProbs;
+        std::vector<Real> lossesInDef;
+        conditionalExposures(invUncondProbs, mktFactor, condProbs, 
+            lossesInDef);
+        return CumGen2ndDerivativeCond(condProbs, lossesInDef, saddle);
+    }
 
+    template<class CP>
+    void SaddlePointLossModel<CP>::conditionalExposures(
+        const std::vector<Real>& invUncondProbs,
+        const std::vector<Real>& mktFactor,
+        std::vector<Probability>& condProbs,
+        std::vector<Real>& lossesInDef) const 
+    {
+        const Size nNames = remainingNotionals_.size();
+        condProbs.resize(nNames);
+        lossesInDef.resize(nNames);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
+            condProbs[iName] = 
                 copula_->conditionalDefaultProbabilityInvP(
                     invUncondProbs[iName], iName, mktFactor);
             // loss in fractional units
-            Real lossInDef = remainingNotionals_[iName] * 
+            lossesInDef[iName] = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
+        }
+    }
+
+    template<class CP>
+    Real SaddlePointLossModel<CP>::CumGen1stDerivativeCond(
+        const std::vector<Probability>& condProbs,
+        const std::vector<Real>& lossesInDef,
+        Real saddle)
+    {
+        Real sum = 0.;
+        for(Size iName=0; iName < condProbs.size(); iName++) {
+            const Probability pBuffer = condProbs[iName];
+            const Real lossInDef = lossesInDef[iName];
             Real midFactor = pBuffer * std::exp(lossInDef * saddle);
             sum += lossInDef * midFactor / (1.-pBuffer + midFactor);
         }
@@ -668,21 +726,14 @@ namespace QuantLib {
 
     template<class CP>
     Real SaddlePointLossModel<CP>::CumGen2ndDerivativeCond(
-        const std::vector<Real>& invUncondProbs,
-        Real saddle, 
-        const std::vector<Real>&  mktFactor) const 
+        const std::vector<Probability>& condProbs,
+        const std::vector<Real>& lossesInDef,
+        Real saddle)
     {
-        const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
-
-        for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
-            // loss in fractional units
-            Real lossInDef = remainingNotionals_[iName] * 
-                (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
-                    iName, mktFactor)) / remainingNotional_;
+        for(Size iName=0; iName < condProbs.size(); iName++) {
+            const Probability pBuffer = condProbs[iName];
+            const Real lossInDef = lossesInDef[iName];
             Real midFactor = pBuffer * std::exp(lossInDef * saddle);
             Real denominator = 1.-pBuffer + midFactor;
             sum += lossInDef * lossInDef * midFactor / denominator - 
@@ -847,7 +898,11 @@ namespace QuantLib {
         // \to do:
         // REQUIRE that loss level is below the max loss attainable in 
         //   the portfolio, otherwise theres no solution...
-        SaddleObjectiveFunction f(*this, lossLevel, invUncondPs, mktFactor);
+        // conditional exposures are computed once for all the iterations
+        std::vector<Probability> condProbs;
+        std::vector<Real> lossesInDef;
+        conditionalExposures(invUncondPs, mktFactor, condProbs, lossesInDef);
+        SaddleObjectiveFunction f(lossLevel, condProbs, lossesInDef);
 
         Size nNames = remainingNotionals_.size();
         std::vector<Real> lgds;
@@ -865,8 +920,7 @@ namespace QuantLib {
         //   inversion:
         static const Real deltaMin = 1.e-5;
         //
-        Probability pMaxName = copula_->conditionalDefaultProbabilityInvP(
-            invUncondPs[iNamMax], iNamMax, mktFactor);
+        Probability pMaxName = condProbs[iNamMax];
         // aproximates the  saddle pt corresponding to this minimum; finds 
         //   it by using only the smallest logistic term and thus this is 
         //   smaller than the true value:
@@ -876,7 +930,7 @@ namespace QuantLib {
         // and the associated minimum loss is approximately: (this is thence 
         //   the minimum loss we can resolve/invert)
         Real minLoss = 
-            CumGen1stDerivativeCond(invUncondPs, saddleMin, mktFactor);
+            CumGen1stDerivativeCond(condProbs, lossesInDef, saddleMin);
 
         // If we are below the loss resolution it returns approximating 
         //  by the minimum/maximum attainable point. Typically the functionals
@@ -887,7 +941,7 @@ namespace QuantLib {
             std::log((lgds[iNamMax]/remainingNotional_
                 -deltaMin)*(1.-pMaxName)/(pMaxName*deltaMin));
         Real maxLoss = 
-            CumGen1stDerivativeCond(invUncondPs, saddleMax, mktFactor);
+            CumGen1stDerivativeCond(condProbs, lossesInDef, saddleMax);
         if(lossLevel > maxLoss) return saddleMax;
 
         Brent solverBrent;
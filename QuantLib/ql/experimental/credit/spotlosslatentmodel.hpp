@@ -67,7 +67,8 @@ namespace QuantLib {
             const std::vector<Real>& recoveries,
             Real modelA,
             LatentModelIntegrationType::LatentModelIntegrationType integralType,
-            const initTraits& ini = initTraits()
+            const initTraits& ini = initTraits(),
+            Size sparseGridLevel = 8
             ); 
 
         void resetBasket(const boost::shared_ptr<Basket> basket) const;
@@ -347,14 +348,16 @@ namespace QuantLib {
         const std::vector<Real>& recoveries,
         Real modelA,
         LatentModelIntegrationType::LatentModelIntegrationType integralType,
-        const typename CP::initTraits& ini
+        const typename CP::initTraits& ini,
+        Size sparseGridLevel
         ) 
     : LatentModel<CP>(factorWeights, ini),
       recoveries_(recoveries), 
       modelA_(modelA),
       numNames_(factorWeights.size()/2),
       integration_(LatentModel<CP>::IntegrationFactory::
-        createLMIntegration(factorWeights[0].size(), integralType))
+        createLMIntegration(factorWeights[0].size(), integralType,
+                            sparseGridLevel))
     {
         QL_REQUIRE(factorWeights.size() % 2 == 0, 
          "Number of RR variables must be equal to number of default variables");
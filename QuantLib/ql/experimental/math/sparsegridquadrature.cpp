@@ -0,0 +1,213 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/sparsegridquadrature.hpp>
+
+#ifndef QL_PATCH_SOLARIS
+
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/mathconstants.hpp>
+#include <cmath>
+#include <map>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::map<std::vector<Real>, Real> SparseGrid;
+
+        Real binomialCoefficient(Size n, Size k) {
+            Real result = 1.0;
+            for (Size j=1; j<=k; ++j)
+                result = result * Real(n-k+j) / Real(j);
+            return result;
+        }
+
+        // adds the tensor product of the given 1D rules, scaled by
+        // the Smolyak coefficient, to the grid
+        void addTensorRule(const std::vector<Array>& x,
+                           const std::vector<Array>& w,
+                           const std::vector<Size>& index,
+                           Real coefficient,
+                           SparseGrid& grid) {
+            const Size dimension = index.size();
+            std::vector<Size> point(dimension, 0);
+            std::vector<Real> node(dimension);
+            for (;;) {
+                Real weight = coefficient;
+                for (Size k=0; k<dimension; ++k) {
+                    node[k] = x[index[k]][point[k]];
+                    weight *= w[index[k]][point[k]];
+                }
+                grid[node] += weight;
+
+                Size k = 0;
+                while (k<dimension && ++point[k] == x[index[k]].size())
+                    point[k++] = 0;
+                if (k == dimension)
+                    break;
+            }
+        }
+
+        // enumerates the multi-indices (zero-based) whose sum is total
+        void addLevel(const std::vector<Array>& x,
+                      const std::vector<Array>& w,
+                      std::vector<Size>& index, Size k, Size total,
+                      Real coefficient, SparseGrid& grid) {
+            if (k == index.size()-1) {
+                if (total < x.size()) {
+                    index[k] = total;
+                    addTensorRule(x, w, index, coefficient, grid);
+                }
+                return;
+            }
+            for (Size i=0; i<=total && i<x.size(); ++i) {
+                index[k] = i;
+                addLevel(x, w, index, k+1, total-i, coefficient, grid);
+            }
+        }
+
+    }
+
+    GaussianQuadSparseGridIntegrator::GaussianQuadSparseGridIntegrator(
+        Size dimension, Size level, Real mu, bool parallel)
+    : dimension_(dimension), level_(level), parallel_(parallel) {
+        QL_REQUIRE(dimension > 0, "null dimension");
+        QL_REQUIRE(level > 0, "null level");
+
+        // 1D rules with 1, 3, 5... points, rescaled to the standard
+        // normal width; nodes closer to the origin than numerical
+        // noise are set to zero so that the central node is shared.
+        std::vector<Array> x(level), w(level);
+        for (Size i=0; i<level; ++i) {
+            GaussHermiteIntegration rule(2*i+1, mu);
+            x[i] = rule.x();
+            w[i] = rule.weights();
+            for (Size j=0; j<x[i].size(); ++j) {
+                x[i][j] *= M_SQRT2;
+                w[i][j] *= M_SQRT2;
+                if (std::fabs(x[i][j]) < 1.0e-12)
+                    x[i][j] = 0.0;
+            }
+        }
+
+        // combination technique; with zero-based indices the sum
+        // runs over level-dimension...level-1, excluding negatives
+        SparseGrid grid;
+        std::vector<Size> index(dimension);
+        for (Size q=0; q<std::min(dimension, level); ++q) {
+            Size total = level - 1 - q;
+            Real coefficient = binomialCoefficient(dimension-1, q);
+            if (q % 2 == 1)
+                coefficient = -coefficient;
+            addLevel(x, w, index, 0, total, coefficient, grid);
+        }
+
+        nodes_.reserve(grid.size()*dimension);
+        weights_.reserve(grid.size());
+        for (SparseGrid::const_iterator i=grid.begin(); i!=grid.end(); ++i) {
+            if (i->second == 0.0)
+                continue;
+            nodes_.insert(nodes_.end(), i->first.begin(), i->first.end());
+            weights_.push_back(i->second);
+        }
+    }
+
+    Real GaussianQuadSparseGridIntegrator::integrate(
+        const boost::function<Real (const std::vector<Real>& arg)>& f) const {
+        const Size n = weights_.size();
+        Real sum = 0.0;
+        if (!parallel_) {
+            std::vector<Real> arg(dimension_);
+            for (Size i=0; i<n; ++i) {
+                std::copy(nodes_.begin()+i*dimension_,
+                          nodes_.begin()+(i+1)*dimension_, arg.begin());
+                sum += weights_[i] * f(arg);
+            }
+            return sum;
+        }
+
+        std::vector<Real> values(n);
+        std::vector<std::string> failures(n);
+        #pragma omp parallel for
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                std::vector<Real> arg(nodes_.begin()+i*dimension_,
+                                      nodes_.begin()+(i+1)*dimension_);
+                values[i] = f(arg);
+            } catch (std::exception& e) {
+                failures[i] = e.what();
+            }
+        }
+        checkFailures(failures);
+        // summed in node order, as in the serial case
+        for (Size i=0; i<n; ++i)
+            sum += weights_[i] * values[i];
+        return sum;
+    }
+
+    Disposable<std::vector<Real> >
+    GaussianQuadSparseGridIntegrator::integrateV(
+        const boost::function<Disposable<std::vector<Real> > (
+            const std::vector<Real>& arg)>& f) const {
+        const Size n = weights_.size();
+        std::vector<Real> sum;
+        if (!parallel_) {
+            std::vector<Real> arg(dimension_), term;
+            for (Size i=0; i<n; ++i) {
+                std::copy(nodes_.begin()+i*dimension_,
+                          nodes_.begin()+(i+1)*dimension_, arg.begin());
+                term = f(arg);
+                if (i == 0)
+                    sum.resize(term.size(), 0.0);
+                for (Size j=0; j<term.size(); ++j)
+                    sum[j] += weights_[i] * term[j];
+            }
+            return sum;
+        }
+
+        std::vector<std::vector<Real> > values(n);
+        std::vector<std::string> failures(n);
+        #pragma omp parallel for
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                std::vector<Real> arg(nodes_.begin()+i*dimension_,
+                                      nodes_.begin()+(i+1)*dimension_);
+                values[i] = f(arg);
+            } catch (std::exception& e) {
+                failures[i] = e.what();
+            }
+        }
+        checkFailures(failures);
+        sum.resize(values[0].size(), 0.0);
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<sum.size(); ++j)
+                sum[j] += weights_[i] * values[i][j];
+        return sum;
+    }
+
+    void GaussianQuadSparseGridIntegrator::checkFailures(
+                           const std::vector<std::string>& failures) const {
+        for (Size i=0; i<failures.size(); ++i)
+            QL_REQUIRE(failures[i].empty(),
+                       "integrand failed at node #" << i << ": "
+                       << failures[i]);
+    }
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sparsegridquadrature.hpp
+    \brief Smolyak sparse-grid Gauss-Hermite integration
+*/
+
+#ifndef quantlib_math_sparsegridquadrature_hpp
+#define quantlib_math_sparsegridquadrature_hpp
+
+#include <ql/qldefines.hpp>
+
+#ifndef QL_PATCH_SOLARIS
+
+#include <ql/types.hpp>
+#include <ql/utilities/disposable.hpp>
+#include <ql/errors.hpp>
+#include <boost/function.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    /*! \brief Integrates a vector or scalar function of vector domain on a
+        Smolyak sparse grid.
+
+        The grid is built with the combination technique out of 1D
+        Gauss-Hermite rules with \f$ 2i-1 \f$ points, \f$ i = 1 \dots
+        level \f$; in one dimension it reduces to the Gauss-Hermite rule
+        with \f$ 2 \, level - 1 \f$ points, while in \f$ d \f$ dimensions
+        it needs far fewer nodes than the tensor-product rule of
+        GaussianQuadMultidimIntegrator of the same 1D order. As with
+        the latter, the quadrature weights include the inverse of the
+        Hermite weight function so that the integral is taken over
+        \f$ R^{dim} \f$ of the function itself. The Hermite nodes are
+        scaled by \f$ \sqrt{2} \f$, so that the rules are exact for
+        polynomials times the standard normal density, which is the
+        shape of latent model integrands.
+
+        Nodes and weights are computed once at construction; each
+        integration is then a flat loop over the nodes. When
+        \c parallel is set the integrand is evaluated at the nodes
+        concurrently (if OpenMP is enabled) and the results are summed
+        afterwards in node order, so that the result does not depend
+        on the number of threads.
+
+        \warning In parallel mode the integrand is called concurrently
+                 and must therefore be safe to call from several
+                 threads, i.e. it must not write to shared buffers.
+    */
+    class GaussianQuadSparseGridIntegrator {
+      public:
+        /*!
+            @param dimension The number of dimensions of the argument of the
+            function we want to integrate.
+            @param level Smolyak level; the finest 1D rule has
+            2*level-1 points.
+            @param mu Parameter in the Gauss Hermite weight (i.e. points load).
+            @param parallel Whether to evaluate the integrand concurrently.
+        */
+        GaussianQuadSparseGridIntegrator(Size dimension,
+                                         Size level,
+                                         Real mu = 0.0,
+                                         bool parallel = false);
+
+        Size dimension() const { return dimension_; }
+        Size level() const { return level_; }
+        //! number of distinct nodes of the sparse grid
+        Size nodes() const { return weights_.size(); }
+        bool parallel() const { return parallel_; }
+
+        //! Integrates function f over \f$ R^{dim} \f$
+        Real integrate(const boost::function<Real (
+                           const std::vector<Real>& arg)>& f) const;
+        //! Integrates vector function f over \f$ R^{dim} \f$
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> > (
+                const std::vector<Real>& arg)>& f) const;
+
+      private:
+        void checkFailures(const std::vector<std::string>& failures) const;
+        Size dimension_, level_;
+        bool parallel_;
+        // node coordinates, stored contiguously node after node
+        std::vector<Real> nodes_;
+        std::vector<Real> weights_;
+    };
+
+}
+
+#endif
+
+#endif
@@ -43,6 +43,7 @@
 #include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
 #include <ql/experimental/finitedifferences/localvolrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/squarerootprocessrndcalculator.hpp>
+#include <ql/utilities/stopwatch.hpp>
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -301,6 +302,12 @@ namespace QuantLib {
         return leverageFunction_;
     }
 
+    const std::vector<Real>& HestonSLVFDMModel::sliceTimings() const {
+        calculate();
+
+        return sliceTimings_;
+    }
+
     void HestonSLVFDMModel::performCalculations() const {
         logEntries_.clear();
 
@@ -455,7 +462,10 @@ namespace QuantLib {
             logEntries_.push_back(entry);
         }
 
+        sliceTimings_.assign(timeGrid->size()-1, 0.0);
+
         for (Size i=2; i < times.size(); ++i) {
+            const StopWatch watch;
             const Time t = timeGrid->at(i);
             const Time dt = t - timeGrid->at(i-1);
 
@@ -482,6 +492,9 @@ namespace QuantLib {
                     mesher->getFdm1dMeshers()[1]->locations().begin(),
                     mesher->getFdm1dMeshers()[1]->locations().end());
 
+            Array localVols(x.size());
+            localVol_->localVols(t, x, localVols);
+
             // predictor corrector steps
             for (Size r=0; r < params_.predictionCorretionSteps; ++r) {
                 const FdmSchemeDesc fdmSchemeDesc
@@ -492,7 +505,10 @@ namespace QuantLib {
                 const boost::shared_ptr<FdmScheme> fdmScheme(
                     fdmSchemeFactory(fdmSchemeDesc, hestonFwdOp));
 
-                for (Size j=0; j < x.size(); ++j) {
+                // the leverage at each spot level only depends on its
+                // own variance slice
+                #pragma omp parallel for
+                for (long j=0; j < long(x.size()); ++j) {
                     Array pSlice(vGrid);
                     for (Size k=0; k < vGrid; ++k)
                         pSlice[k] = pn[j + k*xGrid];
@@ -508,15 +524,14 @@ namespace QuantLib {
                       : DiscreteSimpsonIntegral()(v, v*pSlice);
 
                     const Real scale = pInt/vpInt;
-                    const Volatility localVol = localVol_->localVol(t, x[j]);
+                    const Volatility localVol = localVols[j];
 
                     const Real l = (scale >= 0.0)
                       ? localVol*std::sqrt(scale) : 1.0;
 
                     (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
                 }
+                leverageFct->setInterpolation(Linear());
 
                 const Real sLowerBound = std::max(x.front(),
                     std::exp(localVolRND.invcdf(
@@ -555,6 +570,8 @@ namespace QuantLib {
                     = { t, boost::shared_ptr<Array>(new Array(p)), mesher };
                 logEntries_.push_back(entry);
             }
+
+            sliceTimings_[i-1] = watch.elapsed();
         }
 
         leverageFunction_ = leverageFct;
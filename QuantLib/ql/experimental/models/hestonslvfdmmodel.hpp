@@ -83,6 +83,10 @@ class SimpleQuote;
         boost::shared_ptr<HestonProcess> hestonProcess() const;
         boost::shared_ptr<LocalVolTermStructure> localVol() const;
         boost::shared_ptr<LocalVolTermStructure> leverageFunction() const;
+        /*! seconds spent on each time step of the forward solve; the
+            first step uses the Green's function and is not timed.
+        */
+        const std::vector<Real>& sliceTimings() const;
 
         struct LogEntry {
             const Time t;
@@ -105,6 +109,7 @@ class SimpleQuote;
 
         const bool logging_;
         mutable std::list<LogEntry> logEntries_;
+        mutable std::vector<Real> sliceTimings_;
     };
 }
 
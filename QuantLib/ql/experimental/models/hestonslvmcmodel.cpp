@@ -25,6 +25,7 @@
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/experimental/models/hestonslvmcmodel.hpp>
 #include <ql/experimental/processes/hestonslvprocess.hpp>
+#include <ql/utilities/stopwatch.hpp>
 
 #include <boost/make_shared.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
@@ -37,6 +38,7 @@
 #endif
 
 namespace QuantLib {
+
     HestonSLVMCModel::HestonSLVMCModel(
         const Handle<LocalVolTermStructure>& localVol,
         const Handle<HestonModel>& hestonModel,
@@ -86,6 +88,12 @@ namespace QuantLib {
         return leverageFunction_;
     }
 
+    const std::vector<Real>& HestonSLVMCModel::sliceTimings() const {
+        calculate();
+
+        return sliceTimings_;
+    }
+
     void HestonSLVMCModel::performCalculations() const {
         const boost::shared_ptr<HestonProcess> hestonProcess
             = hestonModel_->process();
@@ -151,31 +159,41 @@ namespace QuantLib {
             }
         }
 
+        Array spots(calibrationPaths_), variances(calibrationPaths_);
+        Array dwSpot(calibrationPaths_), dwVariance(calibrationPaths_);
+        Array binStrikes(nBins_), binVariances(nBins_), binVols(nBins_);
+
+        sliceTimings_.resize(timeSteps);
+
         for (Size n=1; n < timeGrid_->size(); ++n) {
+            const StopWatch watch;
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
-            Array x0(2), dw(2);
-
+            // all particles are evolved together
             for (Size i=0; i < calibrationPaths_; ++i) {
-                x0[0] = pairs[i].first;
-                x0[1] = pairs[i].second;
+                spots[i] = pairs[i].first;
+                variances[i] = pairs[i].second;
 
-                dw[0] = paths[i][n-1][0];
-                dw[1] = paths[i][n-1][1];
+                dwSpot[i] = paths[i][n-1][0];
+                dwVariance[i] = paths[i][n-1][1];
+            }
 
-                x0 = slvProcess->evolve(t, x0, dt, dw);
+            slvProcess->evolve(t, dt, spots, variances, dwSpot, dwVariance);
 
-                pairs[i].first = x0[0];
-                pairs[i].second = x0[1];
+            for (Size i=0; i < calibrationPaths_; ++i) {
+                pairs[i].first = spots[i];
+                pairs[i].second = variances[i];
             }
 
             std::sort(pairs.begin(), pairs.end());
 
-            Size s = 0u, e = 0u;
-            for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + (i < m);
-                e = s + inc;
+            // the bins are contiguous ranges of the sorted particles
+            #pragma omp parallel for
+            for (long i=0; i < long(nBins_); ++i) {
+                const Size inc = k + (Size(i) < m);
+                const Size s = i*k + std::min(Size(i), m);
+                const Size e = s + inc;
 
                 Real sum=0.0;
                 for (Size j=s; j < e; ++j) {
@@ -184,13 +202,18 @@ namespace QuantLib {
                 sum/=inc;
 
                 vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(square<Real>()(
-                     localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
+                binStrikes[i] = vStrikes[n]->at(i);
+                binVariances[i] = sum;
             }
 
+            localVol_->localVols(t, binStrikes, binVols, true);
+            for (Size i=0; i < nBins_; ++i)
+                (*L)[i][n] = std::sqrt(square<Real>()(binVols[i])
+                                       /binVariances[i]);
+
             leverageFunction_->setInterpolation<Linear>();
+
+            sliceTimings_[n-1] = watch.elapsed();
         }
     }
 }
@@ -55,6 +55,8 @@ namespace QuantLib {
         boost::shared_ptr<HestonProcess> hestonProcess() const;
         boost::shared_ptr<LocalVolTermStructure> localVol() const;
         boost::shared_ptr<LocalVolTermStructure> leverageFunction() const;
+        //! seconds spent on each time step of the calibration
+        const std::vector<Real>& sliceTimings() const;
 
       protected:
         void performCalculations() const;
@@ -68,6 +70,7 @@ namespace QuantLib {
         boost::shared_ptr<TimeGrid> timeGrid_;
 
         mutable boost::shared_ptr<FixedLocalVolSurface> leverageFunction_;
+        mutable std::vector<Real> sliceTimings_;
     };
 }
 
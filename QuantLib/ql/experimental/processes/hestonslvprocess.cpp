@@ -79,14 +79,11 @@ namespace QuantLib {
         return tmp;
     }
 
-    Disposable<Array> HestonSLVProcess::evolve(
-        Time t0, const Array& x0, Time dt, const Array& dw) const {
-        Array retVal(2);
-
+    Real HestonSLVProcess::evolveVariance(Real v0, Time dt, Real dw) const {
         const Real ex = std::exp(-kappa_*dt);
 
-        const Real m  =  theta_+(x0[1]-theta_)*ex;
-        const Real s2 =  x0[1]*sigma_*sigma_*ex/kappa_*(1-ex)
+        const Real m  =  theta_+(v0-theta_)*ex;
+        const Real s2 =  v0*sigma_*sigma_*ex/kappa_*(1-ex)
                        + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
         const Real psi = s2/(m*m);
 
@@ -95,30 +92,64 @@ namespace QuantLib {
             const Real b  = std::sqrt(b2);
             const Real a  = m/(1+b2);
 
-            retVal[1] = a*(b+dw[1])*(b+dw[1]);
+            return a*(b+dw)*(b+dw);
         }
         else {
             const Real p = (psi-1)/(psi+1);
             const Real beta = (1-p)/m;
-            const Real u = CumulativeNormalDistribution()(dw[1]);
+            const Real u = CumulativeNormalDistribution()(dw);
 
-            retVal[1] = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
+            return ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
         }
+    }
+
+    Real HestonSLVProcess::evolveSpot(Real s0, Real v0, Real v1, Rate mu,
+                                      Volatility l_0, Time dt,
+                                      Real dw) const {
+        const Real rho1 = std::sqrt(1-rho_*rho_);
+
+        const Real v_0 = 0.5*(v0+v1)*l_0*l_0;
+
+        return s0*std::exp(mu*dt - 0.5*v_0*dt
+            + rho_/sigma_*l_0 * (
+                  v1 - kappa_*theta_*dt
+                  + 0.5*(v0+v1)*kappa_*dt - v0)
+            + rho1*std::sqrt(v_0*dt)*dw);
+    }
+
+    Disposable<Array> HestonSLVProcess::evolve(
+        Time t0, const Array& x0, Time dt, const Array& dw) const {
+        Array retVal(2);
+
+        retVal[1] = evolveVariance(x0[1], dt, dw[1]);
 
         const Real mu = riskFreeRate()->forwardRate(t0, t0+dt, Continuous)
              - dividendYield()->forwardRate(t0, t0+dt, Continuous);
 
-        const Real rho1 = std::sqrt(1-rho_*rho_);
-
         const Volatility l_0 = leverageFct_->localVol(t0, x0[0], true);
-        const Real v_0 = 0.5*(x0[1]+retVal[1])*l_0*l_0;
 
-        retVal[0] = x0[0]*std::exp(mu*dt - 0.5*v_0*dt
-            + rho_/sigma_*l_0 * (
-                  retVal[1] - kappa_*theta_*dt
-                  + 0.5*(x0[1]+retVal[1])*kappa_*dt - x0[1])
-            + rho1*std::sqrt(v_0*dt)*dw[0]);
+        retVal[0] = evolveSpot(x0[0], x0[1], retVal[1], mu, l_0, dt, dw[0]);
 
         return retVal;
     }
+
+    void HestonSLVProcess::evolve(Time t0, Time dt,
+                                  Array& spots, Array& variances,
+                                  const Array& dwSpot,
+                                  const Array& dwVariance) const {
+        const Real mu = riskFreeRate()->forwardRate(t0, t0+dt, Continuous)
+             - dividendYield()->forwardRate(t0, t0+dt, Continuous);
+
+        Array l(spots.size());
+        leverageFct_->localVols(t0, spots, l, true);
+
+        // the particles only interact through the leverage function
+        #pragma omp parallel for
+        for (long i=0; i < long(spots.size()); ++i) {
+            const Real v1 = evolveVariance(variances[i], dt, dwVariance[i]);
+            spots[i] = evolveSpot(spots[i], variances[i], v1, mu, l[i],
+                                  dt, dwSpot[i]);
+            variances[i] = v1;
+        }
+    }
 }
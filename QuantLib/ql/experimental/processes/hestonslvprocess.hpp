@@ -52,6 +52,14 @@ namespace QuantLib {
         Disposable<Matrix> diffusion(Time t, const Array& x) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! evolves several paths over the same step, updating their
+            spots and variances in place; the rates and the leverage
+            function are queried once for all paths, which are then
+            evolved concurrently if OpenMP is enabled.
+        */
+        void evolve(Time t0, Time dt,
+                    Array& spots, Array& variances,
+                    const Array& dwSpot, const Array& dwVariance) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -73,6 +81,10 @@ namespace QuantLib {
         Time time(const Date& d) const { return hestonProcess_->time(d); }
 
       private:
+        Real evolveVariance(Real v0, Time dt, Real dw) const;
+        Real evolveSpot(Real s0, Real v0, Real v1, Rate mu,
+                        Volatility leverage, Time dt, Real dw) const;
+
         Real kappa_, theta_, sigma_, rho_, v0_;
 
         const boost::shared_ptr<HestonProcess> hestonProcess_;
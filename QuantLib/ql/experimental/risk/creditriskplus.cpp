@@ -18,6 +18,8 @@
 */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
 #include <map>
 
 using std::sqrt;
@@ -29,10 +31,10 @@ namespace QuantLib {
         const std::vector<Real> &defaultProbability,
         const std::vector<Size> &sector,
         const std::vector<Real> &relativeDefaultVariance,
-        const Matrix &correlation, const Real unit)
+        const Matrix &correlation, const Real unit, Algorithm algorithm)
         : exposure_(exposure), pd_(defaultProbability), sector_(sector),
           relativeDefaultVariance_(relativeDefaultVariance),
-          correlation_(correlation), unit_(unit) {
+          correlation_(correlation), unit_(unit), algorithm_(algorithm) {
 
         m_ = exposure_.size();
 
@@ -212,6 +214,16 @@ namespace QuantLib {
 
         // compute loss distribution
 
+        if (algorithm_ == FourierInversion) {
+            // expected number of defaults per exposure band
+            std::vector<Real> bandDefaults(maxNu_ + 1, 0.0);
+            for (iter = epsNuC_.begin(); iter != epsNuC_.end(); ++iter)
+                bandDefaults[(*iter).first] =
+                    (*iter).second / ((Real)(*iter).first);
+            fourierInversion(bandDefaults, alphaC_, pC_);
+            return;
+        }
+
         loss_.clear();
         loss_.push_back(std::pow(1.0 - pC_, alphaC_)); // A(0)
 
@@ -232,4 +244,55 @@ namespace QuantLib {
             loss_.push_back(res * pC_ / (pdSum_ * ((Real)(n + 1))));
         }
     }
+
+    /* The probability generating function of the loss in units is
+       G(z) = ((1-p) / (1-p Q(z)))^alpha with Q(z) the generating function
+       of the exposure band of a default, Q(z) = sum_nu mu_nu z^nu / mu.
+       Q is evaluated on the damped unit circle with a forward FFT, G
+       pointwise and the loss probabilities are recovered with an inverse
+       FFT. Since |p Q| < 1 the principal branch of the power is the
+       right one. */
+    void CreditRiskPlus::fourierInversion(
+        const std::vector<Real> &bandDefaults, Real alpha, Real p) {
+
+        // grid four times larger than the computed range, damped by
+        // theta^k, so that the mass beyond the grid folding back is
+        // reduced by a factor 1e-20 while the round-off amplification on
+        // the computed range stays below 1e5
+        Size order = FastFourierTransform::min_order(upperIndex_) + 2;
+        FastFourierTransform fft(order);
+        const Size N = fft.output_size();
+        const Real theta = std::pow(1.0e-20, 1.0 / N);
+
+        Real mu = 0.0;
+        for (Size nu = 0; nu < bandDefaults.size(); ++nu)
+            mu += bandDefaults[nu];
+
+        std::vector<std::complex<Real> > q(bandDefaults.size());
+        Real damping = 1.0;
+        for (Size nu = 0; nu < bandDefaults.size(); ++nu) {
+            q[nu] = bandDefaults[nu] / mu * damping;
+            damping *= theta;
+        }
+        std::vector<std::complex<Real> > g(N);
+        fft.transform(q.begin(), q.end(), g.begin());
+        // q is real, so that the upper half of the frequencies are the
+        // conjugates of the lower one
+        for (Size j = 0; j <= N / 2; ++j) {
+            g[j] = std::pow((1.0 - p) / (1.0 - p * g[j]), alpha);
+            if (j > 0 && j < N / 2)
+                g[N - j] = std::conj(g[j]);
+        }
+
+        std::vector<std::complex<Real> > a(N);
+        fft.inverse_transform(g.begin(), g.end(), a.begin());
+
+        loss_.resize(upperIndex_);
+        damping = 1.0;
+        for (unsigned long n = 0; n < upperIndex_; ++n) {
+            // remove round-off negatives
+            loss_[n] = std::max(a[n].real() / N / damping, 0.0);
+            damping *= theta;
+        }
+    }
 }
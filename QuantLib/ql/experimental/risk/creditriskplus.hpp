@@ -34,6 +34,16 @@ namespace QuantLib {
     /*! Extended CreditRisk+ model as described in [1] Integrating Correlations, Risk,
       July 1999 and the references therein.
 
+      The loss distribution is computed either by the Panjer recursion
+      of [1], whose cost grows with the number of loss units times the
+      number of exposure bands, or by inverting its probability
+      generating function with an FFT, whose cost grows only with the
+      number of loss units (up to a logarithm). The latter is
+      exponentially damped to suppress the aliasing of the losses beyond
+      the computed range, see [2] Paul Embrechts and Marco Frei, Panjer
+      recursion versus FFT for compound distributions, Mathematical
+      Methods of Operations Research 69, 3, 2009.
+
       \warning the input correlation matrix is not checked for positive
       definiteness
 
@@ -43,11 +53,14 @@ namespace QuantLib {
 
       public:
 
+        enum Algorithm { PanjerRecursion, FourierInversion };
+
         CreditRiskPlus(const std::vector<Real> &exposure,
                        const std::vector<Real> &defaultProbability,
                        const std::vector<Size> &sector,
                        const std::vector<Real> &relativeDefaultVariance,
-                       const Matrix &correlation, const Real unit);
+                       const Matrix &correlation, const Real unit,
+                       Algorithm algorithm = PanjerRecursion);
 
         const std::vector<Real> &loss() { return loss_; }
         const std::vector<Real> &marginalLoss() { return marginalLoss_; }
@@ -80,6 +93,7 @@ namespace QuantLib {
         const std::vector<Real> relativeDefaultVariance_;
         const Matrix correlation_;
         const Real unit_;
+        const Algorithm algorithm_;
 
         Size n_, m_; // number of sectors, exposures
 
@@ -90,6 +104,8 @@ namespace QuantLib {
         unsigned long upperIndex_;
 
         void compute();
+        void fourierInversion(
+            const std::vector<Real> &bandDefaults, Real alpha, Real p);
     };
 }
 
@@ -0,0 +1,317 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/exposuresimulation.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/inversecumulativerng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <algorithm>
+#include <set>
+
+namespace QuantLib {
+
+    namespace {
+
+        // coefficients of log P(t,T) = a + b x, with x the model state
+        void zeroBondCoefficients(const Gsr& model,
+                                  const StochasticProcess1D& process,
+                                  Time T, Time t, Real& a, Real& b) {
+            if (t == 0.0) {
+                a = std::log(model.zerobond(T));
+                b = 0.0;
+                return;
+            }
+            Real m = process.expectation(0.0, 0.0, t);
+            Real s = process.stdDeviation(0.0, 0.0, t);
+            a = std::log(model.zerobond(T, t, -m/s));
+            b = std::log(model.zerobond(T, t, (1.0-m)/s)) - a;
+        }
+
+    }
+
+    ExposureSimulation::ExposureSimulation(
+        const boost::shared_ptr<Gsr>& model,
+        const std::vector<boost::shared_ptr<VanillaSwap> >& swaps,
+        const std::vector<boost::shared_ptr<FixedRateBond> >& bonds,
+        const std::vector<Date>& exposureDates,
+        Size paths, BigNatural seed, Real pfeQuantile,
+        bool antitheticVariate)
+    : model_(model), swaps_(swaps), bonds_(bonds),
+      exposureDates_(exposureDates), paths_(paths), seed_(seed),
+      pfeQuantile_(pfeQuantile), antitheticVariate_(antitheticVariate) {
+        QL_REQUIRE(!exposureDates_.empty(), "no exposure dates given");
+        for (Size i=1; i<exposureDates_.size(); ++i)
+            QL_REQUIRE(exposureDates_[i] > exposureDates_[i-1],
+                       "exposure dates must be sorted and unique");
+        QL_REQUIRE(paths_ > 0, "null number of paths");
+        QL_REQUIRE(!antitheticVariate_ || paths_ % 2 == 0,
+                   "odd number of paths (" << paths_
+                   << ") with antithetic variate");
+        QL_REQUIRE(pfeQuantile_ > 0.0 && pfeQuantile_ < 1.0,
+                   "pfe quantile (" << pfeQuantile_
+                   << ") must be in (0,1)");
+        registerWith(model_);
+        for (Size i=0; i<swaps_.size(); ++i) {
+            registerWith(swaps_[i]);
+            registerWithLeg(swaps_[i]->fixedLeg());
+            registerWithLeg(swaps_[i]->floatingLeg());
+        }
+        for (Size i=0; i<bonds_.size(); ++i) {
+            registerWith(bonds_[i]);
+            registerWithLeg(bonds_[i]->cashflows());
+        }
+    }
+
+    void ExposureSimulation::registerWithLeg(const Leg& leg) {
+        // instruments forward notifications only once calculated, so
+        // the flows, their indexes and curves are observed directly
+        for (Size i=0; i<leg.size(); ++i) {
+            registerWith(leg[i]);
+            boost::shared_ptr<IborCoupon> ibor =
+                boost::dynamic_pointer_cast<IborCoupon>(leg[i]);
+            if (ibor) {
+                registerWith(ibor->iborIndex());
+                registerWith(ibor->iborIndex()->forwardingTermStructure());
+            }
+        }
+    }
+
+    const std::vector<Real>& ExposureSimulation::expectedExposure() const {
+        calculate();
+        return ee_;
+    }
+
+    const std::vector<Real>&
+    ExposureSimulation::potentialFutureExposure() const {
+        calculate();
+        return pfe_;
+    }
+
+    const std::vector<Real>&
+    ExposureSimulation::discountedExpectedExposure() const {
+        calculate();
+        return dee_;
+    }
+
+    const std::vector<Real>&
+    ExposureSimulation::discountedExpectedNegativeExposure() const {
+        calculate();
+        return dene_;
+    }
+
+    Real ExposureSimulation::cva(
+                    const Handle<DefaultProbabilityTermStructure>& ctpty,
+                    Real recoveryRate) const {
+        return adjustment(discountedExpectedExposure(), ctpty, recoveryRate);
+    }
+
+    Real ExposureSimulation::dva(
+                    const Handle<DefaultProbabilityTermStructure>& investor,
+                    Real recoveryRate) const {
+        return adjustment(discountedExpectedNegativeExposure(), investor,
+                          recoveryRate);
+    }
+
+    Real ExposureSimulation::adjustment(
+                    const std::vector<Real>& exposure,
+                    const Handle<DefaultProbabilityTermStructure>& dts,
+                    Real recoveryRate) const {
+        QL_REQUIRE(!dts.empty(), "no default curve given");
+        Real sum = 0.0;
+        Probability previous =
+            dts->survivalProbability(model_->termStructure()->referenceDate());
+        for (Size i=0; i<exposureDates_.size(); ++i) {
+            Probability p = dts->survivalProbability(exposureDates_[i]);
+            sum += exposure[i] * (previous - p);
+            previous = p;
+        }
+        return (1.0 - recoveryRate) * sum;
+    }
+
+    void ExposureSimulation::addLeg(const Leg& leg, Real sign,
+                                    const Date& referenceDate) const {
+        const boost::shared_ptr<YieldTermStructure>& ts =
+            *model_->termStructure();
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->date() <= referenceDate)
+                continue;
+            Flow f;
+            f.paymentDate = leg[i]->date();
+            f.payment = ts->timeFromReference(f.paymentDate);
+            boost::shared_ptr<FloatingRateCoupon> floating =
+                boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            if (!floating || floating->fixingDate() <= referenceDate) {
+                // fixed amount, or floating coupon already fixed
+                f.amount = sign * leg[i]->amount();
+                flows_.push_back(f);
+                continue;
+            }
+            boost::shared_ptr<IborCoupon> ibor =
+                boost::dynamic_pointer_cast<IborCoupon>(floating);
+            QL_REQUIRE(ibor, "only fixed and Ibor coupons are supported");
+            const boost::shared_ptr<IborIndex>& index = ibor->iborIndex();
+            f.fixingDate = ibor->fixingDate();
+            Date start = index->valueDate(f.fixingDate);
+            Date end = index->maturityDate(start);
+            f.start = ts->timeFromReference(start);
+            f.end = ts->timeFromReference(end);
+            f.indexAccrual = index->dayCounter().yearFraction(start, end);
+            f.amount = Null<Real>();
+            f.factor = sign * ibor->nominal() * ibor->accrualPeriod();
+            f.gearing = ibor->gearing();
+            f.spread = ibor->spread();
+            flows_.push_back(f);
+        }
+    }
+
+    void ExposureSimulation::performCalculations() const {
+
+        const Handle<YieldTermStructure>& ts = model_->termStructure();
+        const Date referenceDate = ts->referenceDate();
+        QL_REQUIRE(exposureDates_.front() > referenceDate,
+                   "first exposure date (" << exposureDates_.front()
+                   << ") must be after the reference date ("
+                   << referenceDate << ")");
+
+        flows_.clear();
+        for (Size i=0; i<swaps_.size(); ++i) {
+            Real sign = swaps_[i]->type() == VanillaSwap::Payer ? -1.0 : 1.0;
+            addLeg(swaps_[i]->fixedLeg(), sign, referenceDate);
+            addLeg(swaps_[i]->floatingLeg(), -sign, referenceDate);
+        }
+        for (Size i=0; i<bonds_.size(); ++i)
+            addLeg(bonds_[i]->cashflows(), 1.0, referenceDate);
+
+        // simulation grid: exposure dates plus the fixing dates needed
+        std::set<Date> grid(exposureDates_.begin(), exposureDates_.end());
+        for (Size i=0; i<flows_.size(); ++i) {
+            if (flows_[i].amount == Null<Real>() &&
+                flows_[i].fixingDate <= exposureDates_.back())
+                grid.insert(flows_[i].fixingDate);
+        }
+
+        const boost::shared_ptr<StochasticProcess1D> process =
+            model_->stateProcess();
+        const Time numeraireTime = model_->numeraireTime();
+        const Real numeraire0 = model_->numeraire(0.0);
+
+        const Size n = paths_;
+        const Size independent = antitheticVariate_ ? n/2 : n;
+        std::vector<Real> x(n, process->x0()), value(n), positive(n);
+        std::vector<std::vector<Real> > fixings(flows_.size());
+        InverseCumulativeRng<MersenneTwisterUniformRng,
+                             InverseCumulativeNormal>
+            rng((MersenneTwisterUniformRng(seed_)));
+
+        const Size m = exposureDates_.size();
+        ee_.resize(m);
+        pfe_.resize(m);
+        dee_.resize(m);
+        dene_.resize(m);
+
+        Time t0 = 0.0;
+        Size e = 0;
+        for (std::set<Date>::const_iterator d = grid.begin();
+             d != grid.end(); ++d) {
+
+            // exact Gaussian transition, whose mean is affine in x
+            const Time t = ts->timeFromReference(*d);
+            const Real m0 = process->expectation(t0, 0.0, t-t0);
+            const Real m1 = process->expectation(t0, 1.0, t-t0) - m0;
+            const Real sd = process->stdDeviation(t0, 0.0, t-t0);
+            for (Size j=0; j<independent; ++j) {
+                Real z = rng.next().value;
+                x[j] = m0 + m1*x[j] + sd*z;
+                if (antitheticVariate_)
+                    x[j+independent] = m0 + m1*x[j+independent] - sd*z;
+            }
+            t0 = t;
+
+            Real as, bs, ae, be, ap, bp;
+            for (Size i=0; i<flows_.size(); ++i) {
+                const Flow& f = flows_[i];
+                if (f.amount != Null<Real>() || f.fixingDate != *d)
+                    continue;
+                zeroBondCoefficients(*model_, *process, f.start, t, as, bs);
+                zeroBondCoefficients(*model_, *process, f.end, t, ae, be);
+                fixings[i].resize(n);
+                for (Size j=0; j<n; ++j)
+                    fixings[i][j] =
+                        (std::exp(as-ae + (bs-be)*x[j]) - 1.0)
+                        / f.indexAccrual;
+            }
+
+            if (*d != exposureDates_[e])
+                continue;
+
+            std::fill(value.begin(), value.end(), 0.0);
+            for (Size i=0; i<flows_.size(); ++i) {
+                const Flow& f = flows_[i];
+                if (f.paymentDate <= *d) {
+                    // paid; its fixings are no longer needed
+                    std::vector<Real>().swap(fixings[i]);
+                    continue;
+                }
+                zeroBondCoefficients(*model_, *process, f.payment, t, ap, bp);
+                if (f.amount != Null<Real>()) {
+                    for (Size j=0; j<n; ++j)
+                        value[j] += f.amount * std::exp(ap + bp*x[j]);
+                } else if (f.fixingDate <= *d) {
+                    const std::vector<Real>& l = fixings[i];
+                    for (Size j=0; j<n; ++j)
+                        value[j] += f.factor * (f.gearing*l[j] + f.spread)
+                                  * std::exp(ap + bp*x[j]);
+                } else {
+                    zeroBondCoefficients(*model_, *process, f.start, t,
+                                         as, bs);
+                    zeroBondCoefficients(*model_, *process, f.end, t, ae, be);
+                    for (Size j=0; j<n; ++j) {
+                        Real l = (std::exp(as-ae + (bs-be)*x[j]) - 1.0)
+                                 / f.indexAccrual;
+                        value[j] += f.factor * (f.gearing*l + f.spread)
+                                  * std::exp(ap + bp*x[j]);
+                    }
+                }
+            }
+
+            Real an, bn;
+            zeroBondCoefficients(*model_, *process, numeraireTime, t, an, bn);
+            Real sum = 0.0, discountedPositive = 0.0,
+                 discountedNegative = 0.0;
+            for (Size j=0; j<n; ++j) {
+                Real deflated = value[j] * std::exp(-an - bn*x[j]);
+                positive[j] = std::max(value[j], 0.0);
+                sum += positive[j];
+                if (value[j] > 0.0)
+                    discountedPositive += deflated;
+                else
+                    discountedNegative -= deflated;
+            }
+            ee_[e] = sum / n;
+            dee_[e] = numeraire0 * discountedPositive / n;
+            dene_[e] = numeraire0 * discountedNegative / n;
+            Size k = std::min<Size>(n-1, Size(pfeQuantile_*n));
+            std::nth_element(positive.begin(), positive.begin()+k,
+                             positive.end());
+            pfe_[e] = positive[k];
+
+            ++e;
+        }
+    }
+
+}
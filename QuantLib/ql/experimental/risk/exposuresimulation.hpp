@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file exposuresimulation.hpp
+    \brief Monte Carlo exposure profile of a netting set
+*/
+
+#ifndef quantlib_exposure_simulation_hpp
+#define quantlib_exposure_simulation_hpp
+
+#include <ql/models/shortrate/onefactormodels/gsr.hpp>
+#include <ql/instruments/vanillaswap.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/termstructures/defaulttermstructure.hpp>
+#include <ql/patterns/lazyobject.hpp>
+
+namespace QuantLib {
+
+    /*! Exposure profile of a netting set of vanilla swaps and fixed
+        rate bonds, simulated in a Gsr model (i.e. a Hull-White model
+        with piecewise constant volatility; constant parameters give
+        the classic Hull-White dynamics).
+
+        All paths are evolved together on a time grid made of the
+        exposure dates and of the fixing dates of the floating coupons
+        falling before the last exposure date. The model state is
+        sampled exactly from the Gaussian transition of the process.
+        At each exposure date the netting set is revalued with the
+        closed-form zero bonds of the model: since their logarithm is
+        affine in the state, each discount factor costs one exponential
+        per path once its two coefficients are known, and these are
+        computed once per date and shared by all paths. Floating
+        coupons are fixed on each path at their fixing date and are
+        projected on the model curve before (the forwarding curve of
+        the index and convexity adjustments for in-arrears fixings
+        are ignored).
+
+        The simulation only keeps the current state of each path and
+        the fixings of the coupons alive at the current date, so that
+        memory does not grow with the number of dates; the exposure
+        statistics are accumulated date by date.
+
+        Discounted exposures are expectations of the deflated values
+        times the numeraire at the reference date, i.e. they are
+        values at the reference date.
+
+        \warning flows other than fixed amounts and Ibor coupons are
+                 not supported.
+    */
+    class ExposureSimulation : public LazyObject {
+      public:
+        /*! @param model The model used for the simulation; its term
+                   structure provides the reference date.
+            @param swaps The swaps of the netting set.
+            @param bonds The fixed rate bonds of the netting set, held
+                   long.
+            @param exposureDates The dates, after the reference date,
+                   at which the exposure is computed.
+            @param paths The number of Monte Carlo paths.
+            @param seed The seed of the random number generator.
+            @param pfeQuantile The quantile defining the potential
+                   future exposure.
+            @param antitheticVariate Whether the second half of the
+                   paths should mirror the first.
+        */
+        ExposureSimulation(
+            const boost::shared_ptr<Gsr>& model,
+            const std::vector<boost::shared_ptr<VanillaSwap> >& swaps,
+            const std::vector<boost::shared_ptr<FixedRateBond> >& bonds,
+            const std::vector<Date>& exposureDates,
+            Size paths,
+            BigNatural seed = 42,
+            Real pfeQuantile = 0.95,
+            bool antitheticVariate = true);
+
+        const std::vector<Date>& exposureDates() const {
+            return exposureDates_;
+        }
+        //! expected positive exposure in the forward measure of the model
+        const std::vector<Real>& expectedExposure() const;
+        //! quantile of the positive exposure in the forward measure
+        const std::vector<Real>& potentialFutureExposure() const;
+        //! discounted expected positive exposure
+        const std::vector<Real>& discountedExpectedExposure() const;
+        //! discounted expected negative exposure (as a positive number)
+        const std::vector<Real>& discountedExpectedNegativeExposure() const;
+
+        /*! credit valuation adjustment, with counterparty defaults
+            between exposure dates assigned to the later date
+        */
+        Real cva(const Handle<DefaultProbabilityTermStructure>& ctpty,
+                 Real recoveryRate) const;
+        //! debit valuation adjustment, as above
+        Real dva(const Handle<DefaultProbabilityTermStructure>& investor,
+                 Real recoveryRate) const;
+
+      private:
+        void performCalculations() const;
+        Real adjustment(const std::vector<Real>& exposure,
+                        const Handle<DefaultProbabilityTermStructure>& dts,
+                        Real recoveryRate) const;
+        // payment of the netting set; amount is the fixed amount with
+        // sign, or null for a floating coupon, whose value is then
+        // factor * (gearing * L + spread) with L its index fixing
+        struct Flow {
+            Date paymentDate, fixingDate;
+            Time payment, start, end;
+            Real amount, factor, gearing, spread, indexAccrual;
+        };
+        void addLeg(const Leg& leg, Real sign,
+                    const Date& referenceDate) const;
+        void registerWithLeg(const Leg& leg);
+        boost::shared_ptr<Gsr> model_;
+        std::vector<boost::shared_ptr<VanillaSwap> > swaps_;
+        std::vector<boost::shared_ptr<FixedRateBond> > bonds_;
+        std::vector<Date> exposureDates_;
+        Size paths_;
+        BigNatural seed_;
+        Real pfeQuantile_;
+        bool antitheticVariate_;
+        mutable std::vector<Flow> flows_;
+        mutable std::vector<Real> ee_, pfe_, dee_, dene_;
+    };
+
+}
+
+#endif
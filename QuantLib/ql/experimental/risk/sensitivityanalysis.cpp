@@ -20,6 +20,8 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <algorithm>
+#include <map>
 
 using std::vector;
 using std::pair;
@@ -27,6 +29,47 @@ using boost::shared_ptr;
 
 namespace QuantLib {
 
+    namespace {
+
+        typedef std::map<const Observable*, vector<Size> > ReachedQuotes;
+
+        // indices of the quotes reachable from the given node through
+        // the observables it is registered with, recursively
+        const vector<Size>&
+        reachedQuotes(const Observable* node,
+                      const std::map<const Observable*, Size>& quoteIndex,
+                      ReachedQuotes& cache) {
+            ReachedQuotes::iterator cached = cache.find(node);
+            if (cached != cache.end())
+                return cached->second;
+            // the empty entry also stops cycles in the graph
+            vector<Size>& result = cache[node];
+
+            vector<Size> reached;
+            std::map<const Observable*, Size>::const_iterator q =
+                quoteIndex.find(node);
+            if (q != quoteIndex.end())
+                reached.push_back(q->second);
+            const Observer* observer = dynamic_cast<const Observer*>(node);
+            if (observer) {
+                const Observer::set_type& observables =
+                    observer->observables();
+                for (Observer::set_type::const_iterator i =
+                         observables.begin(); i != observables.end(); ++i) {
+                    const vector<Size>& r =
+                        reachedQuotes(i->get(), quoteIndex, cache);
+                    reached.insert(reached.end(), r.begin(), r.end());
+                }
+                std::sort(reached.begin(), reached.end());
+                reached.erase(std::unique(reached.begin(), reached.end()),
+                              reached.end());
+            }
+            result.swap(reached);
+            return result;
+        }
+
+    }
+
     std::ostream& operator<<(std::ostream& out,
                              SensitivityAnalysis s) {
         switch (s) {
@@ -351,4 +394,97 @@ namespace QuantLib {
         return result;
     }
 
+    void
+    bucketAnalysis(vector<vector<Real> >& deltaMatrix, // result
+                   vector<vector<Real> >& gammaMatrix, // result
+                   const boost::function<SensitivityMarket ()>& market,
+                   Real shift,
+                   SensitivityAnalysis type,
+                   Size workers)
+    {
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(type == OneSide || type == Centered,
+                   "unknown SensitivityAnalysis (" << Integer(type) << ")");
+        QL_REQUIRE(workers > 0, "null number of workers");
+
+        // the copies are built serially; the first one is also used
+        // for the reference values and the dependencies
+        vector<SensitivityMarket> markets(1, market());
+        const Size n = markets[0].quotes.size();
+        const Size m = markets[0].instruments.size();
+        QL_REQUIRE(n > 0, "empty SimpleQuote vector");
+
+        std::map<const Observable*, Size> quoteIndex;
+        for (Size i=0; i<n; ++i)
+            quoteIndex[markets[0].quotes[i].currentLink().get()] = i;
+        ReachedQuotes cache;
+        vector<vector<Size> > dependents(n);
+        vector<Real> referenceNpv(m);
+        for (Size k=0; k<m; ++k) {
+            const vector<Size>& reached =
+                reachedQuotes(markets[0].instruments[k].get(),
+                              quoteIndex, cache);
+            for (Size j=0; j<reached.size(); ++j)
+                dependents[reached[j]].push_back(k);
+            referenceNpv[k] = markets[0].instruments[k]->NPV();
+        }
+
+        const Real gammaDefault = type == OneSide ? Null<Real>() : 0.0;
+        deltaMatrix.assign(n, vector<Real>(m, 0.0));
+        gammaMatrix.assign(n, vector<Real>(m, gammaDefault));
+
+        workers = std::min(workers, n);
+        for (Size w=1; w<workers; ++w) {
+            markets.push_back(market());
+            QL_REQUIRE(markets[w].quotes.size() == n &&
+                       markets[w].instruments.size() == m,
+                       "market copy #" << w << " has "
+                       << markets[w].quotes.size() << " quotes and "
+                       << markets[w].instruments.size()
+                       << " instruments instead of " << n << " and " << m);
+        }
+
+        vector<std::string> failures(n);
+        #pragma omp parallel for schedule(static,1)
+        for (long w=0; w<(long)workers; ++w) {
+            const SensitivityMarket& copy = markets[w];
+            for (Size i=w; i<n; i+=workers) {
+                const Handle<SimpleQuote>& quote = copy.quotes[i];
+                if (!quote->isValid() || dependents[i].empty())
+                    continue;
+                const vector<Size>& k = dependents[i];
+                Real quoteValue = quote->value();
+                try {
+                    quote->setValue(quoteValue+shift);
+                    vector<Real> plus(k.size());
+                    for (Size j=0; j<k.size(); ++j)
+                        plus[j] = copy.instruments[k[j]]->NPV();
+                    if (type == OneSide) {
+                        for (Size j=0; j<k.size(); ++j)
+                            deltaMatrix[i][k[j]] =
+                                (plus[j]-referenceNpv[k[j]])/shift;
+                    } else {
+                        quote->setValue(quoteValue-shift);
+                        for (Size j=0; j<k.size(); ++j) {
+                            Real minus = copy.instruments[k[j]]->NPV();
+                            deltaMatrix[i][k[j]] =
+                                (plus[j]-minus)/(2.0*shift);
+                            gammaMatrix[i][k[j]] =
+                                (plus[j]-2.0*referenceNpv[k[j]]+minus)
+                                /(shift*shift);
+                        }
+                    }
+                    quote->setValue(quoteValue);
+                } catch (std::exception& e) {
+                    quote->setValue(quoteValue);
+                    failures[i] = e.what();
+                }
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(failures[i].empty(),
+                       "bumping quote #" << i << ": " << failures[i]);
+    }
+
 }
@@ -24,15 +24,14 @@
 #ifndef quantlib_sensitivity_analysis_hpp
 #define quantlib_sensitivity_analysis_hpp
 
-#include <ql/types.hpp>
+#include <ql/handle.hpp>
 #include <ql/utilities/null.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
 #include <vector>
 
 namespace QuantLib {
 
-    template <class T>
-    class Handle;
     class Quote;
     class SimpleQuote;
     class Instrument;
@@ -175,6 +174,44 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! quotes and instruments of a copy of the market
+    /*! The objects must not be shared, directly or through the
+        term structures, engines and other objects they depend on,
+        with any other copy, so that different copies can be used by
+        different threads.
+    */
+    struct SensitivityMarket {
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<boost::shared_ptr<Instrument> > instruments;
+    };
+
+    //! bucket sensitivities of each instrument to each SimpleQuote
+    /*! returns in deltaMatrix[i][k] and gammaMatrix[i][k] the first
+        and second derivatives of the NPV of the k-th instrument with
+        respect to the i-th quote, calculated as prescribed by
+        SensitivityAnalysis. Second derivatives are null for one-sided
+        differences.
+
+        The market is built once per worker by the given function; the
+        quotes are distributed among the workers, which bump them one
+        by one on their own copy. For each quote, only the instruments
+        that can reach it through the observer graph are repriced;
+        the others have null sensitivities.
+
+        \warning workers run concurrently only if OpenMP is enabled.
+                 Each worker only uses its own copy; objects reached
+                 through global state (such as the evaluation date or
+                 the index fixings) are only read and must not be
+                 modified by the pricing.
+    */
+    void
+    bucketAnalysis(std::vector<std::vector<Real> >& deltaMatrix, // result
+                   std::vector<std::vector<Real> >& gammaMatrix, // result
+                   const boost::function<SensitivityMarket ()>& market,
+                   Real shift = 0.0001,
+                   SensitivityAnalysis type = Centered,
+                   Size workers = 1);
+
 }
 
 #endif
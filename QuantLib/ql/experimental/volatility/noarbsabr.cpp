@@ -26,9 +26,12 @@
 #include <boost/math/special_functions/gamma.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
-#include <boost/assign/std/vector.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
 namespace QuantLib {
 
 class NoArbSabrModel::integrand {
@@ -65,6 +68,37 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
     QL_REQUIRE(rho >= detail::NoArbSabrModel::rho_min && rho <= detail::NoArbSabrModel::rho_max,
                "rho (" << rho << ") out of bounds");
 
+    integrator_ =
+        boost::shared_ptr<GaussLobattoIntegral>(new GaussLobattoIntegral(
+            detail::NoArbSabrModel::i_max_iterations, detail::NoArbSabrModel::i_accuracy));
+
+    detail::NoArbSabrModelCache::Key key(6);
+    key[0] = expiryTime;
+    key[1] = forward;
+    key[2] = alpha;
+    key[3] = beta;
+    key[4] = nu;
+    key[5] = rho;
+    detail::NoArbSabrModelCache::State state;
+    bool cached;
+    Size generation;
+    #pragma omp critical(ql_noarbsabr_model_cache)
+    {
+        detail::NoArbSabrModelCache &cache =
+            detail::NoArbSabrModelCache::instance();
+        cached = cache.find(key, state);
+        generation = cache.generation();
+    }
+    if (cached) {
+        absProb_ = state.absProb;
+        fmin_ = state.fmin;
+        fmax_ = state.fmax;
+        forward_ = state.forward;
+        numericalIntegralOverP_ = state.numericalIntegralOverP;
+        numericalForward_ = state.numericalForward;
+        return;
+    }
+
     // determine a region sufficient for integration in the normal case
 
     fmin_ = fmax_ = forward_;
@@ -84,10 +118,6 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
 
     QL_REQUIRE(fmax_ > fmin_, "could not find a reasonable integration domain");
 
-    integrator_ =
-        boost::shared_ptr<GaussLobattoIntegral>(new GaussLobattoIntegral(
-            detail::NoArbSabrModel::i_max_iterations, detail::NoArbSabrModel::i_accuracy));
-
     detail::D0Interpolator d0(forward_, expiryTime_, alpha_, beta_, nu_, rho_);
     absProb_ = d0();
 
@@ -107,6 +137,15 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
 
     Real d = forwardError(std::sqrt(forward_ - detail::NoArbSabrModel::strike_min));
     numericalForward_ = d + externalForward_;
+
+    state.absProb = absProb_;
+    state.fmin = fmin_;
+    state.fmax = fmax_;
+    state.forward = forward_;
+    state.numericalIntegralOverP = numericalIntegralOverP_;
+    state.numericalForward = numericalForward_;
+    #pragma omp critical(ql_noarbsabr_model_cache)
+    detail::NoArbSabrModelCache::instance().add(key, state, generation);
 }
 
 Real NoArbSabrModel::optionPrice(const Real strike) const {
@@ -118,6 +157,41 @@ Real NoArbSabrModel::optionPrice(const Real strike) const {
             numericalIntegralOverP_);
 }
 
+Disposable<std::vector<Real> >
+NoArbSabrModel::optionPrices(const std::vector<Real> &strikes) const {
+    for (Size i = 1; i < strikes.size(); ++i)
+        QL_REQUIRE(strikes[i] > strikes[i - 1],
+                   "strikes must be strictly ascending ("
+                       << strikes[i - 1] << "," << strikes[i] << ")");
+    std::vector<Real> result(strikes.size());
+    // strikes whose integration domain is not [strike, fmax] are
+    // priced one by one
+    Size n = strikes.size();
+    while (n > 0 && 2.0 * strikes[n - 1] > fmax_) {
+        --n;
+        result[n] = optionPrice(strikes[n]);
+    }
+    // for strike k_i below the next strike k_{i+1}, with
+    // m0 = int_{k_{i+1}}^{fmax} p and c = int_{k_{i+1}}^{fmax} (f-k_{i+1}) p
+    // we have int_{k_i}^{fmax} (f-k_i) p =
+    //     c + (k_{i+1}-k_i) m0 + int_{k_i}^{k_{i+1}} (f-k_i) p
+    Real m0 = 0.0, c = 0.0, next = fmax_;
+    for (Size j = n; j > 0; --j) {
+        Real k = strikes[j - 1];
+        c += (next - k) * m0 +
+             (*integrator_)(integrand(this, k), k, next);
+        m0 += (*integrator_)(
+            std::bind1st(std::mem_fun(&NoArbSabrModel::p), this), k, next);
+        next = k;
+        if (p(std::max(forward_, k)) <
+            detail::NoArbSabrModel::density_threshold)
+            result[j - 1] = 0.0;
+        else
+            result[j - 1] = (1.0 - absProb_) * (c / numericalIntegralOverP_);
+    }
+    return result;
+}
+
 Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
     if (strike < QL_MIN_POSITIVE_REAL)
         return 1.0;
@@ -178,9 +252,178 @@ Real NoArbSabrModel::p(const Real f) const {
     return res;
 }
 
+namespace {
+    // header of the binary absorption table files
+    const char absorptionTableTag[8] = {'Q', 'L', 'N', 'A', 'S', 'A', 'B', '1'};
+}
+
+NoArbSabrAbsorptionTable::NoArbSabrAbsorptionTable()
+#ifndef QL_NOARBSABR_EXTERNAL_TABLE
+    : data_(detail::sabrabsprob) {}
+#else
+    : data_(0) {}
+#endif
+
+void NoArbSabrAbsorptionTable::load(const std::string &fileName) {
+    std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+    QL_REQUIRE(in, "could not open absorption table file " << fileName);
+    char tag[8];
+    in.read(tag, 8);
+    QL_REQUIRE(in && std::equal(tag, tag + 8, absorptionTableTag),
+               fileName << " is not an absorption table file");
+    std::vector<unsigned char> buffer(4 * size);
+    in.read(reinterpret_cast<char *>(&buffer[0]), buffer.size());
+    QL_REQUIRE(in && in.gcount() == std::streamsize(buffer.size()),
+               "absorption table file " << fileName << " is truncated");
+    boost::shared_ptr<std::vector<unsigned long> > values(
+        new std::vector<unsigned long>(size));
+    for (Size i = 0; i < size; ++i) {
+        const unsigned char *b = &buffer[4 * i];
+        (*values)[i] = (unsigned long)b[0] | ((unsigned long)b[1] << 8) |
+                       ((unsigned long)b[2] << 16) |
+                       ((unsigned long)b[3] << 24);
+    }
+    // models being built keep their view of the previous table
+    #pragma omp critical(ql_noarbsabr_absorption_table)
+    {
+        loaded_ = values;
+        data_ = &(*values)[0];
+    }
+    #pragma omp critical(ql_noarbsabr_model_cache)
+    detail::NoArbSabrModelCache::instance().clear();
+}
+
+void NoArbSabrAbsorptionTable::save(const std::string &fileName) const {
+    const View table = view();
+    QL_REQUIRE(!table.empty(), "no absorption table to save");
+    std::vector<unsigned char> buffer(4 * size);
+    for (Size i = 0; i < size; ++i) {
+        QL_REQUIRE(table[i] <= 0xFFFFFFFFUL,
+                   "absorption count (" << table[i] << ") at index " << i
+                                        << " does not fit in four bytes");
+        unsigned char *b = &buffer[4 * i];
+        b[0] = (unsigned char)(table[i] & 0xFF);
+        b[1] = (unsigned char)((table[i] >> 8) & 0xFF);
+        b[2] = (unsigned char)((table[i] >> 16) & 0xFF);
+        b[3] = (unsigned char)((table[i] >> 24) & 0xFF);
+    }
+    std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+    QL_REQUIRE(out, "could not open absorption table file " << fileName);
+    out.write(absorptionTableTag, 8);
+    out.write(reinterpret_cast<const char *>(&buffer[0]), buffer.size());
+    QL_REQUIRE(out, "could not write absorption table file " << fileName);
+}
+
+void NoArbSabrAbsorptionTable::useBuiltIn() {
+#ifdef QL_NOARBSABR_EXTERNAL_TABLE
+    QL_FAIL("absorption table not compiled into the library");
+#else
+    #pragma omp critical(ql_noarbsabr_absorption_table)
+    {
+        loaded_.reset();
+        data_ = detail::sabrabsprob;
+    }
+#endif
+    #pragma omp critical(ql_noarbsabr_model_cache)
+    detail::NoArbSabrModelCache::instance().clear();
+}
+
+NoArbSabrAbsorptionTable::View NoArbSabrAbsorptionTable::view() const {
+    View v;
+    #pragma omp critical(ql_noarbsabr_absorption_table)
+    {
+        v.data_ = data_;
+        v.loaded_ = loaded_;
+    }
+    return v;
+}
+
+bool NoArbSabrAbsorptionTable::builtIn() const {
+    const View table = view();
+    return !table.empty() && !table.loaded_;
+}
+
+bool NoArbSabrAbsorptionTable::empty() const {
+    return view().empty();
+}
+
 namespace detail {
 
-using namespace boost::assign;
+bool NoArbSabrModelCache::find(const Key &key, State &state) const {
+    std::map<Key, State>::const_iterator i = states_.find(key);
+    if (i == states_.end())
+        return false;
+    state = i->second;
+    return true;
+}
+
+void NoArbSabrModelCache::add(const Key &key, const State &state,
+                              Size generation) {
+    if (maxSize_ == 0 || generation != generation_)
+        return;
+    if (states_.size() >= maxSize_)
+        states_.clear();
+    states_[key] = state;
+}
+
+void NoArbSabrModelCache::clear() {
+    states_.clear();
+    ++generation_;
+}
+
+Size NoArbSabrModelCache::size() const {
+    return states_.size();
+}
+
+Size NoArbSabrModelCache::generation() const {
+    return generation_;
+}
+
+void NoArbSabrModelCache::setMaxSize(Size n) {
+    maxSize_ = n;
+    if (states_.size() > maxSize_)
+        states_.clear();
+}
+
+namespace {
+
+// grids of the absorption table, the first index running fastest
+const Real tauG[] = {
+    0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0, 2.25, 2.5, 2.75, 3.0,
+    3.25, 3.5, 3.75, 4.0, 4.25, 4.5, 4.75, 5.0, 5.25, 5.5, 5.75, 6.0, 6.25,
+    6.5, 6.75, 7.0, 7.25, 7.5, 7.75, 8.0, 8.25, 8.5, 8.75, 9.0, 9.25, 9.5,
+    9.75, 10.0, 10.25, 10.5, 10.75, 11.0, 11.25, 11.5, 11.75, 12.0, 12.25,
+    12.5, 12.75, 13.0, 13.25, 13.5, 13.75, 14.0, 14.25, 14.5, 14.75, 15.0,
+    15.25, 15.5, 15.75, 16.0, 16.25, 16.5, 16.75, 17.0, 17.25, 17.5, 17.75,
+    18.0, 18.25, 18.5, 18.75, 19.0, 19.25, 19.5, 19.75, 20.0, 20.25, 20.5,
+    20.75, 21.0, 21.25, 21.5, 21.75, 22.0, 22.25, 22.5, 22.75, 23.0, 23.25,
+    23.5, 23.75, 24.0, 24.25, 24.5, 24.75, 25.0, 25.25, 25.5, 25.75, 26.0,
+    26.25, 26.5, 26.75, 27.0, 27.25, 27.5, 27.75, 28.0, 28.25, 28.5, 28.75,
+    29.0, 29.25, 29.5, 29.75, 30.0};
+const Size tauSize = sizeof(tauG) / sizeof(tauG[0]);
+
+const Real sigmaIG[] = {1.0,  0.8,  0.7,  0.6,   0.5, 0.45,
+                        0.4,  0.35, 0.3,  0.27,  0.24, 0.21,
+                        0.18, 0.15, 0.125, 0.1, 0.075, 0.05};
+const Size sigmaISize = sizeof(sigmaIG) / sizeof(sigmaIG[0]);
+
+const Real rhoG[] = {0.75, 0.50, 0.25, 0.00, -0.25, -0.50, -0.75};
+const Size rhoSize = sizeof(rhoG) / sizeof(rhoG[0]);
+
+const Real nuG[] = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8};
+const Size nuSize = sizeof(nuG) / sizeof(nuG[0]);
+
+const Real betaG[] = {0.01, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9};
+const Size betaSize = sizeof(betaG) / sizeof(betaG[0]);
+
+// index of the first element of a decreasing grid below x
+Size lowerIndexDecreasing(const Real *g, Size n, Real x) {
+    return n - (std::upper_bound(std::reverse_iterator<const Real *>(g + n),
+                                 std::reverse_iterator<const Real *>(g), x) -
+                std::reverse_iterator<const Real *>(g + n));
+}
+
+} // anonymous namespace
 
 D0Interpolator::D0Interpolator(const Real forward, const Real expiryTime,
                                const Real alpha, const Real beta, const Real nu,
@@ -189,27 +432,6 @@ D0Interpolator::D0Interpolator(const Real forward, const Real expiryTime,
       nu_(nu), rho_(rho), gamma_(1.0 / (2.0 * (1.0 - beta_))) {
 
     sigmaI_ = alpha_ * std::pow(forward_, beta_ - 1.0);
-
-    tauG_ += 0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0, 2.25, 2.5, 2.75, 3.0,
-        3.25, 3.5, 3.75, 4.0, 4.25, 4.5, 4.75, 5.0, 5.25, 5.5, 5.75, 6.0, 6.25,
-        6.5, 6.75, 7.0, 7.25, 7.5, 7.75, 8.0, 8.25, 8.5, 8.75, 9.0, 9.25, 9.5,
-        9.75, 10.0, 10.25, 10.5, 10.75, 11.0, 11.25, 11.5, 11.75, 12.0, 12.25,
-        12.5, 12.75, 13.0, 13.25, 13.5, 13.75, 14.0, 14.25, 14.5, 14.75, 15.0,
-        15.25, 15.5, 15.75, 16.0, 16.25, 16.5, 16.75, 17.0, 17.25, 17.5, 17.75,
-        18.0, 18.25, 18.5, 18.75, 19.0, 19.25, 19.5, 19.75, 20.0, 20.25, 20.5,
-        20.75, 21.0, 21.25, 21.5, 21.75, 22.0, 22.25, 22.5, 22.75, 23.0, 23.25,
-        23.5, 23.75, 24.0, 24.25, 24.5, 24.75, 25.0, 25.25, 25.5, 25.75, 26.0,
-        26.25, 26.5, 26.75, 27.0, 27.25, 27.5, 27.75, 28.0, 28.25, 28.5, 28.75,
-        29.0, 29.25, 29.5, 29.75, 30.0;
-
-    sigmaIG_ += 1.0, 0.8, 0.7, 0.6, 0.5, 0.45, 0.4, 0.35, 0.3, 0.27, 0.24, 0.21,
-        0.18, 0.15, 0.125, 0.1, 0.075, 0.05;
-
-    rhoG_ += 0.75, 0.50, 0.25, 0.00, -0.25, -0.50, -0.75;
-
-    nuG_ += 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8;
-
-    betaG_ += 0.01, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9;
 }
 
 Real D0Interpolator::operator()() const {
@@ -217,63 +439,89 @@ Real D0Interpolator::operator()() const {
     // we do not need to check the indices here, because this is already
     // done in the NoArbSabr constructor
 
-    Size tauInd = std::upper_bound(tauG_.begin(), tauG_.end(), expiryTime_) -
-                                   tauG_.begin();
-    if (tauInd == tauG_.size())
+    Size tauInd = std::upper_bound(tauG, tauG + tauSize, expiryTime_) - tauG;
+    if (tauInd == tauSize)
         --tauInd; // tau at upper bound
     Real expiryTimeTmp = expiryTime_;
     if (tauInd == 0) {
         ++tauInd;
-        expiryTimeTmp = tauG_.front();
+        expiryTimeTmp = tauG[0];
     }
-    Real tauL = (expiryTimeTmp - tauG_[tauInd - 1]) /
-                (tauG_[tauInd] - tauG_[tauInd - 1]);
+    Real tauL = (expiryTimeTmp - tauG[tauInd - 1]) /
+                (tauG[tauInd] - tauG[tauInd - 1]);
 
-    int sigmaIInd =
-        sigmaIG_.size() -
-        (std::upper_bound(sigmaIG_.rbegin(), sigmaIG_.rend(), sigmaI_) -
-         sigmaIG_.rbegin());
+    Size sigmaIInd = lowerIndexDecreasing(sigmaIG, sigmaISize, sigmaI_);
     if (sigmaIInd == 0)
         ++sigmaIInd; // sigmaI at upper bound
-    Real sigmaIL = (sigmaI_ - sigmaIG_[sigmaIInd - 1]) /
-                   (sigmaIG_[sigmaIInd] - sigmaIG_[sigmaIInd - 1]);
+    Real sigmaIL = (sigmaI_ - sigmaIG[sigmaIInd - 1]) /
+                   (sigmaIG[sigmaIInd] - sigmaIG[sigmaIInd - 1]);
 
-    int rhoInd =
-        rhoG_.size() -
-        (std::upper_bound(rhoG_.rbegin(), rhoG_.rend(), rho_) - rhoG_.rbegin());
+    Size rhoInd = lowerIndexDecreasing(rhoG, rhoSize, rho_);
     if (rhoInd == 0) {
         rhoInd++;
     }
-    if (rhoInd == static_cast<int>(rhoG_.size())) {
+    if (rhoInd == rhoSize) {
         rhoInd--;
     }
-    Real rhoL =
-        (rho_ - rhoG_[rhoInd - 1]) / (rhoG_[rhoInd] - rhoG_[rhoInd - 1]);
+    Real rhoL = (rho_ - rhoG[rhoInd - 1]) / (rhoG[rhoInd] - rhoG[rhoInd - 1]);
 
     // for nu = 0 we know phi = 0.5*z_F^2
-    Size nuInd = std::upper_bound(nuG_.begin(), nuG_.end(), nu_) - nuG_.begin();
-    if (nuInd == nuG_.size())
+    Size nuInd = std::upper_bound(nuG, nuG + nuSize, nu_) - nuG;
+    if (nuInd == nuSize)
         --nuInd; // nu at upper bound
-    Real tmpNuG = nuInd > 0 ? nuG_[nuInd - 1] : 0.0;
-    Real nuL = (nu_ - tmpNuG) / (nuG_[nuInd] - tmpNuG);
+    Real tmpNuG = nuInd > 0 ? nuG[nuInd - 1] : 0.0;
+    Real nuL = (nu_ - tmpNuG) / (nuG[nuInd] - tmpNuG);
 
     // for beta = 1 we know phi = 0.0
-    Size betaInd =
-        std::upper_bound(betaG_.begin(), betaG_.end(), beta_) - betaG_.begin();
+    Size betaInd = std::upper_bound(betaG, betaG + betaSize, beta_) - betaG;
     Real tmpBetaG;
-    if (betaInd == betaG_.size())
+    if (betaInd == betaSize)
         tmpBetaG = 1.0;
     else
-        tmpBetaG = betaG_[betaInd];
+        tmpBetaG = betaG[betaInd];
     Real betaL =
-        (beta_ - betaG_[betaInd - 1]) / (tmpBetaG - betaG_[betaInd - 1]);
+        (beta_ - betaG[betaInd - 1]) / (tmpBetaG - betaG[betaInd - 1]);
+
+    // interpolation weights of the lower and upper nodes in each
+    // dimension; corners with a zero weight do not contribute and are
+    // skipped, which saves the inversion of the incomplete gamma
+    // function when the parameters are on the grid
+    const Real wTau[] = {1.0 - tauL, tauL};
+    const Real wSigma[] = {1.0 - sigmaIL, sigmaIL};
+    const Real wRho[] = {1.0 - rhoL, rhoL};
+    const Real wNu[] = {1.0 - nuL, nuL};
+    const Real wBeta[] = {1.0 - betaL, betaL};
+
+    const Size sigmaStride = tauSize, rhoStride = sigmaStride * sigmaISize,
+               nuStride = rhoStride * rhoSize, betaStride = nuStride * nuSize;
+
+    // the first access creates the table, which must not race with
+    // the construction of models in other threads; the view keeps
+    // the table alive if another one is loaded meanwhile
+    const NoArbSabrAbsorptionTable *tablePtr;
+    #pragma omp critical(ql_noarbsabr_model_cache)
+    tablePtr = &NoArbSabrAbsorptionTable::instance();
+    const NoArbSabrAbsorptionTable::View table = tablePtr->view();
+    QL_REQUIRE(!table.empty(),
+               "no absorption table available, it must be loaded "
+               "through NoArbSabrAbsorptionTable::load()");
 
     Real phiRes = 0.0;
     for (int iTau = -1; iTau <= 0; ++iTau) {
+        if (wTau[iTau + 1] == 0.0)
+            continue;
         for (int iSigma = -1; iSigma <= 0; ++iSigma) {
+            if (wSigma[iSigma + 1] == 0.0)
+                continue;
             for (int iRho = -1; iRho <= 0; ++iRho) {
+                if (wRho[iRho + 1] == 0.0)
+                    continue;
                 for (int iNu = -1; iNu <= 0; ++iNu) {
+                    if (wNu[iNu + 1] == 0.0)
+                        continue;
                     for (int iBeta = -1; iBeta <= 0; ++iBeta) {
+                        if (wBeta[iBeta + 1] == 0.0)
+                            continue;
                         Real phiTmp;
                         if (iNu == -1 && nuInd == 0) {
                             phiTmp =
@@ -281,30 +529,25 @@ Real D0Interpolator::operator()() const {
                                 (sigmaI_ * sigmaI_ * (1.0 - beta_) *
                                  (1.0 - beta_)); // this is 0.5*z_F^2, see above
                         } else {
-                            if (iBeta == 0 && betaInd == betaG_.size()) {
+                            if (iBeta == 0 && betaInd == betaSize) {
                                 phiTmp =
                                     phi(detail::NoArbSabrModel::tiny_prob);
                             } else {
-                                int ind = (tauInd + iTau +
-                                           (sigmaIInd + iSigma +
-                                            (rhoInd + iRho +
-                                             (nuInd + iNu + ((betaInd + iBeta) *
-                                                             nuG_.size())) *
-                                                 rhoG_.size()) *
-                                                sigmaIG_.size()) *
-                                               tauG_.size());
-                                QL_REQUIRE(ind >= 0 && ind < 1209600,
+                                Size ind = (tauInd + iTau) +
+                                           (sigmaIInd + iSigma) * sigmaStride +
+                                           (rhoInd + iRho) * rhoStride +
+                                           (nuInd + iNu) * nuStride +
+                                           (betaInd + iBeta) * betaStride;
+                                QL_REQUIRE(ind < NoArbSabrAbsorptionTable::size,
                                            "absorption matrix index ("
                                                << ind << ") invalid");
-                                phiTmp = phi((Real)sabrabsprob[ind] /
+                                phiTmp = phi((Real)table[ind] /
                                              detail::NoArbSabrModel::nsim);
                             }
                         }
-                        phiRes += phiTmp * (iTau == -1 ? (1.0 - tauL) : tauL) *
-                                  (iSigma == -1 ? (1.0 - sigmaIL) : sigmaIL) *
-                                  (iRho == -1 ? (1.0 - rhoL) : rhoL) *
-                                  (iNu == -1 ? (1.0 - nuL) : nuL) *
-                                  (iBeta == -1 ? (1.0 - betaL) : betaL);
+                        phiRes += phiTmp * wTau[iTau + 1] *
+                                  wSigma[iSigma + 1] * wRho[iRho + 1] *
+                                  wNu[iNu + 1] * wBeta[iBeta + 1];
                     }
                 }
             }
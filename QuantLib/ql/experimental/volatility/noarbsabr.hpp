@@ -45,6 +45,14 @@
     model implied forward different from the desired one.
     This situation can be identified by comparing forward()
     and numericalForward().
+
+    The absorption probabilities are read from the table compiled
+    into the library, or from a binary file loaded through
+    NoArbSabrAbsorptionTable. Since the calibration of the model
+    forward is the expensive part of the construction, its results
+    are cached for each set of (expiry, forward, alpha, beta, nu,
+    rho), so that smile sections built repeatedly with the same
+    parameters, e.g. during a cube calibration, reuse it.
 */
 
 #ifndef quantlib_noarb_sabr
@@ -53,7 +61,11 @@
 #include <ql/qldefines.hpp>
 #include <ql/types.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
+#include <ql/utilities/disposable.hpp>
+#include <ql/patterns/singleton.hpp>
 
+#include <map>
+#include <string>
 #include <vector>
 
 namespace QuantLib {
@@ -106,6 +118,12 @@ class NoArbSabrModel {
               const Real beta, const Real nu, const Real rho);
 
     Real optionPrice(const Real strike) const;
+    /*! call prices for strictly ascending strikes; the integrals
+        over the density are accumulated once from the right end of
+        the integration domain, piece by piece between the strikes.
+    */
+    Disposable<std::vector<Real> >
+    optionPrices(const std::vector<Real> &strikes) const;
     Real digitalOptionPrice(const Real strike) const;
     Real density(const Real strike) const {
         return p(strike) * (1 - absProb_) / numericalIntegralOverP_;
@@ -134,9 +152,69 @@ class NoArbSabrModel {
     friend class integrand;
 };
 
+//! absorption probability table of the no-arbitrage SABR model
+/*! The table holds the number of absorptions out of
+    detail::NoArbSabrModel::nsim simulations on the grid of
+    detail::D0Interpolator. By default the table compiled into the
+    library is used; save() writes it to a compact binary file
+    (an eight byte header followed by the counts as four byte
+    little endian integers) which can be loaded back with load().
+
+    If the library is built with QL_NOARBSABR_EXTERNAL_TABLE
+    defined (see the --disable-noarbsabr-table configure option)
+    the table is not compiled in, which saves a large source file
+    in the build; a file must then be loaded before any model is
+    built. It can be generated from the source of the table with
+    tools/noarbsabr_table.py.
+
+    Loading a table clears the calibration cache of the models.
+    When OpenMP is enabled, a table can be loaded while models are
+    built in other threads; these keep using the table they started
+    with through a View.
+*/
+class NoArbSabrAbsorptionTable
+    : public Singleton<NoArbSabrAbsorptionTable> {
+    friend class Singleton<NoArbSabrAbsorptionTable>;
+
+  private:
+    NoArbSabrAbsorptionTable();
+
+  public:
+    static const Size size = 1209600;
+    //! table in use at the time of its creation
+    /*! a view stays valid after another table is loaded */
+    class View {
+      public:
+        View() : data_(0) {}
+        //! number of absorptions at the given index of the table
+        unsigned long operator[](Size i) const { return data_[i]; }
+        bool empty() const { return data_ == 0; }
+      private:
+        friend class NoArbSabrAbsorptionTable;
+        const unsigned long *data_;
+        boost::shared_ptr<const std::vector<unsigned long> > loaded_;
+    };
+    View view() const;
+    //! reads the table from a file written by save()
+    void load(const std::string &fileName);
+    //! writes the table currently in use
+    void save(const std::string &fileName) const;
+    //! reverts to the table compiled into the library
+    void useBuiltIn();
+    bool builtIn() const;
+    //! whether a table is available, i.e. built in or loaded
+    bool empty() const;
+
+  private:
+    const unsigned long *data_;
+    boost::shared_ptr<const std::vector<unsigned long> > loaded_;
+};
+
 namespace detail {
 
+#ifndef QL_NOARBSABR_EXTERNAL_TABLE
 extern "C" const unsigned long sabrabsprob[1209600];
+#endif
 
 class D0Interpolator {
   public:
@@ -149,7 +227,41 @@ class D0Interpolator {
     Real d0(const Real phi) const;
     const Real forward_, expiryTime_, alpha_, beta_, nu_, rho_, gamma_;
     Real sigmaI_;
-    std::vector<Real> tauG_, sigmaIG_, rhoG_, nuG_, betaG_;
+};
+
+//! cache of the calibrated forwards and normalizations of the model
+/*! When OpenMP is enabled, calls must be made inside the
+    ql_noarbsabr_model_cache critical section. The generation is
+    increased whenever the cache is cleared, e.g. by loading an
+    absorption table; states calibrated before that are not added.
+*/
+class NoArbSabrModelCache : public Singleton<NoArbSabrModelCache> {
+    friend class Singleton<NoArbSabrModelCache>;
+
+  private:
+    NoArbSabrModelCache() : maxSize_(10000), generation_(0) {}
+
+  public:
+    struct State {
+        Real absProb, fmin, fmax, forward, numericalIntegralOverP,
+            numericalForward;
+    };
+    // the key holds expiry time, forward, alpha, beta, nu and rho
+    typedef std::vector<Real> Key;
+    bool find(const Key &key, State &state) const;
+    //! the state is ignored if the cache was cleared since the given generation
+    void add(const Key &key, const State &state, Size generation);
+    void clear();
+    Size size() const;
+    Size generation() const;
+    /*! the cache is cleared when it grows beyond the given size; a
+        size of zero disables it
+    */
+    void setMaxSize(Size n);
+
+  private:
+    std::map<Key, State> states_;
+    Size maxSize_, generation_;
 };
 
 } // namespace detail
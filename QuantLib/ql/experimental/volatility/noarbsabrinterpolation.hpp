@@ -235,6 +235,9 @@ class NoArbSabrInterpolation : public Interpolation {
         return coeffs_->weights_;
     }
     EndCriteria::Type endCriteria() { return coeffs_->XABREndCriteria_; }
+    Size functionEvaluations() const {
+        return coeffs_->XABRFunctionEvaluations_;
+    }
 
   private:
     boost::shared_ptr<detail::XABRCoeffHolder<detail::NoArbSabrSpecs> > coeffs_;
@@ -22,6 +22,7 @@
 #include <ql/termstructures/volatility/sabr.hpp>
 
 #include <boost/make_shared.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -61,6 +62,32 @@ Real NoArbSabrSmileSection::optionPrice(Rate strike, Option::Type type,
            (type == Option::Call ? call : call - (forward_ - strike));
 }
 
+void NoArbSabrSmileSection::optionPrices(const std::vector<Rate> &strikes,
+                                         std::vector<Real> &prices,
+                                         Option::Type type,
+                                         Real discount) const {
+    callPrices(strikes, prices);
+    for (Size i = 0; i < strikes.size(); ++i)
+        prices[i] = discount * (type == Option::Call
+                                    ? prices[i]
+                                    : prices[i] - (forward_ - strikes[i]));
+}
+
+void NoArbSabrSmileSection::callPrices(const std::vector<Rate> &strikes,
+                                       std::vector<Real> &calls) const {
+    std::vector<Rate> sorted(strikes);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    calls.resize(strikes.size());
+    if (sorted.empty())
+        return;
+    std::vector<Real> tmp = model_->optionPrices(sorted);
+    for (Size i = 0; i < strikes.size(); ++i)
+        calls[i] = tmp[std::lower_bound(sorted.begin(), sorted.end(),
+                                        strikes[i]) -
+                       sorted.begin()];
+}
+
 Real NoArbSabrSmileSection::digitalOptionPrice(Rate strike, Option::Type type,
                                                Real discount, Real) const {
     Real call = model_->digitalOptionPrice(strike);
@@ -72,6 +99,19 @@ Real NoArbSabrSmileSection::density(Rate strike, Real discount, Real) const {
 }
 
 Real NoArbSabrSmileSection::volatilityImpl(Rate strike) const {
+    return impliedVolatility(strike, model_->optionPrice(strike));
+}
+
+void NoArbSabrSmileSection::volatilitiesImpl(const std::vector<Rate> &strikes,
+                                             std::vector<Volatility> &vols) const {
+    std::vector<Real> calls;
+    callPrices(strikes, calls);
+    for (Size i = 0; i < strikes.size(); ++i)
+        vols[i] = impliedVolatility(strikes[i], calls[i]);
+}
+
+Volatility NoArbSabrSmileSection::impliedVolatility(Rate strike,
+                                                    Real call) const {
 
     Real impliedVol = 0.0;
     try {
@@ -80,10 +120,10 @@ Real NoArbSabrSmileSection::volatilityImpl(Rate strike) const {
             type = Option::Call;
         else
             type = Option::Put;
-        impliedVol =
-            blackFormulaImpliedStdDev(type, strike, forward_,
-                                      optionPrice(strike, type, 1.0), 1.0) /
-            std::sqrt(exerciseTime());
+        Real price = type == Option::Call ? call : call - (forward_ - strike);
+        impliedVol = blackFormulaImpliedStdDev(type, strike, forward_, price,
+                                               1.0) /
+                     std::sqrt(exerciseTime());
     } catch (...) {
     }
     if (impliedVol == 0.0)
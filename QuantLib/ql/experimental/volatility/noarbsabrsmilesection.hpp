@@ -46,6 +46,10 @@ class NoArbSabrSmileSection : public SmileSection {
     Real atmLevel() const { return forward_; }
     Real optionPrice(Rate strike, Option::Type type = Option::Call,
                      Real discount = 1.0) const;
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices,
+                      Option::Type type = Option::Call,
+                      Real discount = 1.0) const;
     Real digitalOptionPrice(Rate strike, Option::Type type = Option::Call,
                             Real discount = 1.0, Real gap = 1.0e-5) const;
     Real density(Rate strike, Real discount = 1.0, Real gap = 1.0E-4) const;
@@ -54,9 +58,15 @@ class NoArbSabrSmileSection : public SmileSection {
 
   protected:
     Volatility volatilityImpl(Rate strike) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols) const;
 
   private:
     void init();
+    // call prices from a single pass of the model over the sorted strikes
+    void callPrices(const std::vector<Rate> &strikes,
+                    std::vector<Real> &calls) const;
+    Volatility impliedVolatility(Rate strike, Real call) const;
     boost::shared_ptr<NoArbSabrModel> model_;
     Rate forward_;
     std::vector<Real> params_;
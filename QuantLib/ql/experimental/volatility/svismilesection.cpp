@@ -53,4 +53,22 @@ Real SviSmileSection::volatilityImpl(Rate strike) const {
     return std::sqrt(std::max(0.0, totalVariance / exerciseTime()));
 
 }
+
+void SviSmileSection::volatilitiesImpl(const std::vector<Rate> &strikes,
+                                       std::vector<Volatility> &vols) const {
+    const Real a = params_[0], b = params_[1], sigma = params_[2],
+               rho = params_[3], m = params_[4];
+    const Real t = exerciseTime();
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real k = std::log(std::max(strikes[i], 1E-6) / forward_);
+        Real totalVariance = detail::sviTotalVariance(a, b, sigma, rho, m, k);
+        vols[i] = std::sqrt(std::max(0.0, totalVariance / t));
+    }
+}
+
+void SviSmileSection::optionPrices(const std::vector<Rate> &strikes,
+                                   std::vector<Real> &prices,
+                                   Option::Type type, Real discount) const {
+    optionPricesFromVolatilities(strikes, prices, type, discount);
+}
 } // namespace QuantLib
@@ -41,9 +41,15 @@ class SviSmileSection : public SmileSection {
     Real minStrike() const { return 0.0; }
     Real maxStrike() const { return QL_MAX_REAL; }
     Real atmLevel() const { return forward_; }
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices,
+                      Option::Type type = Option::Call,
+                      Real discount = 1.0) const;
 
   protected:
     Volatility volatilityImpl(Rate strike) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols) const;
 
   private:
     void init();
@@ -30,6 +30,7 @@
 #include <ql/experimental/volatility/zabr.hpp>
 #include <ql/termstructures/volatility/smilesectionutils.hpp>
 #include <vector>
+#include <algorithm>
 
 using std::exp;
 
@@ -61,6 +62,12 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
                      Real discount = 1.0) const {
         return optionPrice(strike, type, discount, Evaluation());
     }
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices,
+                      Option::Type type = Option::Call,
+                      Real discount = 1.0) const {
+        optionPrices(strikes, prices, type, discount, Evaluation());
+    }
 
     boost::shared_ptr<ZabrModel> model() { return model_; }
 
@@ -68,6 +75,10 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
     Volatility volatilityImpl(Rate strike) const {
         return volatilityImpl(strike, Evaluation());
     }
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols) const {
+        volatilitiesImpl(strikes, vols, Evaluation());
+    }
 
   private:
     void init(const std::vector<Real> &moneyness) {
@@ -99,6 +110,35 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
     Volatility volatilityImpl(Rate strike, ZabrShortMaturityNormal) const;
     Volatility volatilityImpl(Rate strike, ZabrLocalVolatility) const;
     Volatility volatilityImpl(Rate strike, ZabrFullFd) const;
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices, Option::Type type,
+                      Real discount, ZabrShortMaturityLognormal) const;
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices, Option::Type type,
+                      Real discount, ZabrShortMaturityNormal) const;
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices, Option::Type type,
+                      Real discount, ZabrLocalVolatility) const;
+    void optionPrices(const std::vector<Rate> &strikes,
+                      std::vector<Real> &prices, Option::Type type,
+                      Real discount, ZabrFullFd) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols,
+                          ZabrShortMaturityLognormal) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols,
+                          ZabrShortMaturityNormal) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols,
+                          ZabrLocalVolatility) const;
+    void volatilitiesImpl(const std::vector<Rate> &strikes,
+                          std::vector<Volatility> &vols, ZabrFullFd) const;
+    // model volatilities for arbitrary strikes, computed with a single
+    // integration over the sorted strikes
+    void modelVolatilities(const std::vector<Rate> &strikes, bool normal,
+                           std::vector<Real> &vols) const;
+    Volatility impliedVolatility(Rate strike, Option::Type type,
+                                 Real price) const;
     boost::shared_ptr<ZabrModel> model_;
     Evaluation evaluation_;
     Rate forward_;
@@ -298,20 +338,9 @@ template <typename Evaluation>
 Real
 ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
                                              ZabrShortMaturityNormal) const {
-    Real impliedVol = 0.0;
-    try {
-        Option::Type type;
-        if (strike >= model_->forward())
-            type = Option::Call;
-        else
-            type = Option::Put;
-        impliedVol =
-            blackFormulaImpliedStdDev(type, strike, model_->forward(),
-                                      optionPrice(strike, type, 1.0), 1.0) /
-            std::sqrt(exerciseTime());
-    } catch (...) {
-    }
-    return impliedVol;
+    Option::Type type =
+        strike >= model_->forward() ? Option::Call : Option::Put;
+    return impliedVolatility(strike, type, optionPrice(strike, type, 1.0));
 }
 
 template <typename Evaluation>
@@ -325,6 +354,116 @@ Real ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
                                                   ZabrFullFd) const {
     return volatilityImpl(strike, ZabrShortMaturityNormal());
 }
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::optionPrices(
+    const std::vector<Rate> &strikes, std::vector<Real> &prices,
+    Option::Type type, Real discount, ZabrShortMaturityLognormal) const {
+    optionPricesFromVolatilities(strikes, prices, type, discount);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::optionPrices(
+    const std::vector<Rate> &strikes, std::vector<Real> &prices,
+    Option::Type type, Real discount, ZabrShortMaturityNormal) const {
+    std::vector<Real> vols;
+    modelVolatilities(strikes, true, vols);
+    prices.resize(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i)
+        prices[i] = bachelierBlackFormula(type, strikes[i], forward_,
+                                          vols[i] * std::sqrt(exerciseTime()),
+                                          discount);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::optionPrices(
+    const std::vector<Rate> &strikes, std::vector<Real> &prices,
+    Option::Type type, Real discount, ZabrLocalVolatility) const {
+    // the call price grid is shared by all strikes already
+    SmileSection::optionPrices(strikes, prices, type, discount);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::optionPrices(
+    const std::vector<Rate> &strikes, std::vector<Real> &prices,
+    Option::Type type, Real discount, ZabrFullFd) const {
+    SmileSection::optionPrices(strikes, prices, type, discount);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::volatilitiesImpl(
+    const std::vector<Rate> &strikes, std::vector<Volatility> &vols,
+    ZabrShortMaturityLognormal) const {
+    std::vector<Rate> k(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i)
+        k[i] = std::max(1E-6, strikes[i]);
+    modelVolatilities(k, false, vols);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::volatilitiesImpl(
+    const std::vector<Rate> &strikes, std::vector<Volatility> &vols,
+    ZabrShortMaturityNormal) const {
+    std::vector<Real> normalVols;
+    modelVolatilities(strikes, true, normalVols);
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Option::Type type =
+            strikes[i] >= model_->forward() ? Option::Call : Option::Put;
+        Real price = bachelierBlackFormula(
+            type, strikes[i], forward_,
+            normalVols[i] * std::sqrt(exerciseTime()), 1.0);
+        vols[i] = impliedVolatility(strikes[i], type, price);
+    }
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::volatilitiesImpl(
+    const std::vector<Rate> &strikes, std::vector<Volatility> &vols,
+    ZabrLocalVolatility) const {
+    // the call price grid is shared by all strikes already
+    SmileSection::volatilitiesImpl(strikes, vols);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::volatilitiesImpl(
+    const std::vector<Rate> &strikes, std::vector<Volatility> &vols,
+    ZabrFullFd) const {
+    SmileSection::volatilitiesImpl(strikes, vols);
+}
+
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::modelVolatilities(
+    const std::vector<Rate> &strikes, bool normal,
+    std::vector<Real> &vols) const {
+    std::vector<Rate> sorted(strikes);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    vols.resize(strikes.size());
+    if (sorted.empty())
+        return;
+    std::vector<Real> tmp = normal ? model_->normalVolatility(sorted)
+                                   : model_->lognormalVolatility(sorted);
+    for (Size i = 0; i < strikes.size(); ++i)
+        vols[i] = tmp[std::lower_bound(sorted.begin(), sorted.end(),
+                                       strikes[i]) -
+                      sorted.begin()];
+}
+
+template <typename Evaluation>
+Volatility
+ZabrSmileSection<Evaluation>::impliedVolatility(Rate strike,
+                                                Option::Type type,
+                                                Real price) const {
+    Real impliedVol = 0.0;
+    try {
+        impliedVol =
+            blackFormulaImpliedStdDev(type, strike, model_->forward(),
+                                      price, 1.0) /
+            std::sqrt(exerciseTime());
+    } catch (...) {
+    }
+    return impliedVol;
+}
 }
 
 #endif
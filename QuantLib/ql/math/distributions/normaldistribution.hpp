@@ -261,6 +261,105 @@ namespace QuantLib {
     };
 
 
+    //! accuracy policies for the standard normal distribution
+    /*! Each policy provides the standard cumulative normal
+        distribution and its inverse through the static methods
+        cumulative() and inverseCumulative().  They are meant to be
+        used as template arguments of FastCumulativeNormal and
+        FastInverseCumulativeNormal below; the maximum absolute errors
+        of the cumulative functions and of their inverses are checked
+        in the test suite.
+    */
+    //@{
+    //! full double precision
+    /*! The cumulative distribution is the one of the
+        CumulativeNormalDistribution class; the inverse is Acklam's
+        approximation refined to full machine precision by one step
+        of Halley's method.
+    */
+    struct FullNormalAccuracy {
+        static Real cumulative(Real x);
+        static Real inverseCumulative(Real x);
+    };
+
+    //! absolute accuracy better than 1e-14
+    /*! The cumulative distribution is Hart's (1968) double precision
+        algorithm as given in G. West, "Better approximations to
+        cumulative normal functions", Wilmott Magazine, 2005.  It
+        needs a single exponential and no iteration.  The inverse is
+        Acklam's approximation refined by one step of Halley's method
+        on Hart's cumulative.
+    */
+    struct HighNormalAccuracy {
+        static Real cumulative(Real x);
+        static Real inverseCumulative(Real x);
+    };
+
+    //! about 1e-7 absolute accuracy
+    /*! The cumulative distribution is formula 26.2.17 in
+        M. Abramowitz and I. Stegun, Handbook of Mathematical
+        Functions (absolute error below 7.5e-8); the inverse is
+        Acklam's approximation.
+    */
+    struct LowNormalAccuracy {
+        static Real cumulative(Real x);
+        static Real inverseCumulative(Real x);
+    };
+    //@}
+
+    //! Cumulative normal distribution with selectable accuracy
+    /*! \test the accuracy of each policy is checked against
+              CumulativeNormalDistribution.
+    */
+    template <class Accuracy>
+    class FastCumulativeNormal : public std::unary_function<Real,Real> {
+      public:
+        FastCumulativeNormal(Real average = 0.0, Real sigma = 1.0)
+        : average_(average), sigma_(sigma) {
+            QL_REQUIRE(sigma_>0.0,
+                       "sigma must be greater than 0.0 ("
+                       << sigma_ << " not allowed)");
+        }
+        Real operator()(Real x) const {
+            return Accuracy::cumulative((x - average_) / sigma_);
+        }
+        Real derivative(Real x) const {
+            const Real xn = (x - average_) / sigma_;
+            return M_SQRT_2*M_1_SQRTPI*std::exp(-0.5*xn*xn) / sigma_;
+        }
+      private:
+        Real average_, sigma_;
+    };
+
+    //! Inverse cumulative normal distribution with selectable accuracy
+    /*! It can be used as inverse-cumulative argument of
+        InverseCumulativeRsg or of the random-number traits, e.g.,
+        GenericLowDiscrepancy<SobolRsg,
+                              FastInverseCumulativeNormal<FullNormalAccuracy> >;
+        HighAccuracyPseudoRandom and HighAccuracyLowDiscrepancy are
+        defined in rngtraits.hpp.
+
+        \test the accuracy of each policy is checked against
+              InverseCumulativeNormal.
+    */
+    template <class Accuracy>
+    class FastInverseCumulativeNormal
+        : public std::unary_function<Real,Real> {
+      public:
+        FastInverseCumulativeNormal(Real average = 0.0, Real sigma = 1.0)
+        : average_(average), sigma_(sigma) {
+            QL_REQUIRE(sigma_>0.0,
+                       "sigma must be greater than 0.0 ("
+                       << sigma_ << " not allowed)");
+        }
+        Real operator()(Real x) const {
+            return average_ + sigma_*Accuracy::inverseCumulative(x);
+        }
+      private:
+        Real average_, sigma_;
+    };
+
+
     // inline definitions
 
     inline NormalDistribution::NormalDistribution(Real average,
@@ -311,6 +410,83 @@ namespace QuantLib {
                    << sigma_ << " not allowed)");
     }
 
+    inline Real FullNormalAccuracy::cumulative(Real x) {
+        return CumulativeNormalDistribution()(x);
+    }
+
+    inline Real FullNormalAccuracy::inverseCumulative(Real x) {
+        Real z = InverseCumulativeNormal::standard_value(x);
+        // no refinement in the far tails (including the bounds returned
+        // for x = 0 and x = 1), where the derivative underflows
+        if (std::fabs(z) >= 37.0)
+            return z;
+        // error (N(z) - x) divided by the cumulative's derivative
+        const Real r = (cumulative(z) - x)
+            * M_SQRT2 * M_SQRTPI * std::exp(0.5 * z*z);
+        // Halley's method
+        z -= r/(1.0+0.5*z*r);
+        return z;
+    }
+
+    inline Real HighNormalAccuracy::cumulative(Real x) {
+        const Real ax = std::fabs(x);
+        Real c;
+        if (ax > 37.0) {
+            c = 0.0;
+        } else {
+            const Real e = std::exp(-0.5*ax*ax);
+            if (ax < 7.07106781186547) {
+                const Real n = (((((3.52624965998911e-02*ax
+                                    + 0.700383064443688)*ax
+                                   + 6.37396220353165)*ax
+                                  + 33.912866078383)*ax
+                                 + 112.079291497871)*ax
+                                + 221.213596169931)*ax
+                    + 220.206867912376;
+                const Real d = ((((((8.83883476483184e-02*ax
+                                     + 1.75566716318264)*ax
+                                    + 16.064177579207)*ax
+                                   + 86.7807322029461)*ax
+                                  + 296.564248779674)*ax
+                                 + 637.333633378831)*ax
+                                + 793.826512519948)*ax
+                    + 440.413735824752;
+                c = e*n/d;
+            } else {
+                Real b = ax + 0.65;
+                b = ax + 4.0/b;
+                b = ax + 3.0/b;
+                b = ax + 2.0/b;
+                b = ax + 1.0/b;
+                c = e/b/2.506628274631;
+            }
+        }
+        return (x > 0.0) ? 1.0 - c : c;
+    }
+
+    inline Real HighNormalAccuracy::inverseCumulative(Real x) {
+        Real z = InverseCumulativeNormal::standard_value(x);
+        // as in FullNormalAccuracy, with the cheaper cumulative
+        if (std::fabs(z) >= 37.0)
+            return z;
+        const Real r = (cumulative(z) - x)
+            * M_SQRT2 * M_SQRTPI * std::exp(0.5 * z*z);
+        z -= r/(1.0+0.5*z*r);
+        return z;
+    }
+
+    inline Real LowNormalAccuracy::cumulative(Real x) {
+        const Real t = 1.0/(1.0 + 0.2316419*std::fabs(x));
+        const Real c = M_SQRT_2*M_1_SQRTPI*std::exp(-0.5*x*x)
+            * t*(0.319381530 + t*(-0.356563782 + t*(1.781477937
+                 + t*(-1.821255978 + t*1.330274429))));
+        return (x > 0.0) ? 1.0 - c : c;
+    }
+
+    inline Real LowNormalAccuracy::inverseCumulative(Real x) {
+        return InverseCumulativeNormal::standard_value(x);
+    }
+
     inline MoroInverseCumulativeNormal::MoroInverseCumulativeNormal(
                                                  Real average, Real sigma)
     : average_(average), sigma_(sigma) {
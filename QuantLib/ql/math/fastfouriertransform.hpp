@@ -93,18 +93,26 @@ namespace QuantLib {
                 *(out + bit_reverse(i, order)) = *inBegin;
             }
             QL_REQUIRE (i <= N, "FFT order is too small");
+            // the twiddle factors of each stage are tabulated first, so
+            // that the butterflies can sweep the output sequentially
+            // block by block rather than with stride m
+            std::vector<complex> twiddle(N/2);
             for (std::size_t s = 1; s <= order; ++s) {
                 std::size_t m = static_cast<std::size_t>(1) << s;
                 complex w(1.0);
                 complex wm(cs_[s-1], inverse ? sn_[s-1] : -sn_[s-1]);
                 for (std::size_t j = 0; j < m/2; ++j) {
-                    for (std::size_t k = j; k < N; k += m) {
-                        complex t = w * (*(out + k + m/2));
+                    twiddle[j] = w;
+                    w *= wm;
+                }
+                for (std::size_t b = 0; b < N; b += m) {
+                    for (std::size_t j = 0; j < m/2; ++j) {
+                        std::size_t k = b + j;
+                        complex t = twiddle[j] * (*(out + k + m/2));
                         complex u = *(out + k);
                         *(out + k) = u + t;
                         *(out + k + m/2) = u - t;
                     }
-                    w *= wm;
                 }
             }
         }
@@ -145,6 +145,33 @@ struct SABRSpecs {
         return boost::make_shared<type>(t, forward, params, addParams);
     }
 };
+
+template <> struct XABRGradient<SABRSpecs> {
+    static bool available() { return true; }
+    // derivatives with respect to the transformed parameters, i.e.
+    // the Hagan volatility gradient times the derivatives of the
+    // component-wise transformation in SABRSpecs::direct
+    static Disposable<Array>
+    volatilityGradient(const XABRCoeffHolder<SABRSpecs> &coeffs,
+                       const Array &x, Real strike) {
+        const std::vector<Real> &p = coeffs.params_;
+        const Real shift =
+            coeffs.addParams_.size() == 0 ? 0.0 : coeffs.addParams_[0];
+        Array g = unsafeShiftedSabrVolatilityGradient(
+            strike, coeffs.forward_, coeffs.t_, p[0], p[1], p[2], p[3], shift);
+        SABRSpecs specs;
+        g[0] *= std::fabs(x[0]) < 5.0 ? 2.0 * x[0]
+                                      : (x[0] > 0.0 ? 10.0 : -10.0);
+        g[1] *= std::fabs(x[1]) < std::sqrt(-std::log(specs.eps1()))
+                    ? -2.0 * x[1] * std::exp(-(x[1] * x[1]))
+                    : 0.0;
+        g[2] *= std::fabs(x[2]) < 5.0 ? 2.0 * x[2]
+                                      : (x[2] > 0.0 ? 10.0 : -10.0);
+        g[3] *= std::fabs(x[3]) < 2.5 * M_PI ? specs.eps2() * std::cos(x[3])
+                                              : 0.0;
+        return g;
+    }
+};
 }
 
 //! %SABR smile interpolation between discrete volatility points.
@@ -190,6 +217,9 @@ class SABRInterpolation : public Interpolation {
         return coeffs_->weights_;
     }
     EndCriteria::Type endCriteria() { return coeffs_->XABREndCriteria_; }
+    Size functionEvaluations() const {
+        return coeffs_->XABRFunctionEvaluations_;
+    }
 
   private:
     boost::shared_ptr<detail::XABRCoeffHolder<detail::SABRSpecs> > coeffs_;
@@ -57,7 +57,7 @@ template <typename Model> class XABRCoeffHolder {
           paramIsFixed_(paramIsFixed.size(), false),
           weights_(std::vector<Real>()), error_(Null<Real>()),
           maxError_(Null<Real>()), XABREndCriteria_(EndCriteria::None),
-          addParams_(addParams) {
+          XABRFunctionEvaluations_(0), addParams_(addParams) {
         QL_REQUIRE(t > 0.0, "expiry time must be positive: " << t
                                                              << " not allowed");
         QL_REQUIRE(params.size() == Model().dimension(),
@@ -92,12 +92,29 @@ template <typename Model> class XABRCoeffHolder {
     /*! Interpolation results */
     Real error_, maxError_;
     EndCriteria::Type XABREndCriteria_;
+    //! cost function evaluations of the last calibration, all guesses included
+    Size XABRFunctionEvaluations_;
     /*! Model instance (if required) */
     boost::shared_ptr<typename Model::type> modelInstance_;
     /*! additional parameters */
     std::vector<Real> addParams_;
 };
 
+/*! Models able to provide the derivatives of the volatility with
+    respect to their transformed parameters specialize this class,
+    which enables an analytic jacobian of the calibration errors
+    (used by optimizers such as LevenbergMarquardt when asked to use
+    the cost function's jacobian). Otherwise finite differences are
+    used.
+*/
+template <typename Model> struct XABRGradient {
+    static bool available() { return false; }
+    static Disposable<Array> volatilityGradient(const XABRCoeffHolder<Model> &,
+                                                const Array &, Real) {
+        QL_FAIL("analytic gradient not available");
+    }
+};
+
 template <class I1, class I2, typename Model>
 class XABRInterpolationImpl : public Interpolation::templateImpl<I1, I2>,
                               public XABRCoeffHolder<Model> {
@@ -132,6 +149,7 @@ class XABRInterpolationImpl : public Interpolation::templateImpl<I1, I2>,
     void update() {
 
         this->updateModelInstance();
+        this->XABRFunctionEvaluations_ = 0;
 
         // we should also check that y contains positive values only
 
@@ -205,6 +223,7 @@ class XABRInterpolationImpl : public Interpolation::templateImpl<I1, I2>,
                 Problem problem(constrainedXABRError, constraint,
                                 projectedGuess);
                 tmpEndCriteria = optMethod_->minimize(problem, *endCriteria_);
+                this->XABRFunctionEvaluations_ += problem.functionEvaluation();
                 Array projectedResult(problem.currentValue());
                 Array transfResult(
                     constrainedXABRError.include(projectedResult));
@@ -290,24 +309,41 @@ class XABRInterpolationImpl : public Interpolation::templateImpl<I1, I2>,
         explicit XABRError(XABRInterpolationImpl *xabr) : xabr_(xabr) {}
 
         Real value(const Array &x) const {
-            const Array y = Model().direct(x, xabr_->paramIsFixed_,
-                                           xabr_->params_, xabr_->forward_);
-            for (Size i = 0; i < xabr_->params_.size(); ++i)
-                xabr_->params_[i] = y[i];
-            xabr_->updateModelInstance();
+            setParameters(x);
             return xabr_->interpolationSquaredError();
         }
 
         Disposable<Array> values(const Array &x) const {
+            setParameters(x);
+            return xabr_->interpolationErrors();
+        }
+
+        void jacobian(Matrix &jac, const Array &x) const {
+            if (!XABRGradient<Model>::available()) {
+                CostFunction::jacobian(jac, x);
+                return;
+            }
+            setParameters(x);
+            I1 k = xabr_->xBegin_;
+            std::vector<Real>::const_iterator w = xabr_->weights_.begin();
+            for (Size i = 0; k != xabr_->xEnd_; ++k, ++w, ++i) {
+                const Array g =
+                    XABRGradient<Model>::volatilityGradient(*xabr_, x, *k);
+                const Real sqrtW = std::sqrt(*w);
+                for (Size j = 0; j < g.size(); ++j)
+                    jac[i][j] = g[j] * sqrtW;
+            }
+        }
+
+      private:
+        void setParameters(const Array &x) const {
             const Array y = Model().direct(x, xabr_->paramIsFixed_,
                                            xabr_->params_, xabr_->forward_);
             for (Size i = 0; i < xabr_->params_.size(); ++i)
                 xabr_->params_[i] = y[i];
             xabr_->updateModelInstance();
-            return xabr_->interpolationErrors();
         }
 
-      private:
         XABRInterpolationImpl *xabr_;
     };
     boost::shared_ptr<EndCriteria> endCriteria_;
@@ -45,4 +45,17 @@ namespace QuantLib {
         return costFunction_.values(actualParameters_);
     }
 
+    void ProjectedCostFunction::jacobian(Matrix& jac,
+                                         const Array& freeParameters) const {
+        mapFreeParameters(freeParameters);
+        Matrix fullJacobian(jac.rows(), actualParameters_.size());
+        costFunction_.jacobian(fullJacobian, actualParameters_);
+        for (Size i = 0, j = 0; i < fixParameters_.size(); ++i) {
+            if (!fixParameters_[i]) {
+                std::copy(fullJacobian.column_begin(i),
+                          fullJacobian.column_end(i), jac.column_begin(j++));
+            }
+        }
+    }
+
 }
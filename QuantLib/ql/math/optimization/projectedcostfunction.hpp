@@ -50,6 +50,8 @@ namespace QuantLib {
             virtual Real value(const Array& freeParameters) const;
             virtual Disposable<Array>
                                    values(const Array& freeParameters) const;
+            virtual void jacobian(Matrix& jac,
+                                  const Array& freeParameters) const;
             //@}
 
         private:
@@ -77,6 +77,19 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for pseudo-random number generation with an accurate inverse
+    /*! The Gaussian variates are obtained with the inverse cumulative
+        normal of HighNormalAccuracy (absolute error of the cumulative
+        below 1e-14) instead of Acklam's approximation (1e-9).
+
+        \test Monte Carlo prices are compared with the ones obtained
+              with the default traits.
+    */
+    typedef GenericPseudoRandom<MersenneTwisterUniformRng,
+                                FastInverseCumulativeNormal<
+                                    HighNormalAccuracy> >
+                                                HighAccuracyPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
@@ -104,6 +117,12 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+    //! low-discrepancy traits with an accurate inverse, as above
+    typedef GenericLowDiscrepancy<SobolRsg,
+                                  FastInverseCumulativeNormal<
+                                      HighNormalAccuracy> >
+                                                HighAccuracyLowDiscrepancy;
+
 }
 
 
@@ -33,6 +33,30 @@
 
 namespace QuantLib {
 
+    namespace {
+        // a failing batch is redone point by point, overwriting failures
+        void localVols(const LocalVolTermStructure& localVol, Time t,
+                       const Array& x, Array& vols,
+                       Real illegalLocalVolOverwrite) {
+            if (illegalLocalVolOverwrite < 0.0) {
+                localVol.localVols(t, x, vols, true);
+            }
+            else {
+                try {
+                    localVol.localVols(t, x, vols, true);
+                } catch (Error&) {
+                    for (Size i=0; i < x.size(); ++i) {
+                        try {
+                            vols[i] = localVol.localVol(t, x[i], true);
+                        } catch (Error&) {
+                            vols[i] = illegalLocalVolOverwrite;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     Fdm2dBlackScholesOp::Fdm2dBlackScholesOp(
             const boost::shared_ptr<FdmMesher>& mesher,
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& p1,
@@ -72,32 +96,11 @@ namespace QuantLib {
         opY_.setTime(t1, t2);
         
         if (localVol1_) {
-            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
+            const Time t = 0.5*(t1+t2);
 
-            Array vol1(layout->size()), vol2(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
-
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    vol1[i] = localVol1_->localVol(0.5*(t1+t2), x_[i], true);
-                    vol2[i] = localVol2_->localVol(0.5*(t1+t2), y_[i], true);
-                }
-                else {
-                    try {
-                        vol1[i] = localVol1_->localVol(0.5*(t1+t2), x_[i],true);
-                    } catch (Error&) {
-                        vol1[i] = illegalLocalVolOverwrite_;
-                    }
-                    try {
-                        vol2[i] = localVol2_->localVol(0.5*(t1+t2), y_[i],true);
-                    } catch (Error&) {
-                        vol2[i] = illegalLocalVolOverwrite_;
-                    }
-
-                }
-            }
+            Array vol1(x_.size()), vol2(y_.size());
+            localVols(*localVol1_, t, x_, vol1, illegalLocalVolOverwrite_);
+            localVols(*localVol2_, t, y_, vol2, illegalLocalVolOverwrite_);
             corrMapT_ = corrMapTemplate_.mult(vol1*vol2);
         }
         else {
@@ -55,28 +55,26 @@ namespace QuantLib {
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
         if (localVol_) {
-            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
+            const Time t = 0.5*(t1+t2);
 
-            Array v(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
-
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
-                        localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
-                        v[i] = square<Real>()(
-                            localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
+            Array v(x_.size());
+            if (illegalLocalVolOverwrite_ < 0.0) {
+                localVol_->localVols(t, x_, v, true);
+            }
+            else {
+                try {
+                    localVol_->localVols(t, x_, v, true);
+                } catch (Error&) {
+                    for (Size i=0; i < x_.size(); ++i) {
+                        try {
+                            v[i] = localVol_->localVol(t, x_[i], true);
+                        } catch (Error&) {
+                            v[i] = illegalLocalVolOverwrite_;
+                        }
                     }
-
                 }
             }
+            v *= v;
             mapT_.axpyb(r - q - 0.5*v, dxMap_,
                         dxxMap_.mult(0.5*v), Array(1, -r));
         }
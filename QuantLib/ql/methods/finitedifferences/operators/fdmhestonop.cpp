@@ -89,21 +89,26 @@ namespace QuantLib {
         const Real t = 0.5*(t1+t2);
         const Time time = std::min(leverageFct_->maxTime(), t);
 
+        // the leverage depends on the spot only
         const FdmLinearOpIterator endIter = layout->end();
+        Array spots(layout->dim()[0]);
         for (FdmLinearOpIterator iter = layout->begin();
              iter!=endIter; ++iter) {
-            const Size nx = iter.coordinates()[0];
-
             if (iter.coordinates()[1] == 0) {
                 const Real x = std::exp(mesher_->location(iter, 0));
-                const Real spot = std::min(leverageFct_->maxStrike(),
-                                           std::max(leverageFct_->minStrike(), x));
-                v[nx] = std::max(0.01, leverageFct_->localVol(time, spot, true));
-            }
-            else {
-                v[iter.index()] = v[nx];
+                spots[iter.coordinates()[0]]
+                    = std::min(leverageFct_->maxStrike(),
+                               std::max(leverageFct_->minStrike(), x));
             }
         }
+
+        Array l(spots.size());
+        leverageFct_->localVols(time, spots, l, true);
+
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter!=endIter; ++iter) {
+            v[iter.index()] = std::max(0.01, l[iter.coordinates()[0]]);
+        }
         return v;
     }
 
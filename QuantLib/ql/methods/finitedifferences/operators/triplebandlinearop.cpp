@@ -27,6 +27,13 @@
 
 namespace QuantLib {
 
+    namespace {
+        // smallest grid for which solve_splitting opens a parallel
+        // region; below it the cost of starting the threads exceeds
+        // the few microseconds the Thomas sweeps take.
+        const Size minParallelSolveSize = 20000;
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -304,29 +311,56 @@ namespace QuantLib {
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        // The operator does not couple the lines along direction_,
+        // hence each line is an independent tridiagonal system. The
+        // lines are contiguous in the reverse index and are solved
+        // concurrently if OpenMP is enabled and the grid is large.
+        const Size n = layout->dim()[direction_];
+        const long nLines = long(layout->size()/n);
+        const bool parallel =
+            nLines > 1 && layout->size() >= minParallelSolveSize;
+        bool singular = false;
+
+        #pragma omp parallel for if(parallel)
+        for (long l=0; l < nLines; ++l) {
+            const Size* idx = reverseIndex_.get() + l*n;
+            Real* t = tmp.begin() + l*n;
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = idx[0];
+            Real bet = a*dptr[rim1]+b;
+            if (bet == 0.0) {
+                #pragma omp critical
+                singular = true;
+                continue;
+            }
+            bet=1.0/bet;
+            retVal[rim1] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            for (Size j=1; j < n; j++){
+                const Size ri = idx[j];
+                t[j] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[ri]-t[j]*lptr[ri]);
+                if (bet == 0.0)
+                    break;
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            if (bet == 0.0) {
+                #pragma omp critical
+                singular = true;
+                continue;
+            }
+            // cannot be j>=0 with Size j
+            for (Size j=n-1; j>0; --j)
+                retVal[idx[j-1]] -= t[j]*retVal[idx[j]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(!singular, "division by zero");
 
         return retVal;
     }
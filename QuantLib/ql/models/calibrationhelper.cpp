@@ -49,6 +49,50 @@ namespace QuantLib {
         return solver.solve(f,accuracy,volatility_->value(),minVol,maxVol);
     }
 
+    Disposable<Array> CalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+        if (gradient.empty())
+            return gradient;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            gradient *= (marketValue() - modelValue() < 0.0 ? 1.0 : -1.0)
+                        / marketValue();
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real lowerPrice = blackPrice(minVol);
+              const Real upperPrice = blackPrice(maxVol);
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                  // the implied volatility is floored or capped
+                  gradient *= 0.0;
+              } else {
+                  // d(implied vol)/d(model price) = 1/vega
+                  const Volatility implied = this->impliedVolatility(
+                                      modelPrice, 1e-12, 5000, minVol, maxVol);
+                  const Volatility h = 1.0e-4*implied;
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2.0*h);
+                  QL_REQUIRE(vega > 0.0, "non-positive vega (" << vega
+                             << ") at implied volatility " << implied);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
+
     Real CalibrationHelper::calibrationError() {
         Real error;
         
@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
 #include <list>
 
 namespace QuantLib {
@@ -72,6 +73,23 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! gradient of the model value with respect to the model parameters
+        /*! Helpers whose pricing engine can compute analytic derivatives
+            of the price with respect to the model parameters override
+            this method.  An empty array is returned by default, in which
+            case calibrations fall back to finite differences.
+        */
+        virtual Disposable<Array> modelValueGradient() const {
+            Array gradient;
+            return gradient;
+        }
+
+        //! gradient of the calibration error with respect to the model parameters
+        /*! An empty array is returned if modelValueGradient() is not
+            available.
+        */
+        virtual Disposable<Array> calibrationErrorGradient();
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -21,6 +21,7 @@
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -84,6 +85,19 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Disposable<Array> HestonModelHelper::modelValueGradient() const {
+        calculate();
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (!engine) {
+            Array gradient;
+            return gradient;
+        }
+        option_->setupArguments(engine->getArguments());
+        engine->getArguments()->validate();
+        return engine->priceGradient();
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
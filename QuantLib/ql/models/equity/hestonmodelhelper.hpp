@@ -56,6 +56,8 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const {}
         void performCalculations() const;
         Real modelValue() const;
+        //! available when the engine is an AnalyticHestonEngine
+        Disposable<Array> modelValueGradient() const;
         Real blackPrice(Real volatility) const;
         Time maturity() const  { calculate(); return tau_; }
       private:
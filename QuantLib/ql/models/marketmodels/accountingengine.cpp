@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -35,7 +36,40 @@ namespace QuantLib {
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()) {
+      cashFlowsGenerated_(product->numberOfProducts()), batchSize_(0) {
+        initialize();
+    }
+
+    AccountingEngine::AccountingEngine(
+             const std::vector<boost::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue,
+             Size batchSize)
+    : evolver_(evolvers.empty() ? boost::shared_ptr<MarketModelEvolver>()
+                                : evolvers.front()),
+      product_(product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      numerairesHeld_(product->numberOfProducts()),
+      numberCashFlowsThisStep_(product->numberOfProducts()),
+      cashFlowsGenerated_(product->numberOfProducts()),
+      batchSize_(batchSize) {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(batchSize > 0, "null batch size");
+        for (Size i=0; i<evolvers.size(); ++i)
+            QL_REQUIRE(evolvers[i], "null evolver #" << i);
+
+        initialize();
+
+        // each worker gets its own copy of the product
+        workers_.reserve(evolvers.size()-1);
+        for (Size i=1; i<evolvers.size(); ++i)
+            workers_.push_back(boost::shared_ptr<AccountingEngine>(
+                  new AccountingEngine(evolvers[i], product,
+                                       initialNumeraireValue)));
+    }
+
+    void AccountingEngine::initialize() {
         for (Size i=0; i<numberProducts_; ++i)
             cashFlowsGenerated_[i].resize(
                        product_->maxNumberOfCashFlowsPerProductPerStep());
@@ -47,7 +81,6 @@ namespace QuantLib {
         for (Size j=0; j<cashFlowTimes.size(); ++j)
             discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
                                                          rateTimes));
-
     }
 
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
@@ -115,6 +148,11 @@ namespace QuantLib {
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        if (!workers_.empty()) {
+            parallelPathValues(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
@@ -122,4 +160,50 @@ namespace QuantLib {
         }
     }
 
+    void AccountingEngine::parallelPathValues(SequenceStatisticsInc& stats,
+                                              Size numberOfPaths) {
+        const Size nWorkers = workers_.size()+1;
+        std::vector<AccountingEngine*> engines(nWorkers);
+        engines[0] = this;
+        for (Size w=1; w<nWorkers; ++w)
+            engines[w] = workers_[w-1].get();
+
+        std::vector<Size> pathsLeft(nWorkers, numberOfPaths/nWorkers);
+        for (Size w=0; w<numberOfPaths%nWorkers; ++w)
+            ++pathsLeft[w];
+
+        // per-worker buffers, merged in a fixed order after each batch
+        std::vector<std::vector<std::vector<Real> > > values(
+            nWorkers, std::vector<std::vector<Real> >(
+                          batchSize_, std::vector<Real>(numberProducts_)));
+        std::vector<std::vector<Real> > weights(
+                                nWorkers, std::vector<Real>(batchSize_));
+        std::vector<Size> pathsInBatch(nWorkers);
+        std::vector<std::string> failures(nWorkers);
+
+        while (pathsLeft[0] > 0) {
+            for (Size w=0; w<nWorkers; ++w)
+                pathsInBatch[w] = std::min(pathsLeft[w], batchSize_);
+
+            #pragma omp parallel for schedule(static,1)
+            for (long w=0; w<(long)nWorkers; ++w) {
+                try {
+                    for (Size j=0; j<pathsInBatch[w]; ++j)
+                        weights[w][j] =
+                            engines[w]->singlePathValues(values[w][j]);
+                } catch (std::exception& e) {
+                    failures[w] = e.what();
+                }
+            }
+
+            for (Size w=0; w<nWorkers; ++w) {
+                QL_REQUIRE(failures[w].empty(),
+                           "evolver #" << w << ": " << failures[w]);
+                for (Size j=0; j<pathsInBatch[w]; ++j)
+                    stats.add(values[w][j], weights[w][j]);
+                pathsLeft[w] -= pathsInBatch[w];
+            }
+        }
+    }
+
 }
@@ -41,15 +41,39 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! When built from several evolvers, the paths are split among
+        them and simulated in parallel (if OpenMP is enabled); each
+        evolver is driven by its own thread and works on its own copy
+        of the product.
+
+        Given \f$ N \f$ paths and \f$ W \f$ evolvers, the \f$ i \f$-th
+        evolver simulates \f$ N/W \f$ paths, plus one if \f$ i < N
+        \bmod W \f$.  The evolvers must draw from independent random
+        streams: for instance, Sobol generators can be given disjoint
+        blocks of the same sequence by skipping the paths assigned to
+        the previous evolvers, while pseudo-random generators can use
+        different seeds.
+
+        Path values are accumulated in a fixed order, so that the
+        results do not depend on the number of threads actually used.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        AccountingEngine(
+             const std::vector<boost::shared_ptr<MarketModelEvolver> >& evolvers,
+             const Clone<MarketModelMultiProduct>& product,
+             Real initialNumeraireValue,
+             Size batchSize = 1024);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
+        void initialize();
         Real singlePathValues(std::vector<Real>& values);
+        void parallelPathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
@@ -64,6 +88,9 @@ namespace QuantLib {
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
+        // additional engines, one for each evolver but the first
+        std::vector<boost::shared_ptr<AccountingEngine> > workers_;
+        Size batchSize_;
     };
 
 }
@@ -104,6 +104,16 @@ namespace QuantLib {
         }
         */
 
+        SobolRsg skippedSobolRsg(Size dimension,
+                                 unsigned long seed,
+                                 SobolRsg::DirectionIntegers integers,
+                                 Size skippedPaths) {
+            SobolRsg rsg(dimension, seed, integers);
+            if (skippedPaths > 0)
+                rsg.skipTo(static_cast<boost::uint_least32_t>(skippedPaths));
+            return rsg;
+        }
+
     }
 
 
@@ -112,9 +122,11 @@ namespace QuantLib {
                                         Size steps,
                                         Ordering ordering,
                                         unsigned long seed,
-                                        SobolRsg::DirectionIntegers integers)
+                                        SobolRsg::DirectionIntegers integers,
+                                        Size skippedPaths)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
+      generator_(skippedSobolRsg(factors*steps, seed, integers,
+                                 skippedPaths),
                  InverseCumulativeNormal()),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
@@ -213,14 +225,17 @@ namespace QuantLib {
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
                                     SobolBrownianGenerator::Ordering ordering,
                                     unsigned long seed,
-                                    SobolRsg::DirectionIntegers integers)
-    : ordering_(ordering), seed_(seed), integers_(integers) {}
+                                    SobolRsg::DirectionIntegers integers,
+                                    Size skippedPaths)
+    : ordering_(ordering), seed_(seed), integers_(integers),
+      skippedPaths_(skippedPaths) {}
 
     boost::shared_ptr<BrownianGenerator>
     SobolBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return boost::shared_ptr<BrownianGenerator>(
                          new SobolBrownianGenerator(factors, steps, ordering_,
-                                                    seed_, integers_));
+                                                    seed_, integers_,
+                                                    skippedPaths_));
     }
 
 }
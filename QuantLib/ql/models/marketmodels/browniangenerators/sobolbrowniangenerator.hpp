@@ -33,6 +33,10 @@ namespace QuantLib {
     //! Sobol Brownian generator for market-model simulations
     /*! Incremental Brownian generator using a Sobol generator,
         inverse-cumulative Gaussian method, and Brownian bridging.
+
+        The first paths of the sequence can be skipped; this allows
+        to split a single Sobol sequence into disjoint blocks of
+        paths, e.g., to be simulated by different workers.
     */
     class SobolBrownianGenerator : public BrownianGenerator {
       public:
@@ -52,7 +56,8 @@ namespace QuantLib {
                            Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                        = SobolRsg::Jaeckel);
+                                                        = SobolRsg::Jaeckel,
+                           Size skippedPaths = 0);
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
@@ -82,13 +87,15 @@ namespace QuantLib {
                            SobolBrownianGenerator::Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                         = SobolRsg::Jaeckel);
+                                                         = SobolRsg::Jaeckel,
+                           Size skippedPaths = 0);
         boost::shared_ptr<BrownianGenerator> create(Size factors,
                                                     Size steps) const;
       private:
         SobolBrownianGenerator::Ordering ordering_;
         unsigned long seed_;
         SobolRsg::DirectionIntegers integers_;
+        Size skippedPaths_;
     };
 
 }
@@ -29,11 +29,15 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
     namespace {
 
+        // number of inner paths between convergence checks
+        const Size innerBlockSize = 128;
+
         class DecoratedHedge : public CallSpecifiedMultiProduct {
           public:
             explicit DecoratedHedge(const CallSpecifiedMultiProduct& product)
@@ -120,6 +124,51 @@ namespace QuantLib {
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
       initialNumeraireValue_(initialNumeraireValue) {
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+    }
+
+    UpperBoundEngine::UpperBoundEngine(
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                      evolvers,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue)
+    : composite_(MultiProductComposite()),
+      initialNumeraireValue_(initialNumeraireValue) {
+
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(innerEvolvers.size() == evolvers.size(),
+                   "mismatch between number of evolvers (" <<
+                   evolvers.size() << ") and sets of inner evolvers (" <<
+                   innerEvolvers.size() << ")");
+        for (Size i=0; i<evolvers.size(); ++i)
+            QL_REQUIRE(evolvers[i], "null evolver #" << i);
+
+        evolver_ = evolvers.front();
+        innerEvolvers_ = innerEvolvers.front();
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+
+        // each worker gets its own copy of the products and strategy
+        workers_.reserve(evolvers.size()-1);
+        for (Size i=1; i<evolvers.size(); ++i)
+            workers_.push_back(boost::shared_ptr<UpperBoundEngine>(
+                  new UpperBoundEngine(evolvers[i], innerEvolvers[i],
+                                       underlying, rebate,
+                                       hedge, hedgeRebate, hedgeStrategy,
+                                       initialNumeraireValue)));
+    }
+
+    void UpperBoundEngine::initialize(
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy) {
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -169,15 +218,62 @@ namespace QuantLib {
 
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
-                                              Size innerPaths) {
+                                              Size innerPaths,
+                                              Real innerTolerance) {
+        if (!workers_.empty()) {
+            parallelPathValues(stats, outerPaths, innerPaths, innerTolerance);
+            return;
+        }
+
         for (Size i=0; i<outerPaths; ++i) {
-            std::pair<Real,Real> result = singlePathValue(innerPaths);
+            std::pair<Real,Real> result =
+                singlePathValue(innerPaths, innerTolerance);
             stats.add(result.first, result.second);
         }
     }
 
 
-    std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
+    void UpperBoundEngine::parallelPathValues(Statistics& stats,
+                                              Size outerPaths,
+                                              Size innerPaths,
+                                              Real innerTolerance) {
+        const Size nWorkers = workers_.size()+1;
+        std::vector<UpperBoundEngine*> engines(nWorkers);
+        engines[0] = this;
+        for (Size w=1; w<nWorkers; ++w)
+            engines[w] = workers_[w-1].get();
+
+        // each worker simulates a contiguous block of outer paths
+        std::vector<std::vector<std::pair<Real,Real> > > results(nWorkers);
+        for (Size w=0; w<nWorkers; ++w)
+            results[w].resize(outerPaths/nWorkers +
+                              (w < outerPaths%nWorkers ? 1 : 0));
+        std::vector<std::string> failures(nWorkers);
+
+        #pragma omp parallel for schedule(static,1)
+        for (long w=0; w<(long)nWorkers; ++w) {
+            try {
+                for (Size j=0; j<results[w].size(); ++j)
+                    results[w][j] =
+                        engines[w]->singlePathValue(innerPaths,
+                                                    innerTolerance);
+            } catch (std::exception& e) {
+                failures[w] = e.what();
+            }
+        }
+
+        for (Size w=0; w<nWorkers; ++w) {
+            QL_REQUIRE(failures[w].empty(),
+                       "evolver #" << w << ": " << failures[w]);
+            for (Size j=0; j<results[w].size(); ++j)
+                stats.add(results[w][j].first, results[w][j].second);
+        }
+    }
+
+
+    std::pair<Real,Real> UpperBoundEngine::singlePathValue(
+                                                       Size innerPaths,
+                                                       Real innerTolerance) {
 
         DecoratedHedge& callable =
             dynamic_cast<DecoratedHedge&>(composite_.item(4));
@@ -258,7 +354,36 @@ namespace QuantLib {
                                             1.0); // this causes the result
                                                   // to be in numeraire units
                     SequenceStatisticsInc innerStats(callable.numberOfProducts());
-                    engine.multiplePathValues(innerStats, innerPaths);
+                    if (innerTolerance > 0.0) {
+                        // the tolerance is given in cash; the inner
+                        // results are in numeraire units
+                        Real tolerance = innerTolerance
+                            * principalInNumerairePortfolio
+                            / initialNumeraireValue_;
+                        Size pathsDone = 0;
+                        while (pathsDone < innerPaths) {
+                            Size paths = std::min(innerBlockSize,
+                                                  innerPaths-pathsDone);
+                            engine.multiplePathValues(innerStats, paths);
+                            pathsDone += paths;
+                            if (innerStats.samples() > 1) {
+                                // error estimate of the sum of the values
+                                Matrix cov = innerStats.covariance();
+                                Real variance = 0.0;
+                                for (Size r=0; r<cov.rows(); ++r)
+                                    variance += std::accumulate(
+                                        cov.row_begin(r), cov.row_end(r),
+                                        Real(0.0));
+                                Real error = std::sqrt(
+                                    std::max(variance, Real(0.0))
+                                    / innerStats.samples());
+                                if (error <= tolerance)
+                                    break;
+                            }
+                        }
+                    } else {
+                        engine.multiplePathValues(innerStats, innerPaths);
+                    }
 
                     const std::vector<Real>& values = innerStats.mean();
                     unexercisedHedgeValue =
@@ -37,7 +37,14 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! When built from several outer evolvers, each with its own set
+        of inner evolvers, the outer paths are split among them and
+        simulated in parallel (if OpenMP is enabled) as in
+        AccountingEngine.  The results are collected in path order,
+        so that they don't depend on the number of threads; all
+        evolvers must draw from independent random streams.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
@@ -52,11 +59,40 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue);
+        UpperBoundEngine(
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                      evolvers,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue);
+        /*! If a positive inner tolerance is given, each inner
+            simulation is run in blocks of paths and stopped as soon
+            as the error estimate of the unexercised hedge value
+            (in the same units as the results) falls below the
+            tolerance; in this case, innerPaths is the maximum number
+            of inner paths.
+        */
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
-                                Size innerPaths);
-        std::pair<Real,Real> singlePathValue(Size innerPaths);
+                                Size innerPaths,
+                                Real innerTolerance = 0.0);
+        std::pair<Real,Real> singlePathValue(Size innerPaths,
+                                             Real innerTolerance = 0.0);
       private:
+        void initialize(const MarketModelMultiProduct& underlying,
+                        const MarketModelExerciseValue& rebate,
+                        const MarketModelMultiProduct& hedge,
+                        const MarketModelExerciseValue& hedgeRebate,
+                        const ExerciseStrategy<CurveState>& hedgeStrategy);
+        void parallelPathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths,
+                                Real innerTolerance);
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
@@ -78,6 +114,9 @@ namespace QuantLib {
         std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
                                                          cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
+
+        // additional engines, one for each outer evolver but the first
+        std::vector<boost::shared_ptr<UpperBoundEngine> > workers_;
     };
 
 }
@@ -37,7 +37,7 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      e_(pseudo_.columns(), pseudo_.rows(), 0.0),
+      e_(pseudo_.columns(), 0.0),
       downs_(taus.size()), ups_(taus.size()) {
 
         // Check requirements
@@ -128,55 +128,109 @@ namespace QuantLib {
             tmp_[i] = (forwards[i]+displacements_[i]) /
                 (oneOverTaus_[i]+forwards[i]);
 
-        // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
-
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
-        // et impera:
+        // et impera.  Only the running sums e_[r] for the current rate
+        // are needed, so that the inner loops run over contiguous
+        // pseudo-root rows.
 
         // 1st step: the drift corresponding to the numeraire P_N is zero.
         // (if N=0 no drift is null, if N=numberOfRates_ the last drift is null).
         if (numeraire_>0) drifts[numeraire_-1] = 0.0;
 
         // 2nd step: then, move backward from N-2 (included) back to
-        // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
-
+        // alive (included) (if N=0 jumps to 3rd step):
+        std::fill(e_.begin(), e_.end(), 0.0);
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
+            const Real x = tmp_[i+1];
+            Matrix::const_row_iterator p = pseudo_.row_begin(i);
+            Matrix::const_row_iterator q = pseudo_.row_begin(i+1);
+            Real drift = 0.0;
             for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
+                e_[r] += x * q[r];
+                drift -= e_[r]*p[r];
             }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
-            Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
-            Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
-            Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
-            }
-            */
+            drifts[i] = drift;
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
+        std::fill(e_.begin(), e_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            const Real x = tmp_[i];
+            Matrix::const_row_iterator p = pseudo_.row_begin(i);
+            Real drift = 0.0;
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                e_[r] += x * p[r];
+                drift += e_[r]*p[r];
+            }
+            drifts[i] = drift;
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        QL_REQUIRE(forwards.rows() == numberOfRates_,
+                   "forwards has " << forwards.rows() << " rows, "
+                   << numberOfRates_ << " required");
+        QL_REQUIRE(drifts.rows() == numberOfRates_ &&
+                   drifts.columns() == forwards.columns(),
+                   "drifts is " << drifts.rows() << "x" << drifts.columns()
+                   << ", " << numberOfRates_ << "x" << forwards.columns()
+                   << " required");
+
+        // Same algorithm as above, with every scalar replaced by a
+        // row of path values.
+        const Size nPaths = forwards.columns();
+        if (nPaths == 0)
+            return;
+
+        Matrix tmp(numberOfRates_, nPaths), e(numberOfFactors_, nPaths);
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real d = displacements_[i], t = oneOverTaus_[i];
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator x = tmp.row_begin(i);
+            for (Size k=0; k<nPaths; ++k)
+                x[k] = (f[k]+d) / (t+f[k]);
+        }
+
+        // 1st step
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step
+        std::fill(e.begin(), e.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Matrix::const_row_iterator x = tmp.row_begin(i+1);
+            Matrix::row_iterator drift = drifts.row_begin(i);
+            std::fill(drift, drifts.row_end(i), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real p = pseudo_[i][r], q = pseudo_[i+1][r];
+                Matrix::row_iterator er = e.row_begin(r);
+                for (Size k=0; k<nPaths; ++k) {
+                    er[k] += x[k] * q;
+                    drift[k] -= er[k]*p;
+                }
+            }
+        }
+
+        // 3rd step
+        std::fill(e.begin(), e.end(), 0.0);
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
+            Matrix::const_row_iterator x = tmp.row_begin(i);
+            Matrix::row_iterator drift = drifts.row_begin(i);
+            std::fill(drift, drifts.row_end(i), 0.0);
             for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+                const Real p = pseudo_[i][r];
+                Matrix::row_iterator er = e.row_begin(r);
+                for (Size k=0; k<nPaths; ++k) {
+                    er[k] += x[k] * p;
+                    drift[k] += er[k]*p;
+                }
             }
         }
     }
@@ -63,6 +63,13 @@ namespace QuantLib {
                             std::vector<Real>& drifts) const;
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
+        /*! Computes the reduced-factor drifts for a batch of paths.
+            Both matrices are stored path-major, i.e., with one row
+            per rate and one column per path, so that the innermost
+            loop runs over contiguous paths and can be vectorized.
+            Rows below the first alive rate are left untouched. */
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
 
       private:
         Size numberOfRates_, numberOfFactors_;
@@ -73,7 +80,8 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
-        mutable Matrix e_;
+        // running sums over rates, one for each factor
+        mutable std::vector<Real> e_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -30,6 +30,7 @@ namespace QuantLib {
     class BrownianGenerator;
     class BrownianGeneratorFactory;
     class LMMDriftCalculator;
+    class Matrix;
 
     //! Euler
     class LogNormalFwdRateEuler : public MarketModelEvolver {
@@ -58,6 +59,7 @@ namespace QuantLib {
 
       private:
         void setForwards(const std::vector<Real>& forwards);
+        void correlate(const Matrix& A, Size alive);
         // inputs
         boost::shared_ptr<MarketModel> marketModel_;
         std::vector<Size> numeraires_;
@@ -119,11 +119,10 @@ namespace QuantLib {
         const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
 
         Size i, alive = alive_[currentStep_];
+        correlate(A, alive);
         for (i=alive; i<numberOfRates_; ++i) {
             logForwards_[i] += drifts1_[i] + fixedDrift[i];
-            logForwards_[i] +=
-                std::inner_product(A.row_begin(i), A.row_end(i),
-                                   brownians_.begin(), 0.0);
+            logForwards_[i] += correlatedBrownians_[i];
             forwards_[i] = std::exp(logForwards_[i]) - displacements_[i];
         }
 
@@ -144,6 +143,20 @@ namespace QuantLib {
         return weight;
     }
 
+    void LogNormalFwdRatePc::correlate(const Matrix& A, Size alive) {
+        // diffusion terms for all alive rates; this is kept apart
+        // from the exponentials so that the compiler can vectorize
+        // the loop over factors.
+        const Real* z = &brownians_[0];
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator a = A.row_begin(i);
+            Real sum = 0.0;
+            for (Size r=0; r<numberOfFactors_; ++r)
+                sum += a[r]*z[r];
+            correlatedBrownians_[i] = sum;
+        }
+    }
+
     Size LogNormalFwdRatePc::currentStep() const {
         return currentStep_;
     }
@@ -49,6 +49,7 @@ namespace QuantLib {
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
+        void correlate(const Matrix& A, Size alive);
         // inputs
         boost::shared_ptr<MarketModel> marketModel_;
         std::vector<Size> numeraires_;
@@ -0,0 +1,198 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRatePcBatch::LogNormalFwdRatePcBatch(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size batchSize,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep), batchSize_(batchSize),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_),
+      forwards_(numberOfRates_, batchSize),
+      logForwards_(numberOfRates_, batchSize),
+      drifts1_(numberOfRates_, batchSize),
+      drifts2_(numberOfRates_, batchSize),
+      weights_(batchSize), diffusion_(batchSize),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(batchSize > 0, "null batch size");
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        generator_ = factory.create(numberOfFactors_, steps-initialStep_);
+
+        currentStep_ = initialStep_;
+
+        brownians_.resize(steps-initialStep_,
+                          Matrix(numberOfFactors_, batchSize_));
+        stepWeights_.resize(steps-initialStep_,
+                            std::vector<Real>(batchSize_));
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& LogNormalFwdRatePcBatch::numeraires() const {
+        return numeraires_;
+    }
+
+    Size LogNormalFwdRatePcBatch::batchSize() const {
+        return batchSize_;
+    }
+
+    void LogNormalFwdRatePcBatch::setForwards(
+                                        const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        initialForwards_ = forwards;
+        for (Size i=0; i<numberOfRates_; ++i)
+            initialLogForwards_[i] = std::log(forwards[i] +
+                                              displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void LogNormalFwdRatePcBatch::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    const std::vector<Real>& LogNormalFwdRatePcBatch::startNewBatch() {
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialForwards_[i]);
+        }
+
+        // the generator returns the Brownians path by path; they are
+        // stored transposed so that each step reads them by factor
+        std::vector<Real> z(numberOfFactors_);
+        for (Size k=0; k<batchSize_; ++k) {
+            weights_[k] = generator_->nextPath();
+            for (Size s=0; s<brownians_.size(); ++s) {
+                stepWeights_[s][k] = generator_->nextStep(z);
+                for (Size r=0; r<numberOfFactors_; ++r)
+                    brownians_[s][r][k] = z[r];
+            }
+        }
+        return weights_;
+    }
+
+    const std::vector<Real>& LogNormalFwdRatePcBatch::advanceStep() {
+        // we're going from T1 to T2
+
+        // a) compute drifts D1 at T1;
+        Size i, alive = alive_[currentStep_];
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].computeReduced(forwards_, drifts1_);
+        } else {
+            for (i=alive; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& z = brownians_[currentStep_-initialStep_];
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        Real* c = &diffusion_[0];
+        for (i=alive; i<numberOfRates_; ++i) {
+            std::fill(diffusion_.begin(), diffusion_.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                Matrix::const_row_iterator zr = z.row_begin(r);
+                for (Size k=0; k<batchSize_; ++k)
+                    c[k] += a*zr[k];
+            }
+            Matrix::row_iterator x = logForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = drifts1_.row_begin(i);
+            for (Size k=0; k<batchSize_; ++k) {
+                x[k] += d1[k] + fixedDrift[i];
+                x[k] += c[k];
+            }
+        }
+        setOnForwards(alive);
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].computeReduced(forwards_, drifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Matrix::row_iterator x = logForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = drifts1_.row_begin(i);
+            Matrix::const_row_iterator d2 = drifts2_.row_begin(i);
+            for (Size k=0; k<batchSize_; ++k)
+                x[k] += (d2[k]-d1[k])/2.0;
+        }
+        setOnForwards(alive);
+
+        return stepWeights_[currentStep_++ - initialStep_];
+    }
+
+    void LogNormalFwdRatePcBatch::setOnForwards(Size alive) {
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            const Real displacement = displacements_[i];
+            Matrix::const_row_iterator x = logForwards_.row_begin(i);
+            Matrix::row_iterator f = forwards_.row_begin(i);
+            for (Size k=0; k<batchSize_; ++k)
+                f[k] = std::exp(x[k]) - displacement;
+        }
+    }
+
+    Size LogNormalFwdRatePcBatch::currentStep() const {
+        return currentStep_;
+    }
+
+    const Matrix& LogNormalFwdRatePcBatch::currentForwards() const {
+        return forwards_;
+    }
+
+}
@@ -0,0 +1,97 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lognormalfwdratepcbatch.hpp
+    \brief predictor-corrector evolving a batch of paths at once
+*/
+
+#ifndef quantlib_forward_rate_pc_batch_evolver_hpp
+#define quantlib_forward_rate_pc_batch_evolver_hpp
+
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class CurveState;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector evolving a batch of paths at once
+    /*! This evolver applies the scheme of LogNormalFwdRatePc to a
+        number of paths at the same time. Forwards, drifts and
+        Brownian increments are stored path-major, i.e., with one row
+        per rate (or factor) and one column per path, so that the
+        pseudo-root times Brownian product, the drift computation and
+        the forward update run their innermost loops over contiguous
+        paths and can be vectorized by the compiler.
+
+        The paths of a batch are drawn one after the other from the
+        Brownian generator; therefore, they are the same paths that
+        LogNormalFwdRatePc would evolve with the same generator.
+
+        \note Unlike the other evolvers, this class doesn't implement
+              the MarketModelEvolver interface, which advances a
+              single path; the forwards of the whole batch are
+              returned as a matrix instead of a curve state.
+    */
+    class LogNormalFwdRatePcBatch {
+      public:
+        LogNormalFwdRatePcBatch(const boost::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size batchSize,
+                                Size initialStep = 0);
+        const std::vector<Size>& numeraires() const;
+        Size batchSize() const;
+        //! draws the next batch of paths and returns their weights
+        const std::vector<Real>& startNewBatch();
+        //! evolves all paths and returns the weights of the step
+        const std::vector<Real>& advanceStep();
+        Size currentStep() const;
+        //! forwards of the batch, one row per rate and one column per path
+        const Matrix& currentForwards() const;
+        void setInitialState(const CurveState&);
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        void setOnForwards(Size alive);
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_, batchSize_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialForwards_;
+        std::vector<Real> initialLogForwards_, initialDrifts_;
+        Matrix forwards_, logForwards_, drifts1_, drifts2_;
+        // Brownians of the batch, one factors x paths matrix per step
+        std::vector<Matrix> brownians_;
+        std::vector<Real> weights_, diffusion_;
+        std::vector<std::vector<Real> > stepWeights_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
@@ -24,6 +24,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -38,9 +39,46 @@ namespace QuantLib {
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
         cashFlowsGenerated_(product->numberOfProducts()) ,
-        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
+        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1),
+        batchSize_(0)
     {
+        initialize();
+    }
 
+    PathwiseAccountingEngine::PathwiseAccountingEngine(const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+        Real initialNumeraireValue,
+        Size batchSize)
+        : evolver_(evolvers.empty() ? boost::shared_ptr<LogNormalFwdRateEuler>() : evolvers.front()),
+        product_(product),pseudoRootStructure_(pseudoRootStructure),
+        initialNumeraireValue_(initialNumeraireValue),
+        numberProducts_(product->numberOfProducts()),
+        doDeflation_(!product->alreadyDeflated()),
+        numerairesHeld_(product->numberOfProducts()),
+        numberCashFlowsThisStep_(product->numberOfProducts()),
+        cashFlowsGenerated_(product->numberOfProducts()) ,
+        deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1),
+        batchSize_(batchSize)
+    {
+        QL_REQUIRE(!evolvers.empty(), "no evolvers given");
+        QL_REQUIRE(batchSize > 0, "null batch size");
+        for (Size i=0; i<evolvers.size(); ++i)
+            QL_REQUIRE(evolvers[i], "null evolver #" << i);
+
+        initialize();
+
+        // each worker gets its own copy of the product
+        workers_.reserve(evolvers.size()-1);
+        for (Size i=1; i<evolvers.size(); ++i)
+            workers_.push_back(boost::shared_ptr<PathwiseAccountingEngine>(
+                  new PathwiseAccountingEngine(evolvers[i], product,
+                                               pseudoRootStructure,
+                                               initialNumeraireValue)));
+    }
+
+    void PathwiseAccountingEngine::initialize()
+    {
         numberRates_ = pseudoRootStructure_->numberOfRates();
         numberSteps_ = pseudoRootStructure_->numberOfSteps();
 
@@ -312,6 +350,12 @@ namespace QuantLib {
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
+        if (!workers_.empty())
+        {
+            parallelPathValues(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -320,6 +364,57 @@ namespace QuantLib {
         }
     }
 
+    void PathwiseAccountingEngine::parallelPathValues(SequenceStatisticsInc& stats,
+        Size numberOfPaths)
+    {
+        const Size nWorkers = workers_.size()+1;
+        std::vector<PathwiseAccountingEngine*> engines(nWorkers);
+        engines[0] = this;
+        for (Size w=1; w<nWorkers; ++w)
+            engines[w] = workers_[w-1].get();
+
+        std::vector<Size> pathsLeft(nWorkers, numberOfPaths/nWorkers);
+        for (Size w=0; w<numberOfPaths%nWorkers; ++w)
+            ++pathsLeft[w];
+
+        // per-worker buffers, merged in a fixed order after each batch
+        const Size numberOfValues = numberProducts_*(numberRates_+1);
+        std::vector<std::vector<std::vector<Real> > > values(
+            nWorkers, std::vector<std::vector<Real> >(
+                          batchSize_, std::vector<Real>(numberOfValues)));
+        std::vector<std::vector<Real> > weights(
+                                nWorkers, std::vector<Real>(batchSize_));
+        std::vector<Size> pathsInBatch(nWorkers);
+        std::vector<std::string> failures(nWorkers);
+
+        while (pathsLeft[0] > 0)
+        {
+            for (Size w=0; w<nWorkers; ++w)
+                pathsInBatch[w] = std::min(pathsLeft[w], batchSize_);
+
+            #pragma omp parallel for schedule(static,1)
+            for (long w=0; w<(long)nWorkers; ++w)
+            {
+                try {
+                    for (Size j=0; j<pathsInBatch[w]; ++j)
+                        weights[w][j] =
+                            engines[w]->singlePathValues(values[w][j]);
+                } catch (std::exception& e) {
+                    failures[w] = e.what();
+                }
+            }
+
+            for (Size w=0; w<nWorkers; ++w)
+            {
+                QL_REQUIRE(failures[w].empty(),
+                           "evolver #" << w << ": " << failures[w]);
+                for (Size j=0; j<pathsInBatch[w]; ++j)
+                    stats.add(values[w][j], weights[w][j]);
+                pathsLeft[w] -= pathsInBatch[w];
+            }
+        }
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
  
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
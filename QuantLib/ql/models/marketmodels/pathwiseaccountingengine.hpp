@@ -41,6 +41,8 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // When given several evolvers, the paths are split among them and simulated in parallel
+    // (if OpenMP is enabled) in the same way as in AccountingEngine
     class PathwiseAccountingEngine 
     {
       public:
@@ -49,10 +51,19 @@ namespace QuantLib {
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          Real initialNumeraireValue);
 
+        PathwiseAccountingEngine(const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers, // one for each worker
+                         const Clone<MarketModelPathwiseMultiProduct>& product,
+                         const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+                         Real initialNumeraireValue,
+                         Size batchSize = 1024);
+
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
+          void initialize();
           Real singlePathValues(std::vector<Real>& values);
+          void parallelPathValues(SequenceStatisticsInc& stats,
+                                  Size numberOfPaths);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -95,6 +106,9 @@ namespace QuantLib {
 
         std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
 
+        // additional engines, one for each evolver but the first
+        std::vector<boost::shared_ptr<PathwiseAccountingEngine> > workers_;
+        Size batchSize_;
     };
 
 
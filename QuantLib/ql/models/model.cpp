@@ -24,6 +24,7 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/stopwatch.hpp>
 
 using std::vector;
 using boost::shared_ptr;
@@ -33,46 +34,118 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None), parallel_(false),
+      calibrationTime_(0.0) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
         CalibrationFunction(CalibratedModel* model,
                             const vector<shared_ptr<CalibrationHelper> >& h,
                             const vector<Real>& weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            bool recordTimes = false)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) { }
+              weights_(weights), projection_(projection),
+              recordTimes_(recordTimes) { }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            Array diffs = errors(params);
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
+                value += diffs[i]*diffs[i]*weights_[i];
             }
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
-            model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = errors(params);
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            model_->setParams(projection_.include(params));
+            const Size n = instruments_.size();
+            std::vector<Array> gradients(n);
+            if (model_->parallel_ && n > 1) {
+                for (Size i=0; i<n; i++)
+                    instruments_[i]->marketValue();
+                std::vector<std::string> failures(n);
+                #pragma omp parallel for
+                for (long i=0; i<(long)n; i++) {
+                    try {
+                        gradients[i] =
+                            instruments_[i]->calibrationErrorGradient();
+                    } catch (std::exception& e) {
+                        failures[i] = e.what();
+                    }
+                }
+                for (Size i=0; i<n; i++)
+                    QL_REQUIRE(failures[i].empty(),
+                               "calibration helper #" << i << ": "
+                               << failures[i]);
+            } else {
+                for (Size i=0; i<n; i++)
+                    gradients[i] = instruments_[i]->calibrationErrorGradient();
+            }
+            for (Size i=0; i<n; i++) {
+                if (gradients[i].empty()) {
+                    // no analytic derivatives for this helper
+                    CostFunction::jacobian(jac, params);
+                    return;
+                }
+                const Array g = projection_.project(gradients[i]);
+                const Real w = std::sqrt(weights_[i]);
+                for (Size j=0; j<g.size(); j++)
+                    jac[i][j] = g[j]*w;
+            }
+        }
+
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> errors(const Array& params) const {
+            StopWatch watch;
+            model_->setParams(projection_.include(params));
+            const Size n = instruments_.size();
+            Array errors(n);
+            if (model_->parallel_ && n > 1) {
+                // a lazy object is not thread safe; we trigger the
+                // helpers' calculations here so that only the model
+                // values are computed in the parallelized loop below.
+                for (Size i=0; i<n; i++)
+                    instruments_[i]->marketValue();
+                std::vector<std::string> failures(n);
+                #pragma omp parallel for
+                for (long i=0; i<(long)n; i++) {
+                    try {
+                        errors[i] = instruments_[i]->calibrationError();
+                    } catch (std::exception& e) {
+                        failures[i] = e.what();
+                    }
+                }
+                for (Size i=0; i<n; i++)
+                    QL_REQUIRE(failures[i].empty(),
+                               "calibration helper #" << i << ": "
+                               << failures[i]);
+            } else {
+                for (Size i=0; i<n; i++)
+                    errors[i] = instruments_[i]->calibrationError();
+            }
+            if (recordTimes_)
+                model_->evaluationTimes_.push_back(watch.elapsed());
+            return errors;
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        bool recordTimes_;
     };
 
     void CalibratedModel::calibrate(
@@ -96,10 +169,13 @@ namespace QuantLib {
         vector<Real> w =
             weights.empty() ? vector<Real>(instruments.size(), 1.0): weights;
 
+        StopWatch watch;
+        evaluationTimes_.clear();
+
         Array prms = params();
         vector<bool> all(prms.size(), false);
         Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,true);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -107,6 +183,7 @@ namespace QuantLib {
         setParams(proj.include(result));
         problemValues_ = prob.values(result);
         functionEvaluation_ = prob.functionEvaluation();
+        calibrationTime_ = watch.elapsed();
 
         notifyObservers();
     }
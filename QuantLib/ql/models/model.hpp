@@ -95,6 +95,13 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If the optimization method uses the cost function's
+            jacobian (e.g. LevenbergMarquardt with
+            useCostFunctionsJacobian set to true) and all helpers
+            provide analytic gradients through
+            CalibrationHelper::modelValueGradient, those are used;
+            otherwise the jacobian is computed by finite differences.
         */
         virtual void calibrate(
                 const std::vector<boost::shared_ptr<CalibrationHelper> >&,
@@ -121,6 +128,37 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        /*! \name Parallel calibration
+
+            When enabled and the library is compiled with OpenMP
+            support, the calibration errors of the helpers are
+            evaluated concurrently inside each cost-function call;
+            this also applies to the calls made by the optimizer
+            while building finite-difference Jacobians.  The errors
+            are summed in the original order, so the cost-function
+            values are the same as in the serial case.
+
+            \warning each helper must be given its own pricing-engine
+                     instance and the model and engines must support
+                     concurrent read access once the helpers have
+                     been calculated.  Lazy objects are triggered
+                     before the parallel section, but term structures
+                     or engines that cache results on the fly are not
+                     protected.
+        */
+        //@{
+        void enableParallelCalibration(bool b = true) { parallel_ = b; }
+        void disableParallelCalibration(bool b = true) { parallel_ = !b; }
+        bool allowsParallelCalibration() const { return parallel_; }
+        //! wall-clock time (in seconds) of each cost-function evaluation
+        //! during the last calibration
+        const std::vector<Real>& evaluationTimes() const {
+            return evaluationTimes_;
+        }
+        //! wall-clock time (in seconds) of the last calibration
+        Real calibrationTime() const { return calibrationTime_; }
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -130,6 +168,9 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        bool parallel_;
+        std::vector<Real> evaluationTimes_;
+        Real calibrationTime_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -22,6 +22,7 @@
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/blackswaptionengine.hpp>
 #include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -113,6 +114,19 @@ namespace QuantLib {
         return swaption_->NPV();
     }
 
+    Disposable<Array> SwaptionHelper::modelValueGradient() const {
+        calculate();
+        boost::shared_ptr<JamshidianSwaptionEngine> engine =
+            boost::dynamic_pointer_cast<JamshidianSwaptionEngine>(engine_);
+        if (!engine) {
+            Array gradient;
+            return gradient;
+        }
+        swaption_->setupArguments(engine->getArguments());
+        engine->getArguments()->validate();
+        return engine->priceGradient();
+    }
+
     Real SwaptionHelper::blackPrice(Volatility sigma) const {
         calculate();
         Handle<Quote> vol(boost::shared_ptr<Quote>(new SimpleQuote(sigma)));
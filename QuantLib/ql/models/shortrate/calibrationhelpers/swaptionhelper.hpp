@@ -82,6 +82,8 @@ namespace QuantLib {
 
         virtual void addTimesTo(std::list<Time>& times) const;
         virtual Real modelValue() const;
+        //! available when the engine is a JamshidianSwaptionEngine
+        virtual Disposable<Array> modelValueGradient() const;
         virtual Real blackPrice(Volatility volatility) const;
 
         boost::shared_ptr<VanillaSwap> underlyingSwap() const { calculate(); return swap_; }
@@ -282,4 +282,152 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     return result;
 }
+
+Gaussian1dModel::StateGrid &
+Gaussian1dModel::stateGrid(const Time t, const Real yStdDevs,
+                           const int gridPoints) const {
+
+    StateGridKey key = {t, yStdDevs, gridPoints};
+    std::map<StateGridKey, StateGrid>::iterator i = stateGrids_.find(key);
+    if (i != stateGrids_.end())
+        return i->second;
+
+    // keep the cache bounded when many different times are used
+    if (stateGrids_.size() >= 1000)
+        stateGrids_.clear();
+
+    return stateGrids_[key];
+}
+
+void Gaussian1dModel::flushStateGrids() const {
+    #pragma omp critical(ql_gaussian1d_state_grids)
+    stateGrids_.clear();
+}
+
+const Disposable<Matrix> Gaussian1dModel::zerobondGrid(
+    const std::vector<Time> &T, const Time t, const Real yStdDevs,
+    const int gridPoints, const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    Matrix result(2 * gridPoints + 1, T.size());
+
+    if (!yts.empty()) {
+        Array y = yGrid(yStdDevs, gridPoints);
+        for (Size j = 0; j < T.size(); j++) {
+            for (Size i = 0; i < y.size(); i++)
+                result[i][j] = zerobond(T[j], t, y[i], yts);
+        }
+        return result;
+    }
+
+    // Missing values are computed outside of the critical section and
+    // stored afterwards; two threads may compute the same values, which
+    // is harmless.
+    Array y = yGrid(yStdDevs, gridPoints);
+    for (Size j = 0; j < T.size(); j++) {
+        Array p;
+        #pragma omp critical(ql_gaussian1d_state_grids)
+        p = stateGrid(t, yStdDevs, gridPoints).zerobonds[T[j]];
+        if (p.empty()) {
+            p = Array(y.size());
+            for (Size i = 0; i < y.size(); i++)
+                p[i] = zerobond(T[j], t, y[i]);
+            #pragma omp critical(ql_gaussian1d_state_grids)
+            stateGrid(t, yStdDevs, gridPoints).zerobonds[T[j]] = p;
+        }
+        for (Size i = 0; i < p.size(); i++)
+            result[i][j] = p[i];
+    }
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::numeraireGrid(const Time t, const Real yStdDevs,
+                               const int gridPoints,
+                               const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    if (!yts.empty()) {
+        Array y = yGrid(yStdDevs, gridPoints);
+        Array result(y.size());
+        for (Size i = 0; i < y.size(); i++)
+            result[i] = numeraire(t, y[i], yts);
+        return result;
+    }
+
+    Array result;
+    #pragma omp critical(ql_gaussian1d_state_grids)
+    result = stateGrid(t, yStdDevs, gridPoints).numeraire;
+    if (result.empty()) {
+        Array y = yGrid(yStdDevs, gridPoints);
+        result = Array(y.size());
+        for (Size i = 0; i < y.size(); i++)
+            result[i] = numeraire(t, y[i]);
+        #pragma omp critical(ql_gaussian1d_state_grids)
+        stateGrid(t, yStdDevs, gridPoints).numeraire = result;
+    }
+    return result;
+}
+
+const Disposable<Array> Gaussian1dModel::forwardRateGrid(
+    const Date &fixing, const Date &referenceDate, const Real yStdDevs,
+    const int gridPoints, boost::shared_ptr<IborIndex> iborIdx) const {
+
+    QL_REQUIRE(iborIdx != NULL, "no ibor index given");
+    QL_REQUIRE(referenceDate != Null<Date>(), "no reference date given");
+
+    calculate();
+
+    if (fixing <= (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1))) {
+        Array result(2 * gridPoints + 1, iborIdx->fixing(fixing));
+        return result;
+    }
+
+    Handle<YieldTermStructure> yts =
+        iborIdx->forwardingTermStructure(); // might be empty, then use
+                                            // model curve
+
+    // same dates as in forwardRate
+    Date valueDate = iborIdx->valueDate(fixing);
+    Date endDate = iborIdx->fixingCalendar().advance(
+        valueDate, iborIdx->tenor(), iborIdx->businessDayConvention(),
+        iborIdx->endOfMonth());
+    Real dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
+
+    std::vector<Time> T(2);
+    T[0] = termStructure()->timeFromReference(valueDate);
+    T[1] = termStructure()->timeFromReference(endDate);
+    Matrix p = zerobondGrid(T, termStructure()->timeFromReference(referenceDate),
+                            yStdDevs, gridPoints, yts);
+
+    Array result(p.rows());
+    for (Size i = 0; i < p.rows(); i++)
+        result[i] = (p[i][0] - p[i][1]) / (dcf * p[i][1]);
+    return result;
+}
+
+const Disposable<Matrix> Gaussian1dModel::yGrids(const Real yStdDevs,
+                                                 const int gridPoints,
+                                                 const Time T,
+                                                 const Time t) const {
+
+    calculate();
+
+    Matrix result;
+    #pragma omp critical(ql_gaussian1d_state_grids)
+    result = stateGrid(t, yStdDevs, gridPoints).yGrids[T];
+    if (result.empty()) {
+        Array y = yGrid(yStdDevs, gridPoints);
+        result = Matrix(y.size(), y.size());
+        for (Size i = 0; i < y.size(); i++) {
+            Array yg = yGrid(yStdDevs, gridPoints, T, t, y[i]);
+            std::copy(yg.begin(), yg.end(), result.row_begin(i));
+        }
+        #pragma omp critical(ql_gaussian1d_state_grids)
+        stateGrid(t, yStdDevs, gridPoints).yGrids[T] = result;
+    }
+    return result;
+}
 }
@@ -38,6 +38,8 @@
 #include <ql/stochasticprocess.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <map>
 
 #ifdef GAUSS1D_ENABLE_NTL
 #include <boost/math/bindings/rr.hpp>
@@ -148,6 +150,41 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                                   const Real T = 1.0, const Real t = 0,
                                   const Real y = 0) const;
 
+    /*! The methods below evaluate the model on the standardized grid
+        yGrid(yStdDevs, gridPoints) at time t, with one value (or one
+        row) per grid point; they return the same values as the
+        pointwise methods above.
+
+        The results for the model curve (i.e. an empty yts, or an ibor
+        index without forwarding curve) are cached per time and grid
+        and shared by all engines pricing on the model, until it is
+        recalculated or its parameters change.  The cache is guarded
+        by a critical section, so that engines pricing concurrently on
+        the same model can share it; engines rolling back on the grid
+        should still get these before entering parallel loops.
+    */
+
+    //! zero bonds \f$ P(t,T_j) \f$, one column per maturity \f$ T_j \f$
+    const Disposable<Matrix> zerobondGrid(
+        const std::vector<Time> &T, const Time t, const Real yStdDevs,
+        const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    const Disposable<Array> numeraireGrid(
+        const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    //! forward rates seen from the (non-null) reference date
+    const Disposable<Array> forwardRateGrid(
+        const Date &fixing, const Date &referenceDate, const Real yStdDevs,
+        const int gridPoints,
+        boost::shared_ptr<IborIndex> iborIdx = boost::shared_ptr<IborIndex>()) const;
+
+    /*! grids at time T conditional on the state at t, i.e. row i is
+        yGrid(yStdDevs, gridPoints, T, t, y_i) */
+    const Disposable<Matrix> yGrids(const Real yStdDevs, const int gridPoints,
+                                    const Time T, const Time t) const;
+
   private:
     // It is of great importance for performance reasons to cache underlying
     // swaps generated from indexes. In addition the indexes may only be given
@@ -181,6 +218,33 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // model quantities on the state grid at a given time; the maps are
+    // keyed by maturity and by the time of the conditional grids
+    struct StateGridKey {
+        Time t;
+        Real yStdDevs;
+        int gridPoints;
+        bool operator<(const StateGridKey &o) const {
+            if (t != o.t)
+                return t < o.t;
+            if (yStdDevs != o.yStdDevs)
+                return yStdDevs < o.yStdDevs;
+            return gridPoints < o.gridPoints;
+        }
+    };
+
+    struct StateGrid {
+        Array numeraire;
+        std::map<Time, Array> zerobonds;
+        std::map<Time, Matrix> yGrids;
+    };
+
+    // to be called within the ql_gaussian1d_state_grids critical section
+    StateGrid &stateGrid(const Time t, const Real yStdDevs,
+                         const int gridPoints) const;
+
+    mutable std::map<StateGridKey, StateGrid> stateGrids_;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -201,13 +265,19 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        flushStateGrids();
     }
 
     void generateArguments() {
         calculate();
+        flushStateGrids();
         notifyObservers();
     }
 
+    // to be called by derived classes whenever the model changes
+    // without being recalculated, e.g. in generateArguments
+    void flushStateGrids() const;
+
     // retrieve underlying swap from cache if possible, otherwise
     // create it and store it in the cache
     boost::shared_ptr<VanillaSwap>
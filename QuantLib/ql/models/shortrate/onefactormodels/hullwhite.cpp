@@ -130,6 +130,49 @@ namespace QuantLib {
         return blackFormula(type, k, f, v);
     }
 
+    Disposable<Array> HullWhite::discountBondOptionGradient(
+                                       Option::Type, Real strike,
+                                       Time maturity, Time bondStart,
+                                       Time bondMaturity) const {
+
+        Real _a = a();
+        Real v, dv_da, v_sigma;
+        if (_a < std::sqrt(QL_EPSILON)) {
+            v_sigma = B(bondStart, bondMaturity)* std::sqrt(maturity);
+            // B does not depend on a in this regime
+            dv_da = 0.0;
+        } else {
+            Real e1 = exp(-2.0*_a*(bondStart-maturity));
+            Real e2 = exp(-2.0*_a*bondStart);
+            Real e3 = exp(-_a*(bondStart+bondMaturity-2.0*maturity));
+            Real e4 = exp(-_a*(bondStart+bondMaturity));
+            Real e5 = exp(-2.0*_a*(bondMaturity-maturity));
+            Real e6 = exp(-2.0*_a*bondMaturity);
+            Real c = e1 - e2 - 2.0*(e3 - e4) + e5 - e6;
+            Real dc_da = -2.0*(bondStart-maturity)*e1 + 2.0*bondStart*e2
+                + 2.0*((bondStart+bondMaturity-2.0*maturity)*e3
+                       - (bondStart+bondMaturity)*e4)
+                - 2.0*(bondMaturity-maturity)*e5 + 2.0*bondMaturity*e6;
+            Real u = sqrt(std::max(c, 0.0));
+            v_sigma = u/(_a*sqrt(2.0*_a));
+            dv_da = c > 0.0 ?
+                sigma()/sqrt(2.0)*(-1.5*std::pow(_a, -2.5)*u
+                                   + std::pow(_a, -1.5)*dc_da/(2.0*u)) :
+                0.0;
+        }
+        v = sigma()*v_sigma;
+        Real f = termStructure()->discount(bondMaturity);
+        Real k = termStructure()->discount(bondStart)*strike;
+
+        // call and put share the same vega
+        Real vega = blackFormulaStdDevDerivative(k, f, v);
+
+        Array gradient(2);
+        gradient[0] = vega*dv_da;
+        gradient[1] = vega*v_sigma;
+        return gradient;
+    }
+
     Rate HullWhite::convexityBias(Real futuresPrice,
                                   Time t,
                                   Time T,
@@ -348,6 +348,7 @@ namespace QuantLib {
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            flushStateGrids();
             notifyObservers();
         }
 
@@ -129,6 +129,8 @@ namespace QuantLib {
         void registerWithObservables(const boost::shared_ptr<Observer>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! the observables this instance is registered with
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -292,6 +294,8 @@ namespace QuantLib {
         void registerWithObservables(const boost::shared_ptr<Observer>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! the observables this instance is registered with
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -765,4 +765,366 @@ namespace QuantLib {
     }
 
 
+    Disposable<Array> blackFormula(Option::Type optionType,
+                                   const Array& strikes,
+                                   Real forward,
+                                   const Array& stdDevs,
+                                   Real discount,
+                                   Real displacement) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Real f = forward + displacement;
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            const Real k = strikes[i] + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            if (stdDev==0.0) {
+                result[i] = std::max((forward-strikes[i])*optionType,
+                                     Real(0.0))*discount;
+            } else if (k==0.0) {
+                result[i] = (optionType==Option::Call ? f*discount : 0.0);
+            } else {
+                const Real d1 = std::log(f/k)/stdDev + 0.5*stdDev;
+                const Real d2 = d1 - stdDev;
+                result[i] = discount * optionType
+                    * (f*phi(optionType*d1) - k*phi(optionType*d2));
+                QL_ENSURE(result[i]>=0.0,
+                          "negative value (" << result[i] << ") for " <<
+                          stdDev << " stdDev, " <<
+                          optionType << " option, " <<
+                          strikes[i] << " strike , " <<
+                          forward << " forward");
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> blackFormulaStdDevDerivative(const Array& strikes,
+                                                   Real forward,
+                                                   const Array& stdDevs,
+                                                   Real discount,
+                                                   Real displacement) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Real f = forward + displacement;
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            const Real k = strikes[i] + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            if (stdDev==0.0 || k==0.0) {
+                result[i] = 0.0;
+            } else {
+                const Real d1 = std::log(f/k)/stdDev + .5*stdDev;
+                result[i] = discount * f * phi.derivative(d1);
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> blackFormulaForwardDerivative(Option::Type optionType,
+                                                    const Array& strikes,
+                                                    Real forward,
+                                                    const Array& stdDevs,
+                                                    Real discount,
+                                                    Real displacement) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Real f = forward + displacement;
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            const Real k = strikes[i] + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            if (stdDev==0.0) {
+                result[i] = (forward*optionType > strikes[i]*optionType
+                             ? discount*optionType : 0.0);
+            } else if (k==0.0) {
+                result[i] = (optionType==Option::Call ? discount : 0.0);
+            } else {
+                const Real d1 = std::log(f/k)/stdDev + 0.5*stdDev;
+                result[i] = discount * optionType * phi(optionType*d1);
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> blackFormulaForwardSecondDerivative(
+                                                    const Array& strikes,
+                                                    Real forward,
+                                                    const Array& stdDevs,
+                                                    Real discount,
+                                                    Real displacement) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Real f = forward + displacement;
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            const Real k = strikes[i] + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            if (stdDev==0.0 || k==0.0) {
+                result[i] = 0.0;
+            } else {
+                const Real d1 = std::log(f/k)/stdDev + 0.5*stdDev;
+                result[i] = discount * phi.derivative(d1) / (f*stdDev);
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> blackFormulaCashItmProbability(Option::Type optionType,
+                                                     const Array& strikes,
+                                                     Real forward,
+                                                     const Array& stdDevs,
+                                                     Real displacement) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+
+        const Real f = forward + displacement;
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            const Real k = strikes[i] + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            if (stdDev==0.0) {
+                result[i] = (forward*optionType > strikes[i]*optionType
+                             ? 1.0 : 0.0);
+            } else if (k==0.0) {
+                result[i] = (optionType==Option::Call ? 1.0 : 0.0);
+            } else {
+                const Real d2 = std::log(f/k)/stdDev - 0.5*stdDev;
+                result[i] = phi(optionType*d2);
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> bachelierBlackFormula(Option::Type optionType,
+                                            const Array& strikes,
+                                            Real forward,
+                                            const Array& stdDevs,
+                                            Real discount) {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and standard deviations (" << stdDevs.size() << ")");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real stdDev = stdDevs[i];
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+
+            const Real d = (forward-strikes[i])*optionType;
+            if (stdDev==0.0) {
+                result[i] = discount*std::max(d, 0.0);
+            } else {
+                const Real h = d/stdDev;
+                result[i] = discount*(stdDev*phi.derivative(h) + d*phi(h));
+                QL_ENSURE(result[i]>=0.0,
+                          "negative value (" << result[i] << ") for " <<
+                          stdDev << " stdDev, " <<
+                          optionType << " option, " <<
+                          strikes[i] << " strike , " <<
+                          forward << " forward");
+            }
+        }
+        return result;
+    }
+
+    Disposable<Array> blackFormulaImpliedStdDev(Option::Type optionType,
+                                                const Array& strikes,
+                                                Real forward,
+                                                const Array& blackPrices,
+                                                Real discount,
+                                                Real displacement,
+                                                Real accuracy,
+                                                Natural maxIterations) {
+        QL_REQUIRE(strikes.size() == blackPrices.size(),
+                   "mismatch between strikes (" << strikes.size()
+                   << ") and prices (" << blackPrices.size() << ")");
+        QL_REQUIRE(displacement >= 0.0, "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0, "forward + displacement ("
+                   << forward << " + " << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Real f = forward + displacement;
+        const Real maxStdDev = 24.0; // 24 = 300% * sqrt(60)
+        const CumulativeNormalDistribution phi;
+
+        Array result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real strike = strikes[i];
+            const Real k = strike + displacement;
+            QL_REQUIRE(k >= 0.0, "strike + displacement (" << strike
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(blackPrices[i]>=0.0,
+                       "option price (" << blackPrices[i]
+                       << ") must be non-negative");
+
+            // check the price of the "other" option implied by put-call
+            // parity and solve for the out-of-the-money one
+            Option::Type type = optionType;
+            Real price = blackPrices[i];
+            const Real otherPrice =
+                price - optionType*(forward-strike)*discount;
+            QL_REQUIRE(otherPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       optionType << " strike " << strike <<
+                       ", forward " << forward <<
+                       ", price " << price <<
+                       ", deflator " << discount);
+            if ((type==Option::Put && strike>forward)
+                || (type==Option::Call && strike<forward)) {
+                type = Option::Type(-1*type);
+                price = otherPrice;
+            }
+
+            const Real target = price/discount;
+            if (target == 0.0) {
+                result[i] = 0.0;
+                continue;
+            }
+            QL_REQUIRE(k > 0.0, "implied standard deviation not defined "
+                       "for null strike + displacement");
+
+            const Real x = std::log(f/k);
+            const Real x2 = x*x;
+
+            Real lo = 0.0, hi = maxStdDev;
+            Real stdDev = blackFormulaImpliedStdDevApproximation(
+                type, k, f, price, discount, 0.0);
+            if (!(stdDev > lo && stdDev < hi))
+                stdDev = (x != 0.0) ? std::min(std::sqrt(2.0*std::fabs(x)),
+                                               0.5*hi)
+                                    : 1.0;
+
+            bool converged = false;
+            for (Natural n=0; n<maxIterations && !converged; ++n) {
+                const Real d1 = x/stdDev + 0.5*stdDev;
+                const Real d2 = d1 - stdDev;
+                const Real b = type*(f*phi(type*d1) - k*phi(type*d2));
+
+                if (b == target) {
+                    converged = true;
+                    break;
+                } else if (b > target) {
+                    hi = stdDev;
+                } else {
+                    lo = stdDev;
+                }
+
+                // Householder step on ln b(s) - ln target, which
+                // converges quickly for far out-of-the-money options
+                // as well.  With b(s) the undiscounted price,
+                // db/ds = F n(d1), d2b/ds2 = db/ds d1 d2/s and
+                // d3b/ds3 = db/ds ((d1 d2/s)^2 - 3 x^2/s^4 - 1/4)
+                const Real s2 = stdDev*stdDev;
+                const Real r = f*phi.derivative(d1)/b;
+                const Real b2 = d1*d2/stdDev;
+                const Real b3 = b2*b2 - 3.0*x2/(s2*s2) - 0.25;
+                const Real h2 = b2 - r;
+                const Real h3 = b3 - 3.0*b2*r + 2.0*r*r;
+                const Real nu = -std::log(b/target)/r;
+                Real next = stdDev + nu*(1.0 + 0.5*h2*nu)
+                                   /(1.0 + h2*nu + h3*nu*nu/6.0);
+
+                // the negated comparison also catches NaNs
+                if (!(next >= lo && next <= hi))
+                    next = 0.5*(lo + hi);
+
+                converged = std::fabs(next - stdDev) < accuracy;
+                stdDev = next;
+            }
+            QL_REQUIRE(maxStdDev - stdDev > accuracy,
+                       "price (" << blackPrices[i] << ") for strike "
+                       << strike << " not attainable with a standard "
+                       "deviation below " << maxStdDev);
+            QL_REQUIRE(converged,
+                       "implied standard deviation not found after "
+                       << maxIterations << " iterations for strike "
+                       << strike << ", forward " << forward
+                       << ", price " << blackPrices[i]);
+            result[i] = stdDev;
+        }
+        return result;
+    }
+
+
 }
@@ -34,6 +34,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -353,6 +354,91 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+    /*! \name Batch versions
+
+        The functions below work on several options of the same type
+        written on the same forward, with strikes and standard
+        deviations (or prices) given element-wise.  Checks on the
+        common arguments and the set-up of the normal distribution are
+        performed once per batch; the loops over the options carry no
+        other overhead.
+    */
+    //@{
+    //! Black 1976 formula for several strikes
+    Disposable<Array> blackFormula(Option::Type optionType,
+                                   const Array& strikes,
+                                   Real forward,
+                                   const Array& stdDevs,
+                                   Real discount = 1.0,
+                                   Real displacement = 0.0);
+
+    //! Black 1976 standard deviation derivative for several strikes
+    Disposable<Array> blackFormulaStdDevDerivative(const Array& strikes,
+                                                   Real forward,
+                                                   const Array& stdDevs,
+                                                   Real discount = 1.0,
+                                                   Real displacement = 0.0);
+
+    /*! Black 1976 derivative with respect to the forward for several
+        strikes, i.e. BlackCalculator::deltaForward()
+    */
+    Disposable<Array> blackFormulaForwardDerivative(Option::Type optionType,
+                                                    const Array& strikes,
+                                                    Real forward,
+                                                    const Array& stdDevs,
+                                                    Real discount = 1.0,
+                                                    Real displacement = 0.0);
+
+    /*! Black 1976 second derivative with respect to the forward for
+        several strikes, i.e. BlackCalculator::gammaForward()
+    */
+    Disposable<Array> blackFormulaForwardSecondDerivative(
+                                                    const Array& strikes,
+                                                    Real forward,
+                                                    const Array& stdDevs,
+                                                    Real discount = 1.0,
+                                                    Real displacement = 0.0);
+
+    //! Black 1976 probability of being in the money for several strikes
+    Disposable<Array> blackFormulaCashItmProbability(Option::Type optionType,
+                                                     const Array& strikes,
+                                                     Real forward,
+                                                     const Array& stdDevs,
+                                                     Real displacement = 0.0);
+
+    //! Bachelier formula for several strikes
+    Disposable<Array> bachelierBlackFormula(Option::Type optionType,
+                                            const Array& strikes,
+                                            Real forward,
+                                            const Array& stdDevs,
+                                            Real discount = 1.0);
+
+    /*! Black 1976 implied standard deviations for several strikes.
+
+        Each standard deviation is found by third-order Householder
+        iterations on the price of the out-of-the-money option, using
+        the closed-form first, second and third derivatives of the
+        Black formula with respect to the standard deviation.  The
+        iterate is kept inside a bracket which is updated at each
+        step; whenever a step would leave it, a bisection step is
+        taken instead.  Convergence is therefore guaranteed for any
+        attainable price, usually within three to four iterations.
+
+        The starting point is the Corrado-Miller approximation or,
+        when this is not available, the inflection point
+        \f$ \sqrt{2|\ln(F/K)|} \f$ of the price as a function of
+        the standard deviation.
+    */
+    Disposable<Array> blackFormulaImpliedStdDev(Option::Type optionType,
+                                                const Array& strikes,
+                                                Real forward,
+                                                const Array& blackPrices,
+                                                Real discount = 1.0,
+                                                Real displacement = 0.0,
+                                                Real accuracy = 1.0e-6,
+                                                Natural maxIterations = 100);
+    //@}
+
 }
 
 #endif
@@ -32,6 +32,29 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        /* The curves supported by the engine are causal: the values up
+           to a node only depend on the data up to that node. Returns the
+           last date whose values are unchanged between two versions of
+           a curve, given by their node dates and data (flat curves have
+           no dates and are fingerprinted by a single value). */
+        Date unchangedUntil(const std::vector<Date>& oldDates,
+                            const std::vector<Real>& oldData,
+                            const std::vector<Date>& newDates,
+                            const std::vector<Real>& newData) {
+            if (oldDates == newDates && oldData == newData)
+                return Date::maxDate();
+            Size m = 0;
+            while (m < oldDates.size() && m < newDates.size() &&
+                   m < oldData.size() && m < newData.size() &&
+                   oldDates[m] == newDates[m] && oldData[m] == newData[m])
+                ++m;
+            return m == 0 ? Date::minDate() : oldDates[m-1];
+        }
+
+    }
+
     IsdaCdsEngine::IsdaCdsEngine(
         const Handle<DefaultProbabilityTermStructure> &probability,
         Real recoveryRate, const Handle<YieldTermStructure> &discountCurve,
@@ -101,59 +124,18 @@ namespace QuantLib {
         Date effectiveProtectionStart =
             std::max<Date>(arguments_.protectionStart, evalDate + 1);
 
-        // collect nodes from both curves and sort them
-        std::vector<Date> yDates, cDates;
-
-        if(boost::shared_ptr<InterpolatedDiscountCurve<LogLinear> > castY1 =
-            boost::dynamic_pointer_cast<
-                InterpolatedDiscountCurve<LogLinear> >(*discountCurve_)) {
-            yDates = castY1->dates();
-        } else if(boost::shared_ptr<InterpolatedForwardCurve<BackwardFlat> >
-        castY2 = boost::dynamic_pointer_cast<
-            InterpolatedForwardCurve<BackwardFlat> >(*discountCurve_)) {
-            yDates = castY2->dates();
-        } else if(boost::shared_ptr<InterpolatedForwardCurve<ForwardFlat> >
-        castY3 = boost::dynamic_pointer_cast<
-            InterpolatedForwardCurve<ForwardFlat> >(*discountCurve_)) {
-            yDates = castY3->dates();
-        } else if(boost::shared_ptr<FlatForward> castY4 =
-            boost::dynamic_pointer_cast<FlatForward>(*discountCurve_)) {
-        } else {
-            QL_FAIL("Yield curve must be flat forward interpolated");
-        }
-
-        if(boost::shared_ptr<InterpolatedSurvivalProbabilityCurve<LogLinear> >
-        castC1 = boost::dynamic_pointer_cast<
-            InterpolatedSurvivalProbabilityCurve<LogLinear> >(
-            *probability_)) {
-            cDates = castC1->dates();
-        } else if(
-        boost::shared_ptr<InterpolatedHazardRateCurve<BackwardFlat> > castC2 =
-            boost::dynamic_pointer_cast<
-            InterpolatedHazardRateCurve<BackwardFlat> >(*probability_)) {
-            cDates = castC2->dates();
-        } else if(
-        boost::shared_ptr<FlatHazardRate> castC3 =
-            boost::dynamic_pointer_cast<FlatHazardRate>(*probability_)) {
-        } else{
-            QL_FAIL("Credit curve must be flat forward interpolated");
-        }
-
-        std::vector<Date> nodes;
-        std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes));
-
-
-        if(nodes.empty()){
-            nodes.push_back(maturity);
-        }
+        updateCache(evalDate);
+        // merged nodes of both curves
+        std::vector<Date> maturityNode(1, maturity);
+        const std::vector<Date>& nodes =
+            nodes_.empty() ? maturityNode : nodes_;
         const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
 
         // protection leg pricing (npv is always negative at this stage)
         Real protectionNpv = 0.0;
 
         Date d0 = effectiveProtectionStart-1;
-        Real P0 = discountCurve_->discount(d0);
-        Real Q0 = probability_->survivalProbability(d0);
+        const NodeValues* v0 = &nodeValues(d0);
         Date d1;
         std::vector<Date>::const_iterator it =
             std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart);
@@ -165,11 +147,12 @@ namespace QuantLib {
             } else {
                 d1 = *it;
             }
-            Real P1 = discountCurve_->discount(d1);
-            Real Q1 = probability_->survivalProbability(d1);
+            const NodeValues* v1 = &nodeValues(d1);
+            Real P0 = v0->discount, Q0 = v0->survival;
+            Real P1 = v1->discount, Q1 = v1->survival;
 
-            Real fhat = std::log(P0) - std::log(P1);
-            Real hhat = std::log(Q0) - std::log(Q1);
+            Real fhat = v0->logDiscount - v1->logDiscount;
+            Real hhat = v0->logSurvival - v1->logSurvival;
             Real fhphh = fhat + hhat;
 
             if (fhphh < 1E-4 && numericalFix_ == Taylor) {
@@ -182,8 +165,7 @@ namespace QuantLib {
                 protectionNpv += hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
             }
             d0 = d1;
-            P0 = P1;
-            Q0 = Q1;
+            v0 = v1;
         }
         protectionNpv *= arguments_.claim->amount(
             Null<Date>(), arguments_.notional, recoveryRate_);
@@ -208,8 +190,8 @@ namespace QuantLib {
                                                 includeSettlementDateFlows_)) {
                 premiumNpv +=
                     coupon->amount() *
-                    discountCurve_->discount(coupon->date()) *
-                    probability_->survivalProbability(coupon->date()-1);
+                    nodeValues(coupon->date(), true, false).discount *
+                    nodeValues(coupon->date()-1, false, true).survival;
             }
 
             // default accruals
@@ -220,7 +202,7 @@ namespace QuantLib {
                                             effectiveProtectionStart)-1;
                 Date end = coupon->date()-1;
                 Real tstart =
-                    discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
+                    nodeValues(coupon->accrualStartDate()-1, false, false).time -
                     (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
                 std::vector<Date> localNodes;
                 localNodes.push_back(start);
@@ -236,16 +218,14 @@ namespace QuantLib {
 
                 Real defaultAccrThisNode = 0.;
                 std::vector<Date>::const_iterator node = localNodes.begin();
-                Real t0 = discountCurve_->timeFromReference(*node);
-                Real P0 = discountCurve_->discount(*node);
-                Real Q0 = probability_->survivalProbability(*node);
+                const NodeValues* v0 = &nodeValues(*node);
 
                 for (++node; node != localNodes.end(); ++node) {
-                    Real t1 = discountCurve_->timeFromReference(*node);
-                    Real P1 = discountCurve_->discount(*node);
-                    Real Q1 = probability_->survivalProbability(*node);
-                    Real fhat = std::log(P0) - std::log(P1);
-                    Real hhat = std::log(Q0) - std::log(Q1);
+                    const NodeValues* v1 = &nodeValues(*node);
+                    Real t0 = v0->time, P0 = v0->discount, Q0 = v0->survival;
+                    Real t1 = v1->time, P1 = v1->discount, Q1 = v1->survival;
+                    Real fhat = v0->logDiscount - v1->logDiscount;
+                    Real hhat = v0->logSurvival - v1->logSurvival;
                     Real fhphh = fhat + hhat;
                     if (fhphh < 1E-4 && numericalFix_ == Taylor) {
                         // see above, terms up to (f+h)^3 seem more than enough,
@@ -268,9 +248,7 @@ namespace QuantLib {
                              (t0 - tstart) * (P0 * Q0 - P1 * Q1));
                     }
 
-                    t0 = t1;
-                    P0 = P1;
-                    Q0 = Q1;
+                    v0 = v1;
                 }
                 defaultAccrualNpv += defaultAccrThisNode * arguments_.notional *
                     coupon->rate() * 365. / 360.;
@@ -352,4 +330,118 @@ namespace QuantLib {
             results_.upfrontBPS = Null<Rate>();
         }
     }
+
+    void IsdaCdsEngine::updateCache(const Date& evalDate) const {
+
+        // make sure that lazy curves are up to date before reading them
+        discountCurve_->discount(evalDate);
+        probability_->survivalProbability(evalDate);
+
+        // collect nodes from both curves; flat curves have no nodes
+        // and are fingerprinted by their value at one year
+        std::vector<Date> yDates, cDates;
+        std::vector<Real> yData, cData;
+
+        if(boost::shared_ptr<InterpolatedDiscountCurve<LogLinear> > castY1 =
+            boost::dynamic_pointer_cast<
+                InterpolatedDiscountCurve<LogLinear> >(*discountCurve_)) {
+            yDates = castY1->dates();
+            yData = castY1->data();
+        } else if(boost::shared_ptr<InterpolatedForwardCurve<BackwardFlat> >
+        castY2 = boost::dynamic_pointer_cast<
+            InterpolatedForwardCurve<BackwardFlat> >(*discountCurve_)) {
+            yDates = castY2->dates();
+            yData = castY2->data();
+        } else if(boost::shared_ptr<InterpolatedForwardCurve<ForwardFlat> >
+        castY3 = boost::dynamic_pointer_cast<
+            InterpolatedForwardCurve<ForwardFlat> >(*discountCurve_)) {
+            yDates = castY3->dates();
+            yData = castY3->data();
+        } else if(boost::shared_ptr<FlatForward> castY4 =
+            boost::dynamic_pointer_cast<FlatForward>(*discountCurve_)) {
+            yData.push_back(castY4->discount(1.0));
+        } else {
+            QL_FAIL("Yield curve must be flat forward interpolated");
+        }
+
+        if(boost::shared_ptr<InterpolatedSurvivalProbabilityCurve<LogLinear> >
+        castC1 = boost::dynamic_pointer_cast<
+            InterpolatedSurvivalProbabilityCurve<LogLinear> >(
+            *probability_)) {
+            cDates = castC1->dates();
+            cData = castC1->data();
+        } else if(
+        boost::shared_ptr<InterpolatedHazardRateCurve<BackwardFlat> > castC2 =
+            boost::dynamic_pointer_cast<
+            InterpolatedHazardRateCurve<BackwardFlat> >(*probability_)) {
+            cDates = castC2->dates();
+            cData = castC2->data();
+        } else if(
+        boost::shared_ptr<FlatHazardRate> castC3 =
+            boost::dynamic_pointer_cast<FlatHazardRate>(*probability_)) {
+            cData.push_back(castC3->survivalProbability(1.0));
+        } else{
+            QL_FAIL("Credit curve must be flat forward interpolated");
+        }
+
+        // drop the cached values which might have changed; jumps are not
+        // part of the fingerprint, so curves having them are not cached.
+        // The node data do not determine the values of a curve relinked
+        // to another reference date or day counter, hence the latter are
+        // checked as well.
+        Date horizon = std::min(unchangedUntil(yDates_, yData_, yDates, yData),
+                                unchangedUntil(cDates_, cData_, cDates, cData));
+        const Date yReferenceDate = discountCurve_->referenceDate();
+        const Date cReferenceDate = probability_->referenceDate();
+        const DayCounter yDayCounter = discountCurve_->dayCounter();
+        const DayCounter cDayCounter = probability_->dayCounter();
+        if (evalDate != cacheReferenceDate_ ||
+            yReferenceDate != yReferenceDate_ ||
+            cReferenceDate != cReferenceDate_ ||
+            yDayCounter != yDayCounter_ || cDayCounter != cDayCounter_ ||
+            !discountCurve_->jumpDates().empty() ||
+            !probability_->jumpDates().empty())
+            horizon = Date::minDate();
+        cache_.erase(cache_.upper_bound(horizon), cache_.end());
+        cacheReferenceDate_ = evalDate;
+        yReferenceDate_ = yReferenceDate;
+        cReferenceDate_ = cReferenceDate;
+        yDayCounter_ = yDayCounter;
+        cDayCounter_ = cDayCounter;
+
+        if (yDates != yDates_ || cDates != cDates_) {
+            nodes_.clear();
+            std::set_union(yDates.begin(), yDates.end(),
+                           cDates.begin(), cDates.end(),
+                           std::back_inserter(nodes_));
+        }
+        yDates_.swap(yDates);
+        cDates_.swap(cDates);
+        yData_.swap(yData);
+        cData_.swap(cData);
+    }
+
+    const IsdaCdsEngine::NodeValues&
+    IsdaCdsEngine::nodeValues(const Date& d, bool withDiscount,
+                              bool withSurvival) const {
+        std::map<Date, NodeValues>::iterator i = cache_.lower_bound(d);
+        if (i == cache_.end() || i->first != d) {
+            NodeValues v;
+            v.time = discountCurve_->timeFromReference(d);
+            v.discount = v.survival = Null<Real>();
+            i = cache_.insert(i, std::make_pair(d, v));
+        }
+        // values are only computed when requested, since the curves
+        // might not extend to all the dates
+        NodeValues& v = i->second;
+        if (withDiscount && v.discount == Null<Real>()) {
+            v.discount = discountCurve_->discount(d);
+            v.logDiscount = std::log(v.discount);
+        }
+        if (withSurvival && v.survival == Null<Real>()) {
+            v.survival = probability_->survivalProbability(d);
+            v.logSurvival = std::log(v.survival);
+        }
+        return v;
+    }
 }
@@ -28,6 +28,7 @@
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/defaulttermstructure.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -92,6 +93,18 @@ namespace QuantLib {
 
             Furthermore, the ibor index in the swap rate helpers should not
             provide the evaluation date's fixing.
+
+            Discount factors and survival probabilities are cached at the
+            dates requested so far, together with the merged node grid of
+            the two curves. The cache is shared by all the swaps priced
+            with the same engine, so that contracts on the same curves
+            read the values at common dates (e.g. standard coupon and
+            node dates) instead of querying the curves again; each swap
+            still integrates its legs on its own. Cached values are kept
+            across recalculations as long as the reference dates, day
+            counters and curve nodes they depend on are unchanged; when a
+            bootstrapper moves the last node of the credit curve, only
+            the values beyond the previous node are computed again.
         */
 
         IsdaCdsEngine(
@@ -120,6 +133,22 @@ namespace QuantLib {
         const NumericalFix numericalFix_;
         const AccrualBias accrualBias_;
         const ForwardsInCouponPeriod forwardsInCouponPeriod_;
+
+        struct NodeValues {
+            Time time;
+            DiscountFactor discount;
+            Probability survival;
+            Real logDiscount, logSurvival;
+        };
+        void updateCache(const Date& evaluationDate) const;
+        const NodeValues& nodeValues(const Date& d,
+                                     bool withDiscount = true,
+                                     bool withSurvival = true) const;
+        mutable Date cacheReferenceDate_, yReferenceDate_, cReferenceDate_;
+        mutable DayCounter yDayCounter_, cDayCounter_;
+        mutable std::vector<Date> yDates_, cDates_, nodes_;
+        mutable std::vector<Real> yData_, cData_;
+        mutable std::map<Date, NodeValues> cache_;
     };
 }
 
@@ -97,6 +97,34 @@ namespace QuantLib {
     }
 
     // calculate npv and underlying npv as of expiry date
+    void Gaussian1dFloatFloatSwaptionEngine::couponGrids(
+        const std::vector<Date> &fixingDates,
+        const std::vector<Date> &payDates,
+        const std::vector<bool> &isRedemptionFlow,
+        const boost::shared_ptr<IborIndex> &ibor, const Size first,
+        const Date &event, const Time eventTime, Matrix &zerobonds,
+        Matrix &forwards) const {
+
+        Size n = 0;
+        while (first + n < fixingDates.size() && fixingDates[first + n] == event)
+            ++n;
+
+        std::vector<Time> payTimes(n);
+        forwards = Matrix(2 * integrationPoints_ + 1, n, 0.0);
+        for (Size j = 0; j < n; j++) {
+            payTimes[j] =
+                model_->termStructure()->timeFromReference(payDates[first + j]);
+            if (ibor != NULL && !isRedemptionFlow[first + j]) {
+                Array f = model_->forwardRateGrid(fixingDates[first + j], event,
+                                                  stddevs_, integrationPoints_,
+                                                  ibor);
+                std::copy(f.begin(), f.end(), forwards.column_begin(j));
+            }
+        }
+        zerobonds = model_->zerobondGrid(payTimes, eventTime, stddevs_,
+                                         integrationPoints_, discountCurve_);
+    }
+
     const std::pair<Real, Real> Gaussian1dFloatFloatSwaptionEngine::npvs(
         const Date &expiry, const Real y, const bool includeExerciseOnExpiry,
         const bool considerProbabilities) const {
@@ -226,8 +254,41 @@ namespace QuantLib {
             event0Time = std::max(
                 model_->termStructure()->timeFromReference(event0), 0.0);
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
+            // on the grid, the state grids, zero bonds, numeraires and
+            // ibor forwards are taken from the model, which caches them
+            // for all the swaptions priced on it; the coupons fixing on
+            // the event date are consecutive on each leg
+            bool onGrid = event0 > expiry;
+            Matrix yGrids, leg1Zerobonds, leg2Zerobonds, leg1Forwards,
+                leg2Forwards;
+            Array numeraires;
+            Size leg1First = std::find(arguments_.leg1FixingDates.begin(),
+                                       arguments_.leg1FixingDates.end(),
+                                       event0) -
+                             arguments_.leg1FixingDates.begin();
+            Size leg2First = std::find(arguments_.leg2FixingDates.begin(),
+                                       arguments_.leg2FixingDates.end(),
+                                       event0) -
+                             arguments_.leg2FixingDates.begin();
+            if (onGrid) {
+                if (event1Time != Null<Real>())
+                    yGrids = model_->yGrids(stddevs_, integrationPoints_,
+                                            event1Time, event0Time);
+                numeraires = model_->numeraireGrid(
+                    event0Time, stddevs_, integrationPoints_, discountCurve_);
+                couponGrids(arguments_.leg1FixingDates,
+                            arguments_.leg1PayDates,
+                            arguments_.leg1IsRedemptionFlow, ibor1, leg1First,
+                            event0, event0Time, leg1Zerobonds, leg1Forwards);
+                couponGrids(arguments_.leg2FixingDates,
+                            arguments_.leg2PayDates,
+                            arguments_.leg2IsRedemptionFlow, ibor2, leg2First,
+                            event0, event0Time, leg2Zerobonds, leg2Forwards);
+            }
 
+            // this loop stays serial: cms coupons call model_->swapRate,
+            // which goes through the model's swap cache, and that cache
+            // is not thread safe
             for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
 
                 // roll back
@@ -238,9 +299,12 @@ namespace QuantLib {
                                          ? 1.0
                                          : std::exp(-oas_->value() *
                                                     (event1Time - event0Time));
-                    Array yg =
-                        model_->yGrid(stddevs_, integrationPoints_, event1Time,
-                                      event0Time, event0 > expiry ? z[k] : y);
+                    Array yg;
+                    if (onGrid)
+                        yg = Array(yGrids.row_begin(k), yGrids.row_end(k));
+                    else
+                        yg = model_->yGrid(stddevs_, integrationPoints_,
+                                           event1Time, event0Time, y);
                     CubicInterpolation payoff0(
                         z.begin(), z.end(), npv1.begin(),
                         CubicInterpolation::Spline, true,
@@ -353,9 +417,15 @@ namespace QuantLib {
                                     ? 1.0
                                     : std::exp(-oas_->value() *
                                                (event1Time - event0Time));
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, event1Time,
-                                event0Time, event0 > expiry ? z[k] : 0.0);
+                            Array yg;
+                            if (onGrid)
+                                yg = Array(yGrids.row_begin(k),
+                                           yGrids.row_end(k));
+                            else
+                                yg = model_->yGrid(stddevs_,
+                                                   integrationPoints_,
+                                                   event1Time, event0Time,
+                                                   0.0);
                             CubicInterpolation payoff0(
                                 z.begin(), z.end(), npvp1[m].begin(),
                                 CubicInterpolation::Spline, true,
@@ -443,10 +513,7 @@ namespace QuantLib {
                                         // exercise date,
                         // the coupon is part of the exercise into right (by
                         // definition)
-                        Size j = std::find(arguments_.leg1FixingDates.begin(),
-                                           arguments_.leg1FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg1FixingDates.begin();
+                        Size j = leg1First;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -465,9 +532,12 @@ namespace QuantLib {
                             } else {
                                 Real estFixing = 0.0;
                                 if(ibor1 != NULL) {
-                                    estFixing = model_->forwardRate(
-                                        arguments_.leg1FixingDates[j], event0,
-                                        zk, ibor1);
+                                    estFixing =
+                                        onGrid
+                                            ? leg1Forwards[k][j - leg1First]
+                                            : model_->forwardRate(
+                                                  arguments_.leg1FixingDates[j],
+                                                  event0, zk, ibor1);
                                 }
                                 if(cms1 != NULL) {
                                     estFixing = model_->swapRate(
@@ -507,10 +577,13 @@ namespace QuantLib {
 
                             npv0a[k] -=
                                 amount *
-                                model_->zerobond(arguments_.leg1PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
+                                (onGrid ? leg1Zerobonds[k][j - leg1First]
+                                        : model_->zerobond(
+                                              arguments_.leg1PayDates[j],
+                                              event0, zk, discountCurve_)) /
+                                (onGrid ? numeraires[k]
+                                        : model_->numeraire(event0Time, zk,
+                                                            discountCurve_)) *
                                 zSpreadDf;
 
                             if (j < arguments_.leg1FixingDates.size() - 1) {
@@ -527,10 +600,7 @@ namespace QuantLib {
                                         // exercise date,
                         // the coupon is part of the exercise into right (by
                         // definition)
-                        Size j = std::find(arguments_.leg2FixingDates.begin(),
-                                           arguments_.leg2FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg2FixingDates.begin();
+                        Size j = leg2First;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -549,7 +619,12 @@ namespace QuantLib {
                             } else {
                                 Real estFixing = 0.0;
                                 if(ibor2 != NULL)
-                                    estFixing = model_->forwardRate(arguments_.leg2FixingDates[j],event0,zk,ibor2);
+                                    estFixing =
+                                        onGrid
+                                            ? leg2Forwards[k][j - leg2First]
+                                            : model_->forwardRate(
+                                                  arguments_.leg2FixingDates[j],
+                                                  event0, zk, ibor2);
                                 if(cms2 != NULL)
                                     estFixing = model_->swapRate(arguments_.leg2FixingDates[j],cms2->tenor(),event0,zk,cms2);
                                 if (cmsspread2 != NULL)
@@ -585,10 +660,13 @@ namespace QuantLib {
 
                             npv0a[k] +=
                                 amount *
-                                model_->zerobond(arguments_.leg2PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
+                                (onGrid ? leg2Zerobonds[k][j - leg2First]
+                                        : model_->zerobond(
+                                              arguments_.leg2PayDates[j],
+                                              event0, zk, discountCurve_)) /
+                                (onGrid ? numeraires[k]
+                                        : model_->numeraire(event0Time, zk,
+                                                            discountCurve_)) *
                                 zSpreadDf;
                             if (j < arguments_.leg2FixingDates.size() - 1) {
                                 j++;
@@ -623,8 +701,10 @@ namespace QuantLib {
                         Real exerciseValue =
                             (type == Option::Call ? 1.0 : -1.0) * npv0a[k] +
                             rebate * model_->zerobond(rebateDate, event0) *
-                                zSpreadDf / model_->numeraire(event0Time, zk,
-                                                              discountCurve_);
+                                zSpreadDf /
+                                (onGrid ? numeraires[k]
+                                        : model_->numeraire(event0Time, zk,
+                                                            discountCurve_));
 
                         if (considerProbabilities && probabilities_ != None) {
                             if (exIdx == noEx) {
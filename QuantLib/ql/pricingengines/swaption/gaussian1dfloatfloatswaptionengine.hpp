@@ -122,6 +122,17 @@ namespace QuantLib {
              const bool includeExerciseOnxpiry,
              const bool considerProbabilities=false) const;
 
+        // zero bonds and ibor forwards on the model grid at the event
+        // date for the coupons of a leg fixing on that date, starting
+        // at the given index
+        void couponGrids(const std::vector<Date> &fixingDates,
+                         const std::vector<Date> &payDates,
+                         const std::vector<bool> &isRedemptionFlow,
+                         const boost::shared_ptr<IborIndex> &ibor,
+                         const Size first, const Date &event,
+                         const Time eventTime, Matrix &zerobonds,
+                         Matrix &forwards) const;
+
         mutable boost::shared_ptr<RebatedExercise> rebatedExercise_;
     };
 }
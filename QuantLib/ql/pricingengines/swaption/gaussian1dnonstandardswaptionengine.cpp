@@ -198,9 +198,68 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
+            // the model quantities needed on the grid are taken from the
+            // model (which caches them for all the swaptions priced on
+            // it) before the loop below, which must not call the model
+            // since neither the lazy object nor its cache is thread safe
+            Matrix yGrids, forwardRates, floatingZerobonds, fixedZerobonds,
+                rebateZerobonds;
+            Array numeraires, yg0;
+            Real zerobond0 = 0.0;
+            if (expiry0 > settlement) {
+                if (expiry1Time != Null<Real>())
+                    yGrids = model_->yGrids(stddevs_, integrationPoints_,
+                                            expiry1Time, expiry0Time);
+                Size nFloating =
+                    std::max<Size>(arguments_.floatingCoupons.size(), k1) - k1;
+                std::vector<Time> floatingPayTimes(nFloating);
+                forwardRates = Matrix(z.size(), nFloating, 0.0);
+                for (Size l = 0; l < nFloating; l++) {
+                    floatingPayTimes[l] =
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[k1 + l]);
+                    if (!arguments_.floatingIsRedemptionFlow[k1 + l]) {
+                        Array f = model_->forwardRateGrid(
+                            arguments_.floatingFixingDates[k1 + l], expiry0,
+                            stddevs_, integrationPoints_,
+                            arguments_.swap->iborIndex());
+                        std::copy(f.begin(), f.end(),
+                                  forwardRates.column_begin(l));
+                    }
+                }
+                floatingZerobonds =
+                    model_->zerobondGrid(floatingPayTimes, expiry0Time,
+                                         stddevs_, integrationPoints_,
+                                         discountCurve_);
+                std::vector<Time> fixedPayTimes(
+                    std::max<Size>(arguments_.fixedCoupons.size(), j1) - j1);
+                for (Size l = 0; l < fixedPayTimes.size(); l++)
+                    fixedPayTimes[l] =
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[j1 + l]);
+                fixedZerobonds =
+                    model_->zerobondGrid(fixedPayTimes, expiry0Time, stddevs_,
+                                         integrationPoints_, discountCurve_);
+                std::vector<Time> rebateTime(
+                    1, model_->termStructure()->timeFromReference(
+                           rebatedExercise != NULL
+                               ? rebatedExercise->rebatePaymentDate(idx)
+                               : expiry0));
+                rebateZerobonds =
+                    model_->zerobondGrid(rebateTime, expiry0Time, stddevs_,
+                                         integrationPoints_, discountCurve_);
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+                if (probabilities_ != None)
+                    zerobond0 =
+                        model_->zerobond(expiry0Time, 0.0, 0.0, discountCurve_);
+            } else if (expiry1Time != Null<Real>()) {
+                yg0 = model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                                    expiry0Time, 0.0);
+            }
 
-            for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
+#pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
+            for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
                  k++) {
 
                 Real price = 0.0;
@@ -209,15 +268,15 @@ namespace QuantLib {
                         oas_.empty() ? 1.0
                                      : std::exp(-oas_->value() *
                                                 (expiry1Time - expiry0Time));
-                    Array yg = model_->yGrid(stddevs_, integrationPoints_,
-                                             expiry1Time, expiry0Time,
-                                             expiry0 > settlement ? z[k] : 0.0);
+                    Matrix::const_row_iterator yg =
+                        expiry0 > settlement ? yGrids.row_begin(k)
+                                             : yg0.begin();
                     CubicInterpolation payoff0(
                         z.begin(), z.end(), npv1.begin(),
                         CubicInterpolation::Spline, true,
                         CubicInterpolation::Lagrange, 0.0,
                         CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
+                    for (Size i = 0; i < z.size(); i++) {
                         p[i] = payoff0(yg[i], true);
                     }
                     CubicInterpolation payoff1(
@@ -279,15 +338,15 @@ namespace QuantLib {
                                     ? 1.0
                                     : std::exp(-oas_->value() *
                                                (expiry1Time - expiry0Time));
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, expiry1Time,
-                                expiry0Time, expiry0 > settlement ? z[k] : 0.0);
+                            Matrix::const_row_iterator yg =
+                                expiry0 > settlement ? yGrids.row_begin(k)
+                                                     : yg0.begin();
                             CubicInterpolation payoff0(
                                 z.begin(), z.end(), npvp1[m].begin(),
                                 CubicInterpolation::Spline, true,
                                 CubicInterpolation::Lagrange, 0.0,
                                 CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < yg.size(); i++) {
+                            for (Size i = 0; i < z.size(); i++) {
                                 p[i] = payoff0(yg[i], true);
                             }
                             CubicInterpolation payoff1(
@@ -381,16 +440,11 @@ namespace QuantLib {
                             amount = arguments_.floatingNominal[l] *
                                      arguments_.floatingAccrualTimes[l] *
                                      (arguments_.floatingGearings[l] *
-                                          model_->forwardRate(
-                                              arguments_.floatingFixingDates[l],
-                                              expiry0, z[k],
-                                              arguments_.swap->iborIndex()) +
+                                          forwardRates[k][l - k1] +
                                       arguments_.floatingSpreads[l]);
-                        floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                        floatingLegNpv += amount *
+                                          floatingZerobonds[k][l - k1] *
+                                          zSpreadDf;
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
@@ -404,11 +458,8 @@ namespace QuantLib {
                                            .yearFraction(
                                                 expiry0,
                                                 arguments_.fixedPayDates[l])));
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                        fixedLegNpv += arguments_.fixedCoupons[l] *
+                                       fixedZerobonds[k][l - j1] * zSpreadDf;
                     }
                     Real rebate = 0.0;
                     Real zSpreadDf = 1.0;
@@ -428,10 +479,8 @@ namespace QuantLib {
                     Real exerciseValue =
                         ((type == Option::Call ? 1.0 : -1.0) *
                              (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                         rebate * rebateZerobonds[k][0] * zSpreadDf) /
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -443,21 +492,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
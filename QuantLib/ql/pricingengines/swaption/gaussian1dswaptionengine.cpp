@@ -88,31 +88,54 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
-            // a lazy object is not thread safe, neither is the caching
-            // in gsrprocess. therefore we trigger computations here such
-            // that neither lazy object recalculation nor write access
-            // during caching occurs in the parallized loop below.
-            // this is known to work for the gsr and markov functional
-            // model implementations of Gaussian1dModel
-#ifdef _OPENMP
-            if (expiry1Time != Null<Real>())
-                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
-                              expiry0Time, 0.0);
+            // the model quantities needed on the grid are taken from the
+            // model (which caches them for all the swaptions priced on
+            // it) before the loop below. A lazy object is not thread safe,
+            // neither is the caching in the model, therefore the
+            // parallelized loop must not call the model itself.
+            Matrix yGrids, forwardRates, floatingZerobonds, fixedZerobonds;
+            Array numeraires, yg0;
+            Real zerobond0 = 0.0;
             if (expiry0 > settlement) {
-                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
-                    model_->forwardRate(arguments_.floatingFixingDates[l],
-                                        expiry0, 0.0,
-                                        arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
+                if (expiry1Time != Null<Real>())
+                    yGrids = model_->yGrids(stddevs_, integrationPoints_,
+                                            expiry1Time, expiry0Time);
+                Size nFloating =
+                    std::max<Size>(arguments_.floatingCoupons.size(), k1) - k1;
+                std::vector<Time> floatingPayTimes(nFloating);
+                forwardRates = Matrix(z.size(), nFloating);
+                for (Size l = 0; l < nFloating; l++) {
+                    floatingPayTimes[l] =
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[k1 + l]);
+                    Array f = model_->forwardRateGrid(
+                        arguments_.floatingFixingDates[k1 + l], expiry0,
+                        stddevs_, integrationPoints_,
+                        arguments_.swap->iborIndex());
+                    std::copy(f.begin(), f.end(), forwardRates.column_begin(l));
                 }
-                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
-                }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
+                floatingZerobonds =
+                    model_->zerobondGrid(floatingPayTimes, expiry0Time,
+                                         stddevs_, integrationPoints_,
+                                         discountCurve_);
+                std::vector<Time> fixedPayTimes(
+                    std::max<Size>(arguments_.fixedCoupons.size(), j1) - j1);
+                for (Size l = 0; l < fixedPayTimes.size(); l++)
+                    fixedPayTimes[l] =
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[j1 + l]);
+                fixedZerobonds =
+                    model_->zerobondGrid(fixedPayTimes, expiry0Time, stddevs_,
+                                         integrationPoints_, discountCurve_);
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+                if (probabilities_ != None)
+                    zerobond0 =
+                        model_->zerobond(expiry0Time, 0.0, 0.0, discountCurve_);
+            } else if (expiry1Time != Null<Real>()) {
+                yg0 = model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                                    expiry0Time, 0.0);
             }
-#endif
 
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
@@ -120,15 +143,15 @@ namespace QuantLib {
 
                 Real price = 0.0;
                 if (expiry1Time != Null<Real>()) {
-                    Array yg = model_->yGrid(stddevs_, integrationPoints_,
-                                             expiry1Time, expiry0Time,
-                                             expiry0 > settlement ? z[k] : 0.0);
+                    Matrix::const_row_iterator yg =
+                        expiry0 > settlement ? yGrids.row_begin(k)
+                                             : yg0.begin();
                     CubicInterpolation payoff0(
                         z.begin(), z.end(), npv1.begin(),
                         CubicInterpolation::Spline, true,
                         CubicInterpolation::Lagrange, 0.0,
                         CubicInterpolation::Lagrange, 0.0);
-                    for (Size i = 0; i < yg.size(); i++) {
+                    for (Size i = 0; i < z.size(); i++) {
                         p[i] = payoff0(yg[i], true);
                     }
                     CubicInterpolation payoff1(
@@ -178,15 +201,15 @@ namespace QuantLib {
                     for (Size m = 0; m < npvp0.size(); m++) {
                         Real price = 0.0;
                         if (expiry1Time != Null<Real>()) {
-                            Array yg = model_->yGrid(
-                                stddevs_, integrationPoints_, expiry1Time,
-                                expiry0Time, expiry0 > settlement ? z[k] : 0.0);
+                            Matrix::const_row_iterator yg =
+                                expiry0 > settlement ? yGrids.row_begin(k)
+                                                     : yg0.begin();
                             CubicInterpolation payoff0(
                                 z.begin(), z.end(), npvp1[m].begin(),
                                 CubicInterpolation::Spline, true,
                                 CubicInterpolation::Lagrange, 0.0,
                                 CubicInterpolation::Lagrange, 0.0);
-                            for (Size i = 0; i < yg.size(); i++) {
+                            for (Size i = 0; i < z.size(); i++) {
                                 p[i] = payoff0(yg[i], true);
                             }
                             CubicInterpolation payoff1(
@@ -260,23 +283,17 @@ namespace QuantLib {
                             arguments_.nominal *
                             arguments_.floatingAccrualTimes[l] *
                             (arguments_.floatingSpreads[l] +
-                             model_->forwardRate(
-                                 arguments_.floatingFixingDates[l], expiry0,
-                                 z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                             forwardRates[k][l - k1]) *
+                            floatingZerobonds[k][l - k1];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                        fixedLegNpv += arguments_.fixedCoupons[l] *
+                                       fixedZerobonds[k][l - j1];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        (floatingLegNpv - fixedLegNpv) / numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -288,21 +305,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
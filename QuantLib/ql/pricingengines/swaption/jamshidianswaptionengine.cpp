@@ -19,6 +19,7 @@
 */
 
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 
 namespace QuantLib {
@@ -52,7 +53,12 @@ namespace QuantLib {
         const boost::shared_ptr<OneFactorAffineModel>& model_;
     };
 
-    void JamshidianSwaptionEngine::calculate() const {
+    void JamshidianSwaptionEngine::decompose(
+                                    Time& maturity,
+                                    Time& valueTime,
+                                    std::vector<Time>& fixedPayTimes,
+                                    std::vector<Real>& amounts,
+                                    std::vector<Real>& strikes) const {
 
         QL_REQUIRE(arguments_.settlementType==Settlement::Physical,
                    "cash-settled swaptions not priced by Jamshidian engine");
@@ -76,14 +82,14 @@ namespace QuantLib {
             dayCounter = termStructure_->dayCounter();
         }
 
-        std::vector<Real> amounts(arguments_.fixedCoupons);
+        amounts = arguments_.fixedCoupons;
         amounts.back() += arguments_.nominal;
 
-        Real maturity = dayCounter.yearFraction(referenceDate,
-                                                arguments_.exercise->date(0));
+        maturity = dayCounter.yearFraction(referenceDate,
+                                           arguments_.exercise->date(0));
 
-        std::vector<Time> fixedPayTimes(arguments_.fixedPayDates.size());
-        Time valueTime = dayCounter.yearFraction(referenceDate,arguments_.fixedResetDates[0]);
+        fixedPayTimes.resize(arguments_.fixedPayDates.size());
+        valueTime = dayCounter.yearFraction(referenceDate,arguments_.fixedResetDates[0]);
         for (Size i=0; i<fixedPayTimes.size(); i++)
             fixedPayTimes[i] = dayCounter.yearFraction(referenceDate,
                                                        arguments_.fixedPayDates[i]);
@@ -98,27 +104,63 @@ namespace QuantLib {
         s1d.setUpperBound(maxStrike);
         Rate rStar = s1d.solve(finder, 1e-8, 0.05, minStrike, maxStrike);
 
-        Option::Type w = arguments_.type==VanillaSwap::Payer ?
-                                                Option::Put : Option::Call;
         Size size = arguments_.fixedCoupons.size();
+        strikes.resize(size);
 
-        Real value = 0.0;
         Real B = model_->discountBond(maturity, valueTime, rStar);
         for (Size i=0; i<size; i++) {
-            Real fixedPayTime =
-                dayCounter.yearFraction(referenceDate,
-                                        arguments_.fixedPayDates[i]);
-            Real strike = model_->discountBond(maturity,
-                                               fixedPayTime,
-                                               rStar) / B;
+            strikes[i] = model_->discountBond(maturity,
+                                              fixedPayTimes[i],
+                                              rStar) / B;
+        }
+    }
+
+    void JamshidianSwaptionEngine::calculate() const {
+
+        Time maturity, valueTime;
+        std::vector<Time> fixedPayTimes;
+        std::vector<Real> amounts, strikes;
+        decompose(maturity, valueTime, fixedPayTimes, amounts, strikes);
+
+        Option::Type w = arguments_.type==VanillaSwap::Payer ?
+                                                Option::Put : Option::Call;
+
+        Real value = 0.0;
+        for (Size i=0; i<strikes.size(); i++) {
             // Looks like the swaption decomposed into individual options adjusted for maturity. Each individual option is valued by Hull-White (or other one-factor model).
             Real dboValue = model_->discountBondOption(
-                                               w, strike, maturity, valueTime,
-                                               fixedPayTime);
+                                               w, strikes[i], maturity,
+                                               valueTime, fixedPayTimes[i]);
             value += amounts[i]*dboValue;
         }
         results_.value = value;
     }
 
+    Disposable<Array> JamshidianSwaptionEngine::priceGradient() const {
+
+        Array gradient;
+
+        boost::shared_ptr<HullWhite> hullWhite =
+            boost::dynamic_pointer_cast<HullWhite>(*model_);
+        if (!hullWhite)
+            return gradient;
+
+        Time maturity, valueTime;
+        std::vector<Time> fixedPayTimes;
+        std::vector<Real> amounts, strikes;
+        decompose(maturity, valueTime, fixedPayTimes, amounts, strikes);
+
+        Option::Type w = arguments_.type==VanillaSwap::Payer ?
+                                                Option::Put : Option::Call;
+
+        gradient = Array(hullWhite->params().size(), 0.0);
+        for (Size i=0; i<strikes.size(); i++) {
+            gradient += amounts[i]*hullWhite->discountBondOptionGradient(
+                               w, strikes[i], maturity,
+                               valueTime, fixedPayTimes[i]);
+        }
+        return gradient;
+    }
+
 }
 
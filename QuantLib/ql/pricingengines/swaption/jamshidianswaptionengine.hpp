@@ -59,7 +59,23 @@ namespace QuantLib {
             registerWith(termStructure_);
         }
         void calculate() const;
+        //! price derivatives with respect to the model parameters
+        /*! Derivatives of the swaption price for the current arguments
+            with respect to the model parameters.  Since the strikes of
+            the Jamshidian decomposition keep the sum of the bond
+            values fixed, their variation does not contribute to the
+            derivatives, which therefore reduce to those of the
+            individual bond options at fixed strikes.  This is
+            currently available for the HullWhite model; an empty
+            array is returned for other models.
+        */
+        Disposable<Array> priceGradient() const;
       private:
+        void decompose(Time& maturity,
+                       Time& valueTime,
+                       std::vector<Time>& fixedPayTimes,
+                       std::vector<Real>& amounts,
+                       std::vector<Real>& strikes) const;
         Handle<YieldTermStructure> termStructure_;
         class rStarFinder;
         friend class rStarFinder;
@@ -35,6 +35,7 @@
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
 #include <boost/make_shared.hpp>
+#include <map>
 
 #if defined(QL_PATCH_MSVC)
 #pragma warning(disable: 4180)
@@ -123,6 +124,105 @@ namespace QuantLib {
         };
     }
 
+    namespace {
+
+        // derivatives of the Fj integrand (Gatheral's formulation)
+        // with respect to theta, kappa, sigma, rho and v0. The results
+        // are cached so that the five components can be integrated
+        // separately without re-evaluating the characteristic function.
+        class Fj_GradientHelper {
+          public:
+            Fj_GradientHelper(Real kappa, Real theta, Real sigma,
+                              Real v0, Real s0, Real rho,
+                              Time term, Real strike, Real ratio, Size j)
+            : j_(j), kappa_(kappa), theta_(theta), sigma_(sigma),
+              v0_(v0), rho_(rho), term_(term),
+              dd_(std::log(s0)-std::log(ratio)), sx_(std::log(strike)) {}
+
+            const Array& operator()(Real phi) const {
+                std::map<Real, Array>::const_iterator iter =
+                    cache_.find(phi);
+                if (iter != cache_.end())
+                    return iter->second;
+
+                Array& result = cache_[phi];
+                result = Array(5, 0.0);
+                if (phi == 0.0)
+                    return result;
+
+                typedef std::complex<Real> Complex;
+                const Complex i(0.0, 1.0);
+                const Real sigma2 = sigma_*sigma_;
+                const Real s = (j_== 1)? 1.0 : -1.0;
+                const Real delta = (j_== 1)? 1.0 : 0.0;
+
+                const Complex t1 = kappa_ - delta*rho_*sigma_
+                    - i*rho_*sigma_*phi;
+                const Complex a = phi*Complex(-phi, s);
+                const Complex d = std::sqrt(t1*t1 - sigma2*a);
+                const Complex ex = std::exp(-d*term_);
+                const Complex m = t1 - d, n = t1 + d;
+                const Complex p = m/n;
+                const Complex q = 1.0 - p*ex;
+                const Complex g = std::log(q/(1.0 - p));
+                const Complex H = m*(1.0-ex)/(sigma2*q);
+                const Complex G = m*term_ - 2.0*g;
+                const Real kt = kappa_*theta_/sigma2;
+
+                const Complex e = std::exp(v0_*H + kt*G
+                                           + Complex(0.0, phi*(dd_-sx_)));
+
+                // seeds: theta, kappa, sigma, rho, v0
+                const Real dTheta[] = { 1.0, 0.0, 0.0, 0.0, 0.0 };
+                const Real dKappa[] = { 0.0, 1.0, 0.0, 0.0, 0.0 };
+                const Real dSigma[] = { 0.0, 0.0, 1.0, 0.0, 0.0 };
+                const Real dV0[]    = { 0.0, 0.0, 0.0, 0.0, 1.0 };
+                const Complex dT1[] = {
+                    0.0, 1.0,
+                    -delta*rho_ - i*rho_*phi,
+                    -delta*sigma_ - i*sigma_*phi,
+                    0.0 };
+
+                for (Size k=0; k < 5; ++k) {
+                    const Complex dd = (t1*dT1[k] - sigma_*dSigma[k]*a)/d;
+                    const Complex dm = dT1[k] - dd, dn = dT1[k] + dd;
+                    const Complex dp = (dm*n - m*dn)/(n*n);
+                    const Complex dex = -term_*ex*dd;
+                    const Complex dq = -(dp*ex + p*dex);
+                    const Complex dg = dq/q + dp/(1.0 - p);
+                    const Complex dH = (dm*(1.0-ex) - m*dex)/(sigma2*q)
+                        - H*(2.0*dSigma[k]/sigma_ + dq/q);
+                    const Complex dG = dm*term_ - 2.0*dg;
+
+                    const Complex dPsi = dV0[k]*H + v0_*dH
+                        + (dKappa[k]*theta_ + kappa_*dTheta[k])/sigma2*G
+                        - 2.0*dSigma[k]/sigma_*kt*G
+                        + kt*dG;
+
+                    result[k] = (e*dPsi).imag()/phi;
+                }
+                return result;
+            }
+
+          private:
+            const Size j_;
+            const Real kappa_, theta_, sigma_, v0_, rho_;
+            const Time term_;
+            const Real dd_, sx_;
+            mutable std::map<Real, Array> cache_;
+        };
+
+        class Fj_GradientComponent : public std::unary_function<Real, Real> {
+          public:
+            Fj_GradientComponent(const Fj_GradientHelper& helper, Size k)
+            : helper_(helper), k_(k) {}
+            Real operator()(Real phi) const { return helper_(phi)[k_]; }
+          private:
+            const Fj_GradientHelper& helper_;
+            const Size k_;
+        };
+    }
+
     // helper class for integration
     class AnalyticHestonEngine::Fj_Helper
         : public std::unary_function<Real, Real>
@@ -141,7 +241,8 @@ namespace QuantLib {
             Time term,
             Real strike,
             Real ratio,
-            Size j);
+            Size j,
+            IntegrandCache* cache = 0);
 
          Fj_Helper(Real kappa, Real theta, Real sigma,
             Real v0, Real s0, Real rho,
@@ -170,6 +271,9 @@ namespace QuantLib {
         mutable Real g_km1_; // imag part of last log value
 
         const AnalyticHestonEngine* const engine_;
+        // strike-independent part of the exponent and add-on term,
+        // keyed by the integration node
+        IntegrandCache* const cache_;
     };
 
 
@@ -191,7 +295,7 @@ namespace QuantLib {
         rsigma_(model->rho()*sigma_),
         t0_(kappa_ - ((j_== 1)? model->rho()*sigma_ : 0)),
         b_(0), g_km1_(0),
-        engine_(engine)
+        engine_(engine), cache_(0)
     {
     }
 
@@ -202,7 +306,8 @@ namespace QuantLib {
         Time term,
         Real strike,
         Real ratio,
-        Size j)
+        Size j,
+        IntegrandCache* cache)
         :
         j_(j),
         kappa_(kappa),
@@ -219,7 +324,8 @@ namespace QuantLib {
         t0_(kappa - ((j== 1)? rho*sigma : 0)),
         b_(0),
         g_km1_(0),
-        engine_(engine)
+        engine_(engine),
+        cache_(cache)
     {
     }
 
@@ -246,13 +352,55 @@ namespace QuantLib {
         t0_(kappa - ((j== 1)? rho*sigma : 0)),
         b_(0),
         g_km1_(0),
-        engine_(0)
+        engine_(0),
+        cache_(0)
     {
     }
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
     {
+        if (cache_ != 0 && cpxLog_ == Gatheral && phi != 0.0) {
+            // the strike enters only through the last term of the
+            // exponent; the remaining terms are shared among strikes
+            IntegrandCache::const_iterator iter = cache_->find(phi);
+            if (iter == cache_->end()) {
+                const Real rpsig(rsigma_*phi);
+                const std::complex<Real> t1
+                    = t0_+std::complex<Real>(0, -rpsig);
+                const std::complex<Real> d =
+                    std::sqrt(t1*t1 - sigma2_*phi
+                              *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+                const std::complex<Real> ex = std::exp(-d*term_);
+                const std::complex<Real> addOnTerm
+                    = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
+                std::complex<Real> z;
+                if (sigma_ > 1e-5) {
+                    const std::complex<Real> p = (t1-d)/(t1+d);
+                    const std::complex<Real> g
+                                            = std::log((1.0 - p*ex)/(1.0 - p));
+                    z = v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                        + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g);
+                }
+                else {
+                    const std::complex<Real> td = phi/(2.0*t1)
+                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                    const std::complex<Real> p = td*sigma2_/(t1+d);
+                    const std::complex<Real> g = p*(1.0-ex);
+                    z = v0_*td*(1.0-ex)/(1.0-p*ex)
+                        + (kappa_*theta_)*(td*term_-2.0*g/sigma2_);
+                }
+                iter = cache_->insert(
+                    std::make_pair(phi, std::make_pair(z, addOnTerm))).first;
+            }
+
+            return std::exp(iter->second.first
+                            + std::complex<Real>(0.0, phi*(dd_-sx_))
+                            + iter->second.second
+                            ).imag()/phi;
+        }
+
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -497,6 +645,26 @@ namespace QuantLib {
                                              const AnalyticHestonEngine* const enginePtr,
                                              Real& value,
                                              Size& evaluations) {
+        doCalculation(riskFreeDiscount, dividendDiscount, spotPrice,
+                      strikePrice, term, kappa, theta, sigma, v0, rho,
+                      type, integration, cpxLog, enginePtr,
+                      value, evaluations, 0, 0);
+    }
+
+    void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
+                                             Real dividendDiscount,
+                                             Real spotPrice,
+                                             Real strikePrice,
+                                             Real term,
+                                             Real kappa, Real theta, Real sigma, Real v0, Real rho,
+                                             const TypePayoff& type,
+                                             const Integration& integration,
+                                             const ComplexLogFormula cpxLog,
+                                             const AnalyticHestonEngine* const enginePtr,
+                                             Real& value,
+                                             Size& evaluations,
+                                             IntegrandCache* cache1,
+                                             IntegrandCache* cache2) {
 
         const Real ratio = riskFreeDiscount/dividendDiscount;
 
@@ -510,12 +678,12 @@ namespace QuantLib {
 
             const Real p1 = integration.calculate(c_inf,
                 Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
-                          cpxLog, term, strikePrice, ratio, 1))/M_PI;
+                          cpxLog, term, strikePrice, ratio, 1, cache1))/M_PI;
             evaluations += integration.numberOfEvaluations();
 
             const Real p2 = integration.calculate(c_inf,
                 Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
-                          cpxLog, term, strikePrice, ratio, 2))/M_PI;
+                          cpxLog, term, strikePrice, ratio, 2, cache2))/M_PI;
             evaluations += integration.numberOfEvaluations();
 
             switch (type.optionType())
@@ -603,6 +771,16 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        // integrand values are shared only between fixed-node rules;
+        // adaptive integrators would rarely hit the same nodes again
+        std::pair<IntegrandCache, IntegrandCache>* cache = 0;
+        if (!integration_->isAdaptiveIntegration()) {
+            if (integrandCache_.size() >= maxCachedMaturities
+                && integrandCache_.find(term) == integrandCache_.end())
+                integrandCache_.clear();
+            cache = &integrandCache_[term];
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -618,7 +796,124 @@ namespace QuantLib {
                       cpxLog_,
                       this,
                       results_.value,
-                      evaluations_);
+                      evaluations_,
+                      cache != 0 ? &cache->first : 0,
+                      cache != 0 ? &cache->second : 0);
+    }
+
+    void AnalyticHestonEngine::update() {
+        integrandCache_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    Disposable<Array> AnalyticHestonEngine::prices(
+                            const Date& maturity,
+                            const std::vector<Option::Type>& types,
+                            const std::vector<Real>& strikes) const {
+        QL_REQUIRE(types.size() == strikes.size(),
+                   "mismatch between option types (" << types.size()
+                   << ") and strikes (" << strikes.size() << ")");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        // the integrand values are shared among the strikes of this
+        // call only, so that the engine state is left untouched
+        std::pair<IntegrandCache, IntegrandCache> cache;
+        const bool useCache = !integration_->isAdaptiveIntegration();
+
+        Array result(strikes.size());
+        Size evaluations = 0;
+        for (Size i=0; i < strikes.size(); ++i) {
+            doCalculation(riskFreeDiscount,
+                          dividendDiscount,
+                          spotPrice,
+                          strikes[i],
+                          term,
+                          model_->kappa(),
+                          model_->theta(),
+                          model_->sigma(),
+                          model_->v0(),
+                          model_->rho(),
+                          PlainVanillaPayoff(types[i], strikes[i]),
+                          *integration_,
+                          cpxLog_,
+                          this,
+                          result[i],
+                          evaluations,
+                          useCache ? &cache.first : 0,
+                          useCache ? &cache.second : 0);
+        }
+        return result;
+    }
+
+
+    Disposable<Array> AnalyticHestonEngine::priceGradient() const {
+        Array gradient;
+
+        const Real sigma = model_->sigma();
+        if (cpxLog_ != Gatheral || model_->params().size() != 5
+            || sigma <= 1e-5)
+            return gradient;
+
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount = process->riskFreeRate()->discount(
+                                            arguments_.exercise->lastDate());
+        const Real dividendDiscount = process->dividendYield()->discount(
+                                            arguments_.exercise->lastDate());
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real strikePrice = payoff->strike();
+        const Real term = process->time(arguments_.exercise->lastDate());
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real v0 = model_->v0();
+        const Real rho = model_->rho();
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+        const Fj_GradientHelper f1(kappa, theta, sigma, v0, spotPrice, rho,
+                                   term, strikePrice, ratio, 1);
+        const Fj_GradientHelper f2(kappa, theta, sigma, v0, spotPrice, rho,
+                                   term, strikePrice, ratio, 2);
+
+        // the constant terms of the call and put prices do not depend
+        // on the model parameters
+        gradient = Array(5);
+        for (Size k=0; k < 5; ++k) {
+            const Real dp1 = integration_->calculate(
+                c_inf, Fj_GradientComponent(f1, k))/M_PI;
+            const Real dp2 = integration_->calculate(
+                c_inf, Fj_GradientComponent(f2, k))/M_PI;
+            gradient[k] = spotPrice*dividendDiscount*dp1
+                - strikePrice*riskFreeDiscount*dp2;
+        }
+
+        return gradient;
     }
 
 
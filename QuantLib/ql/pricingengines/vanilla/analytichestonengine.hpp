@@ -34,6 +34,7 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -117,8 +118,41 @@ namespace QuantLib {
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
         void calculate() const;
+        void update();
         Size numberOfEvaluations() const;
 
+        //! prices of several options sharing the same exercise date
+        /*! For Gatheral's complex log formula and a non-adaptive
+            integration rule, the strike-independent part of the
+            Fourier integrand is evaluated only once per integration
+            node and shared among all the options passed.  The same
+            sharing takes place between successive calls to
+            calculate() for options expiring on the same date, e.g.,
+            when a set of calibration helpers uses a common engine;
+            the stored values are discarded whenever the model
+            changes.  This method does not modify the stored values.
+
+            \warning derived engines whose add-on term depends on
+                     state set up in calculate() (such as
+                     AnalyticHestonHullWhiteEngine) must be used
+                     through calculate() instead.
+        */
+        Disposable<Array> prices(const Date& maturity,
+                                 const std::vector<Option::Type>& types,
+                                 const std::vector<Real>& strikes) const;
+
+        //! price derivatives with respect to the model parameters
+        /*! Derivatives of the option price for the current arguments
+            with respect to theta, kappa, sigma, rho and v0 (i.e., in
+            the order of HestonModel::params()), obtained by
+            differentiating the characteristic function inside the
+            Fourier integrand.  An empty array is returned if the
+            derivatives are not available, i.e., for complex log
+            formulas other than Gatheral's, for models with additional
+            parameters (e.g. Bates) or for a vanishing vol of vol.
+        */
+        Disposable<Array> priceGradient() const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -143,10 +177,32 @@ namespace QuantLib {
         class Fj_Helper;
         class AP_Helper;
 
+        typedef std::map<Real, std::pair<std::complex<Real>,
+                                         std::complex<Real> > > IntegrandCache;
+
+        static void doCalculation(Real riskFreeDiscount,
+                                  Real dividendDiscount,
+                                  Real spotPrice,
+                                  Real strikePrice,
+                                  Real term,
+                                  Real kappa, Real theta, Real sigma, Real v0, Real rho,
+                                  const TypePayoff& type,
+                                  const Integration& integration,
+                                  const ComplexLogFormula cpxLog,
+                                  const AnalyticHestonEngine* const enginePtr,
+                                  Real& value,
+                                  Size& evaluations,
+                                  IntegrandCache* cache1,
+                                  IntegrandCache* cache2);
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_;
+        // at most one entry per maturity, flushed when full
+        static const Size maxCachedMaturities = 100;
+        mutable std::map<Time, std::pair<IntegrandCache,
+                                         IntegrandCache> > integrandCache_;
     };
 
 
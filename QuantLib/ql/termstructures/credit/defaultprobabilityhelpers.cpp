@@ -187,10 +187,12 @@ namespace QuantLib {
 
         switch (model_) {
           case CreditDefaultSwap::ISDA:
-            swap_->setPricingEngine(boost::make_shared<IsdaCdsEngine>(
-                probability_, recoveryRate_, discountCurve_, false,
-                IsdaCdsEngine::Taylor, IsdaCdsEngine::HalfDayBias,
-                IsdaCdsEngine::Piecewise));
+            if (!isdaEngine_)
+                isdaEngine_ = boost::make_shared<IsdaCdsEngine>(
+                    probability_, recoveryRate_, discountCurve_, false,
+                    IsdaCdsEngine::Taylor, IsdaCdsEngine::HalfDayBias,
+                    IsdaCdsEngine::Piecewise);
+            swap_->setPricingEngine(isdaEngine_);
             break;
           case CreditDefaultSwap::Midpoint:
             swap_->setPricingEngine(boost::make_shared<MidPointCdsEngine>(
@@ -272,10 +274,12 @@ namespace QuantLib {
             boost::shared_ptr<Claim>(), lastPeriodDC_, rebatesAccrual_));
         switch (model_) {
           case CreditDefaultSwap::ISDA:
-            swap_->setPricingEngine(boost::make_shared<IsdaCdsEngine>(
-                probability_, recoveryRate_, discountCurve_, false,
-                IsdaCdsEngine::Taylor, IsdaCdsEngine::HalfDayBias,
-                IsdaCdsEngine::Piecewise));
+            if (!isdaEngine_)
+                isdaEngine_ = boost::make_shared<IsdaCdsEngine>(
+                    probability_, recoveryRate_, discountCurve_, false,
+                    IsdaCdsEngine::Taylor, IsdaCdsEngine::HalfDayBias,
+                    IsdaCdsEngine::Piecewise);
+            swap_->setPricingEngine(isdaEngine_);
             break;
           case CreditDefaultSwap::Midpoint:
             swap_->setPricingEngine(boost::make_shared<MidPointCdsEngine>(
@@ -116,6 +116,9 @@ namespace QuantLib {
 
         Schedule schedule_;
         boost::shared_ptr<CreditDefaultSwap> swap_;
+        // kept when the swap is rebuilt, so that the ISDA engine can
+        // reuse the curve values it cached
+        boost::shared_ptr<PricingEngine> isdaEngine_;
         RelinkableHandle<DefaultProbabilityTermStructure> probability_;
         //! protection effective date.
         Date protectionStart_;
@@ -45,6 +45,65 @@
 
 namespace QuantLib {
 
+    /* Operator of the implicit time step of the Andreasen-Huge scheme.
+       The Thomas factorisation of 1 + dT*mapT is kept along with the
+       step and the volatilities it was built for, so that the put and
+       call prices, the calibration errors and the local volatilities of
+       a slice are obtained by back substitution only.
+    */
+    class AndreasenHugeStepOperator : public TripleBandLinearOp {
+      public:
+        explicit AndreasenHugeStepOperator(
+            const boost::shared_ptr<FdmMesher>& mesher)
+        : TripleBandLinearOp(0, mesher),
+          n_(mesher->layout()->size()), dT_(Null<Real>()),
+          lowerDt_(n_), bet_(n_), tmp_(n_) {}
+
+        bool isFactorised(Time dT, const Array& sig) const {
+            return dT == dT_ && sig == sig_;
+        }
+
+        void factorise(Time dT, const Array& sig) {
+            dT_ = Null<Real>();
+
+            Real bet = diag_[0]*dT + 1.0;
+            QL_REQUIRE(bet != 0.0, "division by zero");
+            bet_[0] = 1.0/bet;
+            lowerDt_[0] = lower_[0]*dT;
+
+            for (Size j=1; j < n_; ++j) {
+                lowerDt_[j] = lower_[j]*dT;
+                tmp_[j] = (upper_[j-1]*dT)*bet_[j-1];
+
+                bet = 1.0 + (diag_[j]*dT - tmp_[j]*lowerDt_[j]);
+                QL_REQUIRE(bet != 0.0, "division by zero");
+                bet_[j] = 1.0/bet;
+            }
+
+            dT_ = dT;
+            sig_ = sig;
+        }
+
+        Disposable<Array> solve(const Array& r) const {
+            QL_REQUIRE(dT_ != Null<Real>(), "operator is not factorised");
+            QL_REQUIRE(r.size() == n_, "inconsistent size of rhs");
+
+            Array retVal(n_);
+            retVal[0] = r[0]*bet_[0];
+            for (Size j=1; j < n_; ++j)
+                retVal[j] = (r[j]-lowerDt_[j]*retVal[j-1])*bet_[j];
+            for (Size j=n_-1; j > 0; --j)
+                retVal[j-1] -= tmp_[j]*retVal[j];
+
+            return retVal;
+        }
+
+      private:
+        const Size n_;
+        Time dT_;
+        Array sig_, lowerDt_, bet_, tmp_;
+    };
+
     class AndreasenHugeCostFunction : public CostFunction {
       public:
         AndreasenHugeCostFunction(
@@ -53,6 +112,7 @@ namespace QuantLib {
             const Array& lnMarketStrikes,
             const Array& previousNPVs,
             const boost::shared_ptr<FdmMesherComposite> mesher,
+            const boost::shared_ptr<AndreasenHugeStepOperator>& mapT,
             Time dT,
             AndreasenHugeVolatilityInterpl::InterpolationType interpolationType)
         : marketNPVs_(marketNPVs),
@@ -70,7 +130,16 @@ namespace QuantLib {
           dxxMap_(SecondDerivativeOp(0, mesher_)),
           d2CdK2_(dxMap_.mult(Array(mesher->layout()->size(), -1.0))
                         .add(dxxMap_)),
-          mapT_  (0, mesher_) {
+          mapT_  (mapT) {
+        }
+
+        // whether the slice has the same mesher, time step and targets
+        bool sameTargets(const AndreasenHugeCostFunction& c) const {
+            return mesher_ == c.mesher_ && dT_ == c.dT_
+                && interpolationType_ == c.interpolationType_
+                && lnMarketStrikes_ == c.lnMarketStrikes_
+                && marketNPVs_ == c.marketNPVs_
+                && marketVegas_ == c.marketVegas_;
         }
 
         Disposable<Array> d2CdK2(const Array& c) const {
@@ -80,6 +149,47 @@ namespace QuantLib {
         Disposable<Array> solveFor(
             Time dT, const Array& sig, const Array& b) const {
 
+            if (!mapT_->isFactorised(dT, sig)) {
+                setOperator(sig);
+                mapT_->factorise(dT, sig);
+            }
+
+            return mapT_->solve(b);
+        }
+
+        Disposable<Array> apply(const Array& c) const {
+            return -mapT_->apply(c);
+        }
+
+        Disposable<Array> values(const Array& sig) const {
+            Array newNPVs = solveFor(dT_, sig, previousNPVs_);
+
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+
+            const MonotonicCubicNaturalSpline interpl(
+                gridPoints.begin(), gridPoints.end(), newNPVs.begin());
+
+            Array retVal(lnMarketStrikes_.size());
+            for (Size i=0; i < retVal.size(); ++i) {
+                const Real strike = lnMarketStrikes_[i];
+                retVal[i] = interpl(strike) - marketNPVs_[i];
+            }
+            return retVal;
+        }
+
+        Disposable<Array> vegaCalibrationError(const Array& sig) const {
+            return values(sig)/marketVegas_;
+        }
+
+        Disposable<Array> initialValues() const {
+            Array retVal(lnMarketStrikes_.size(), 0.25);
+            return retVal;
+        }
+
+
+      private:
+        void setOperator(const Array& sig) const {
             Array x(lnMarketStrikes_.size());
             Interpolation sigInterpl;
 
@@ -123,43 +233,9 @@ namespace QuantLib {
                 z[i] = 0.5*vol*vol;
             }
 
-            mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
-            return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
-
-        }
-
-        Disposable<Array> apply(const Array& c) const {
-            return -mapT_.apply(c);
-        }
-
-        Disposable<Array> values(const Array& sig) const {
-            Array newNPVs = solveFor(dT_, sig, previousNPVs_);
-
-            const std::vector<Real>& gridPoints =
-                mesher_->getFdm1dMeshers().front()->locations();
-
-            const MonotonicCubicNaturalSpline interpl(
-                gridPoints.begin(), gridPoints.end(), newNPVs.begin());
-
-            Array retVal(lnMarketStrikes_.size());
-            for (Size i=0; i < retVal.size(); ++i) {
-                const Real strike = lnMarketStrikes_[i];
-                retVal[i] = interpl(strike) - marketNPVs_[i];
-            }
-            return retVal;
-        }
-
-        Disposable<Array> vegaCalibrationError(const Array& sig) const {
-            return values(sig)/marketVegas_;
+            mapT_->axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
         }
 
-        Disposable<Array> initialValues() const {
-            Array retVal(lnMarketStrikes_.size(), 0.25);
-            return retVal;
-        }
-
-
-      private:
         const Array marketNPVs_, marketVegas_;
         const Array lnMarketStrikes_, previousNPVs_;
         const boost::shared_ptr<FdmMesherComposite> mesher_;
@@ -171,7 +247,7 @@ namespace QuantLib {
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
-        mutable TripleBandLinearOp mapT_;
+        const boost::shared_ptr<AndreasenHugeStepOperator> mapT_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -231,7 +307,8 @@ namespace QuantLib {
         Real _minStrike,
         Real _maxStrike,
         const boost::shared_ptr<OptimizationMethod>& optimizationMethod,
-        const EndCriteria& endCriteria)
+        const EndCriteria& endCriteria,
+        bool warmStart)
     : spot_(spot),
       rTS_(rTS),
       qTS_(qTS),
@@ -241,7 +318,9 @@ namespace QuantLib {
       minStrike_(_minStrike),
       maxStrike_(_maxStrike),
       optimizationMethod_(optimizationMethod),
-      endCriteria_(endCriteria) {
+      endCriteria_(endCriteria),
+      warmStart_(warmStart),
+      mesherSpot_(Null<Real>()) {
         QL_REQUIRE(nGridPoints > 2 && calibrationSet.size() > 0,
                 "undefined grid or calibration set");
 
@@ -313,7 +392,8 @@ namespace QuantLib {
     boost::shared_ptr<AndreasenHugeCostFunction>
         AndreasenHugeVolatilityInterpl::buildCostFunction(
         Size iExpiry, Option::Type optionType,
-        const Array& previousNPVs) const {
+        const Array& previousNPVs,
+        const boost::shared_ptr<AndreasenHugeStepOperator>& mapT) const {
 
         if (calibrationType_ != CallPut
             && (   (calibrationType_ == Call && optionType ==Option::Put)
@@ -360,11 +440,33 @@ namespace QuantLib {
             lnMarketStrikes,
             previousNPVs,
             mesher_,
+            mapT,
             dT_[iExpiry],
             interpolationType_);
     }
 
 
+    bool AndreasenHugeVolatilityInterpl::sameTargets(
+        const SingleStepCalibrationResult& result,
+        const boost::shared_ptr<AndreasenHugeCostFunction>& putCostFct,
+        const boost::shared_ptr<AndreasenHugeCostFunction>& callCostFct)
+    const {
+        return (!putCostFct
+                || putCostFct->sameTargets(*result.putCostFunction))
+            && (!callCostFct
+                || callCostFct->sameTargets(*result.callCostFunction));
+    }
+
+    const boost::shared_ptr<AndreasenHugeCostFunction>&
+    AndreasenHugeVolatilityInterpl::costFunction(
+        Size iExpiry, Option::Type optionType) const {
+        // the put and call cost functions share the step operator
+        const SingleStepCalibrationResult& result =
+            calibrationResults_[iExpiry];
+        return (optionType == Option::Call && result.callCostFunction)
+            ? result.callCostFunction : result.putCostFunction;
+    }
+
     void AndreasenHugeVolatilityInterpl::performCalculations() const {
         QL_REQUIRE(maxStrike() > minStrike(),
             "max strike must be greater than min strike");
@@ -376,19 +478,27 @@ namespace QuantLib {
             dT_[i] = expiryTimes_[i] - ( (i==0)? 0.0 : expiryTimes_[i-1]);
         }
 
-        mesher_ =
-            boost::make_shared<FdmMesherComposite>(
-                boost::make_shared<Concentrating1dMesher>(
-                    std::log(minStrike()/spot_->value()),
-                    std::log(maxStrike()/spot_->value()),
-                    nGridPoints_,
-                    std::pair<Real, Real>(0.0, 0.025)));
+        // the mesher only depends on the spot; keeping it allows to
+        // detect the expiries whose calibration is still valid
+        if (!mesher_ || spot_->value() != mesherSpot_) {
+            mesher_ =
+                boost::make_shared<FdmMesherComposite>(
+                    boost::make_shared<Concentrating1dMesher>(
+                        std::log(minStrike()/spot_->value()),
+                        std::log(maxStrike()/spot_->value()),
+                        nGridPoints_,
+                        std::pair<Real, Real>(0.0, 0.025)));
+            mesherSpot_ = spot_->value();
+        }
 
         gridPoints_ = mesher_->locations(0);
         gridInFwd_ = Exp(gridPoints_)*spot_->value();
 
         localVolCache_.clear();
-        calibrationResults_.clear();
+        priceCache_.clear();
+
+        std::vector<SingleStepCalibrationResult> previousResults;
+        previousResults.swap(calibrationResults_);
 
         avgError_ = 0.0;
         minError_ = std::numeric_limits<Real>::max();
@@ -405,29 +515,57 @@ namespace QuantLib {
             npvCalls[i]= PlainVanillaPayoff(Option::Call, strike)(1.0);
         }
 
+        bool unchanged = true;
         for (Size i=0; i < expiries_.size(); ++i) {
+            const boost::shared_ptr<AndreasenHugeStepOperator> mapT =
+                boost::make_shared<AndreasenHugeStepOperator>(mesher_);
+
             const boost::shared_ptr<AndreasenHugeCostFunction> putCostFct =
-                buildCostFunction(i, Option::Put, npvPuts);
+                buildCostFunction(i, Option::Put, npvPuts, mapT);
             const boost::shared_ptr<AndreasenHugeCostFunction> callCostFct =
-                buildCostFunction(i, Option::Call, npvCalls);
+                buildCostFunction(i, Option::Call, npvCalls, mapT);
+
+            // all previous expiries are unchanged, hence so are the
+            // prices this expiry starts from
+            unchanged = unchanged && i < previousResults.size()
+                && sameTargets(previousResults[i], putCostFct, callCostFct);
+
+            if (unchanged) {
+                const SingleStepCalibrationResult& previous =
+                    previousResults[i];
+                calibrationResults_.push_back(previous);
+
+                avgError_ += previous.sumError;
+                minError_ = std::min(minError_, previous.minError);
+                maxError_ = std::max(maxError_, previous.maxError);
+
+                if (i+1 < previousResults.size()) {
+                    npvPuts = previousResults[i+1].putNPVs;
+                    npvCalls = previousResults[i+1].callNPVs;
+                }
+                else {
+                    if (putCostFct)
+                        npvPuts = previous.putCostFunction->solveFor(
+                            dT_[i], previous.sigmas, npvPuts);
+                    if (callCostFct)
+                        npvCalls = previous.callCostFunction->solveFor(
+                            dT_[i], previous.sigmas, npvCalls);
+                }
+                continue;
+            }
 
             CombinedCostFunction costFunction(putCostFct, callCostFct);
 
             PositiveConstraint positiveConstraint;
-            Problem problem(costFunction,
-                positiveConstraint, costFunction.initialValues());
+            Problem problem(costFunction, positiveConstraint,
+                (warmStart_ && i < previousResults.size())
+                    ? previousResults[i].sigmas
+                    : costFunction.initialValues());
 
             optimizationMethod_->minimize(problem, endCriteria_);
 
             const Array& sig = problem.currentValue();
 
-            const SingleStepCalibrationResult calibrationResult = {
-                npvPuts, npvCalls, sig,
-                (calibrationType_ == Call)? callCostFct : putCostFct
-            };
-
-            calibrationResults_.push_back(calibrationResult);
-
             Array vegaDiffs(sig.size());
             switch (calibrationType_) {
               case CallPut: {
@@ -454,13 +592,20 @@ namespace QuantLib {
                 QL_FAIL("unknown calibration type");
             }
 
-            avgError_ +=
-                std::accumulate(vegaDiffs.begin(), vegaDiffs.end(), 0.0);
-            minError_ = std::min(minError_,
-                *std::min_element(vegaDiffs.begin(), vegaDiffs.end()));
-            maxError_ = std::max(maxError_,
-                *std::max_element(vegaDiffs.begin(), vegaDiffs.end()));
+            const SingleStepCalibrationResult calibrationResult = {
+                npvPuts, npvCalls, sig, putCostFct, callCostFct,
+                std::accumulate(vegaDiffs.begin(), vegaDiffs.end(), 0.0),
+                *std::min_element(vegaDiffs.begin(), vegaDiffs.end()),
+                *std::max_element(vegaDiffs.begin(), vegaDiffs.end())
+            };
+
+            calibrationResults_.push_back(calibrationResult);
+
+            avgError_ += calibrationResult.sumError;
+            minError_ = std::min(minError_, calibrationResult.minError);
+            maxError_ = std::max(maxError_, calibrationResult.maxError);
 
+            // the calibrated operator is already factorised
             if (putCostFct)
                 npvPuts = putCostFct->solveFor(dT_[i], sig, npvPuts);
             if (callCostFct)
@@ -525,7 +670,7 @@ namespace QuantLib {
 
         const Size iu = getExerciseTimeIdx(t);
 
-        return calibrationResults_[iu].costFunction->solveFor(
+        return costFunction(iu, optionType)->solveFor(
             (iu == 0) ? t : t-expiryTimes_[iu-1],
             calibrationResults_[iu].sigmas,
             (optionType == Option::Call)? calibrationResults_[iu].callNPVs
@@ -594,20 +739,18 @@ namespace QuantLib {
             (optionType == Option::Call)? calibrationResults_[iu].callNPVs
                                         : calibrationResults_[iu].putNPVs;
 
-        const boost::shared_ptr<AndreasenHugeCostFunction> costFunction
-            = calibrationResults_[iu].costFunction;
+        const boost::shared_ptr<AndreasenHugeCostFunction> costFct
+            = costFunction(iu, optionType);
 
         const Time dt = (iu == 0) ? t : t-expiryTimes_[iu-1];
         const Array& sig = calibrationResults_[iu].sigmas;
 
-        const Array cAtJ = costFunction->solveFor(dt, sig, previousNPVs);
+        const Array cAtJ = costFct->solveFor(dt, sig, previousNPVs);
 
         const Array dCdT =
-            costFunction->solveFor(dt, sig,
-                    costFunction->apply(
-                        costFunction->solveFor(dt, sig, previousNPVs)));
+            costFct->solveFor(dt, sig, costFct->apply(cAtJ));
 
-        const Array d2CdK2 = costFunction->d2CdK2(cAtJ);
+        const Array d2CdK2 = costFct->d2CdK2(cAtJ);
 
         Array localVol = Sqrt(2*dCdT/d2CdK2);
 
@@ -43,6 +43,7 @@ namespace QuantLib {
     class YieldTermStructure;
     class FdmMesherComposite;
     class AndreasenHugeCostFunction;
+    class AndreasenHugeStepOperator;
 
     //! Calibration of a local volatility surface to a sparse grid of options
 
@@ -50,6 +51,14 @@ namespace QuantLib {
 
         Andreasen J., Huge B., 2010. Volatility Interpolation
         https://ssrn.com/abstract=1694972
+
+        The expiries are calibrated one after the other. When quotes
+        change, the leading expiries whose quotes, forwards and times
+        are unchanged keep their previous calibration, and the
+        calibration restarts from the first changed expiry. When
+        \c warmStart is set, the recalibrated expiries start from their
+        previous volatilities instead of a flat guess; this is faster,
+        but makes results depend slightly on the calibration history.
     */
 
     class AndreasenHugeVolatilityInterpl : public LazyObject {
@@ -76,7 +85,8 @@ namespace QuantLib {
             const boost::shared_ptr<OptimizationMethod>& optimizationMethod =
                 boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt),
             const EndCriteria& endCriteria =
-                EndCriteria(500, 100, 1e-12, 1e-10, 1e-10));
+                EndCriteria(500, 100, 1e-12, 1e-10, 1e-10),
+            bool warmStart = false);
 
         Date maxDate() const;
         Real minStrike() const;
@@ -106,12 +116,23 @@ namespace QuantLib {
 
         struct SingleStepCalibrationResult {
             Array putNPVs, callNPVs, sigmas;
-            boost::shared_ptr<AndreasenHugeCostFunction> costFunction;
+            boost::shared_ptr<AndreasenHugeCostFunction>
+                putCostFunction, callCostFunction;
+            Real sumError, minError, maxError;
         };
 
         boost::shared_ptr<AndreasenHugeCostFunction> buildCostFunction(
             Size iExpiry, Option::Type optionType,
-            const Array& previousNPVs) const;
+            const Array& previousNPVs,
+            const boost::shared_ptr<AndreasenHugeStepOperator>& mapT) const;
+
+        bool sameTargets(const SingleStepCalibrationResult& result,
+            const boost::shared_ptr<AndreasenHugeCostFunction>& putCostFct,
+            const boost::shared_ptr<AndreasenHugeCostFunction>& callCostFct)
+            const;
+
+        const boost::shared_ptr<AndreasenHugeCostFunction>&
+            costFunction(Size iExpiry, Option::Type optionType) const;
 
         Size getExerciseTimeIdx(Time t) const;
 
@@ -136,6 +157,7 @@ namespace QuantLib {
 
         const boost::shared_ptr<OptimizationMethod> optimizationMethod_;
         const EndCriteria endCriteria_;
+        const bool warmStart_;
 
         std::vector<Real> strikes_;
         std::vector<Date> expiries_;
@@ -145,6 +167,7 @@ namespace QuantLib {
         mutable Real avgError_, minError_, maxError_;
 
         mutable boost::shared_ptr<FdmMesherComposite> mesher_;
+        mutable Real mesherSpot_;
         mutable Array gridPoints_, gridInFwd_;
 
         mutable std::vector<SingleStepCalibrationResult> calibrationResults_;
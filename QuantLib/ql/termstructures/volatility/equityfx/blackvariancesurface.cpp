@@ -20,9 +20,28 @@
 
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // gives access to the derivatives of the implementation
+        class Interpolation2DDerivatives : public Interpolation2D {
+          public:
+            explicit Interpolation2DDerivatives(const Interpolation2D& i)
+            : Interpolation2D(i) {}
+            boost::shared_ptr<detail::BicubicSplineDerivatives>
+            bicubic() const {
+                return boost::dynamic_pointer_cast<
+                    detail::BicubicSplineDerivatives>(impl_);
+            }
+        };
+
+    }
+
     BlackVarianceSurface::BlackVarianceSurface(
                                   const Date& referenceDate,
                                   const Calendar& cal,
@@ -64,17 +83,27 @@ namespace QuantLib {
         setInterpolation<Bilinear>();
     }
 
+    Real BlackVarianceSurface::clampedStrike(
+                                  Real strike,
+                                  const std::vector<Real>& strikes,
+                                  Extrapolation lowerExtrapolation,
+                                  Extrapolation upperExtrapolation) {
+        // enforce constant extrapolation when required
+        if (strike < strikes.front()
+            && lowerExtrapolation == ConstantExtrapolation)
+            strike = strikes.front();
+        if (strike > strikes.back()
+            && upperExtrapolation == ConstantExtrapolation)
+            strike = strikes.back();
+        return strike;
+    }
+
     Real BlackVarianceSurface::blackVarianceImpl(Time t, Real strike) const {
 
         if (t==0.0) return 0.0;
 
-        // enforce constant extrapolation when required
-        if (strike < strikes_.front()
-            && lowerExtrapolation_ == ConstantExtrapolation)
-            strike = strikes_.front();
-        if (strike > strikes_.back()
-            && upperExtrapolation_ == ConstantExtrapolation)
-            strike = strikes_.back();
+        strike = clampedStrike(strike, strikes_,
+                               lowerExtrapolation_, upperExtrapolation_);
 
         if (t<=times_.back())
             return varianceSurface_(t, strike, true);
@@ -83,5 +112,156 @@ namespace QuantLib {
                 t/times_.back();
     }
 
-}
+    void BlackVarianceSurface::initializeSlices() {
+        strikeVariances_.clear();
+        for (Size i=0; i<strikes_.size(); ++i) {
+            switch (sliceInterpolation_) {
+              case LinearSlice:
+                strikeVariances_.push_back(LinearInterpolation(
+                    times_.begin(), times_.end(), variances_.row_begin(i)));
+                break;
+              case CubicSlice:
+                // same splines as in the bicubic interpolation
+                strikeVariances_.push_back(CubicInterpolation(
+                    times_.begin(), times_.end(), variances_.row_begin(i),
+                    CubicInterpolation::Spline, false,
+                    CubicInterpolation::SecondDerivative, 0.0,
+                    CubicInterpolation::SecondDerivative, 0.0));
+                break;
+              default:
+                break;
+            }
+        }
+        #pragma omp critical(ql_black_variance_surface_slices)
+        slices_.clear();
+    }
+
+    void BlackVarianceSurface::updateInterpolations() {
+        varianceSurface_.update();
+        for (Size i=0; i<strikeVariances_.size(); ++i)
+            strikeVariances_[i].update();
+        #pragma omp critical(ql_black_variance_surface_slices)
+        slices_.clear();
+        notifyObservers();
+    }
 
+    void BlackVarianceSurface::setVolatility(Size strikeIndex,
+                                             Size dateIndex,
+                                             Volatility volatility) {
+        QL_REQUIRE(strikeIndex < strikes_.size(),
+                   "strike index (" << strikeIndex << ") out of range");
+        QL_REQUIRE(dateIndex+1 < times_.size(),
+                   "date index (" << dateIndex << ") out of range");
+        const Time t = times_[dateIndex+1];
+        variances_[strikeIndex][dateIndex+1] = t*volatility*volatility;
+        updateInterpolations();
+    }
+
+    void BlackVarianceSurface::setVolatilities(const Matrix& blackVolMatrix) {
+        QL_REQUIRE(blackVolMatrix.rows() == strikes_.size() &&
+                   blackVolMatrix.columns()+1 == times_.size(),
+                   "volatility matrix (" << blackVolMatrix.rows() << "x"
+                   << blackVolMatrix.columns() << ") does not match the "
+                   << strikes_.size() << "x" << times_.size()-1
+                   << " quotes of the surface");
+        for (Size j=1; j<times_.size(); ++j) {
+            for (Size i=0; i<strikes_.size(); ++i) {
+                variances_[i][j] = times_[j] *
+                    blackVolMatrix[i][j-1]*blackVolMatrix[i][j-1];
+            }
+        }
+        updateInterpolations();
+    }
+
+    boost::shared_ptr<const BlackVarianceSurface::Slice>
+    BlackVarianceSurface::slice(Time t) const {
+        boost::shared_ptr<Slice> s;
+        #pragma omp critical(ql_black_variance_surface_slices)
+        {
+            std::map<Time, boost::shared_ptr<Slice> >::const_iterator i =
+                slices_.find(t);
+            if (i != slices_.end()) {
+                s = i->second;
+            } else {
+                // bounded, in case the surface is queried at many times
+                if (slices_.size() >= 1000)
+                    slices_.clear();
+                s = boost::shared_ptr<Slice>(new Slice(*this, t));
+                slices_[t] = s;
+            }
+        }
+        return s;
+    }
+
+    BlackVarianceSurface::Slice::Slice(const BlackVarianceSurface& surface,
+                                       Time t)
+    : t_(t), tMax_(surface.times_.back()), strikes_(surface.strikes_),
+      lowerExtrapolation_(surface.lowerExtrapolation_),
+      upperExtrapolation_(surface.upperExtrapolation_) {
+        QL_REQUIRE(t >= 0.0, "negative time (" << t << ") given");
+        if (surface.sliceInterpolation_ == NoSlice) {
+            times_ = surface.times_;
+            surfaceVariances_ = surface.variances_;
+            varianceSurface_ =
+                surface.interpolate_(times_, strikes_, surfaceVariances_);
+            return;
+        }
+        const Time tSlice = std::min(t, tMax_);
+        variances_.resize(strikes_.size());
+        for (Size i=0; i<variances_.size(); ++i)
+            variances_[i] = surface.strikeVariances_[i](tSlice, true);
+        if (surface.sliceInterpolation_ == LinearSlice)
+            interpolation_ = LinearInterpolation(strikes_.begin(),
+                                                 strikes_.end(),
+                                                 variances_.begin());
+        else
+            interpolation_ = CubicInterpolation(
+                strikes_.begin(), strikes_.end(),
+                variances_.begin(),
+                CubicInterpolation::Spline, false,
+                CubicInterpolation::SecondDerivative, 0.0,
+                CubicInterpolation::SecondDerivative, 0.0);
+    }
+
+    Real BlackVarianceSurface::Slice::blackVariance(Real strike) const {
+        if (t_==0.0) return 0.0;
+        strike = clampedStrike(strike, strikes_,
+                               lowerExtrapolation_, upperExtrapolation_);
+        if (interpolation_.empty()) {
+            // no one-dimensional counterpart of the interpolation
+            if (t_<=tMax_)
+                return varianceSurface_(t_, strike, true);
+            else
+                return varianceSurface_(tMax_, strike, true) *
+                    t_/tMax_;
+        }
+        if (t_<=tMax_)
+            return interpolation_(strike, true);
+        else
+            return interpolation_(strike, true) * t_/tMax_;
+    }
+
+    Volatility BlackVarianceSurface::Slice::blackVol(Real strike) const {
+        QL_REQUIRE(t_ > 0.0, "null time for slice volatility");
+        return std::sqrt(blackVariance(strike)/t_);
+    }
+
+    bool BlackVarianceSurface::varianceDerivatives(Time t, Real strike,
+                                                   Real& dwdt, Real& dwdk,
+                                                   Real& d2wdk2) const {
+        if (t <= 0.0 || t > times_.back()
+            || strike < strikes_.front() || strike > strikes_.back())
+            return false;
+
+        boost::shared_ptr<detail::BicubicSplineDerivatives> bicubic =
+            Interpolation2DDerivatives(varianceSurface_).bicubic();
+        if (!bicubic)
+            return false;
+
+        dwdt = bicubic->derivativeX(t, strike);
+        dwdk = bicubic->derivativeY(t, strike);
+        d2wdk2 = bicubic->secondDerivativeY(t, strike);
+        return true;
+    }
+
+}
@@ -28,10 +28,17 @@
 #include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/interpolations/interpolation2d.hpp>
+#include <ql/math/interpolation.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/function.hpp>
+#include <map>
 
 namespace QuantLib {
 
+    class Bilinear;
+    class Bicubic;
+
     //! Black volatility surface modelled as variance surface
     /*! This class calculates time/strike dependent Black volatilities
         using as input a matrix of Black volatilities observed in the
@@ -41,6 +48,16 @@ namespace QuantLib {
         surface.  Bilinear interpolation is used as default; this can
         be changed by the setInterpolation() method.
 
+        For bilinear and bicubic interpolation, the variances at a
+        given time can be obtained as a Slice, i.e., a one-dimensional
+        interpolation in strike of the variances interpolated in time
+        on each quoted strike. Slices are built on first use and
+        cached per time, so that engines querying the same times over
+        and over (e.g., Monte Carlo engines on a fixed time grid) can
+        hold them and skip the two-dimensional lookup; blackVariance()
+        itself always uses the two-dimensional interpolation. With
+        bicubic interpolation the slice reproduces the surface exactly.
+
         \todo check time extrapolation
 
     */
@@ -74,6 +91,27 @@ namespace QuantLib {
             return strikes_.back();
         }
         //@}
+        //! \name Inspectors
+        //@{
+        /*! returns the derivatives of the Black variance with respect
+            to time and strike when the interpolation provides them
+            analytically (e.g., bicubic splines) and the point lies
+            within the quoted times and strikes; returns false
+            otherwise.
+        */
+        bool varianceDerivatives(Time t, Real strike,
+                                 Real& dwdt, Real& dwdk,
+                                 Real& d2wdk2) const;
+        //@}
+        //! \name Slices
+        //@{
+        class Slice;
+        /*! returns the variances at the given time; the slice is
+            cached, and does not follow later modifications of the
+            surface.
+        */
+        boost::shared_ptr<const Slice> slice(Time t) const;
+        //@}
         //! \name Modifiers
         //@{
         template <class Interpolator>
@@ -82,8 +120,20 @@ namespace QuantLib {
                 i.interpolate(times_.begin(), times_.end(),
                               strikes_.begin(), strikes_.end(),
                               variances_);
+            interpolate_ = Interpolate<Interpolator>(i);
+            sliceInterpolation_ = sliceInterpolation(i);
+            initializeSlices();
             notifyObservers();
         }
+        /*! replaces the volatility quoted at the given strike and date
+            indices; the interpolation is updated in place.
+        */
+        void setVolatility(Size strikeIndex, Size dateIndex,
+                           Volatility volatility);
+        /*! replaces all the quoted volatilities; the matrix must have
+            the dimensions of the one passed to the constructor.
+        */
+        void setVolatilities(const Matrix& blackVolMatrix);
         //@}
         //! \name Visitability
         //@{
@@ -92,13 +142,81 @@ namespace QuantLib {
       protected:
         virtual Real blackVarianceImpl(Time t, Real strike) const;
       private:
+        // one-dimensional interpolations consistent with the surface
+        enum SliceInterpolation { NoSlice, LinearSlice, CubicSlice };
+        template <class Interpolator>
+        static SliceInterpolation sliceInterpolation(const Interpolator&) {
+            return NoSlice;
+        }
+        static SliceInterpolation sliceInterpolation(const Bilinear&) {
+            return LinearSlice;
+        }
+        static SliceInterpolation sliceInterpolation(const Bicubic&) {
+            return CubicSlice;
+        }
+        // builds the surface interpolation on the given data
+        template <class Interpolator>
+        class Interpolate {
+          public:
+            explicit Interpolate(const Interpolator& i) : i_(i) {}
+            Interpolation2D operator()(const std::vector<Time>& times,
+                                       const std::vector<Real>& strikes,
+                                       const Matrix& variances) const {
+                return i_.interpolate(times.begin(), times.end(),
+                                      strikes.begin(), strikes.end(),
+                                      variances);
+            }
+          private:
+            Interpolator i_;
+        };
+        void initializeSlices();
+        void updateInterpolations();
+        static Real clampedStrike(Real strike,
+                                  const std::vector<Real>& strikes,
+                                  Extrapolation lowerExtrapolation,
+                                  Extrapolation upperExtrapolation);
         DayCounter dayCounter_;
         Date maxDate_;
         std::vector<Real> strikes_;
         std::vector<Time> times_;
         Matrix variances_;
         Interpolation2D varianceSurface_;
+        boost::function<Interpolation2D(const std::vector<Time>&,
+                                        const std::vector<Real>&,
+                                        const Matrix&)> interpolate_;
+        Extrapolation lowerExtrapolation_, upperExtrapolation_;
+        SliceInterpolation sliceInterpolation_;
+        // time interpolations of the variances on each quoted strike
+        std::vector<Interpolation> strikeVariances_;
+        mutable std::map<Time, boost::shared_ptr<Slice> > slices_;
+    };
+
+    //! Black variances of a BlackVarianceSurface at a given time
+    /*! No range checks are performed; strikes are extrapolated as
+        by the surface. A slice holds copies of the data it needs, so
+        that it can be kept after the surface is gone.
+    */
+    class BlackVarianceSurface::Slice : private boost::noncopyable {
+      public:
+        Time time() const { return t_; }
+        Real blackVariance(Real strike) const;
+        //! requires a positive time
+        Volatility blackVol(Real strike) const;
+      private:
+        friend class BlackVarianceSurface;
+        Slice(const BlackVarianceSurface& surface, Time t);
+        Time t_, tMax_;
+        std::vector<Real> strikes_;
         Extrapolation lowerExtrapolation_, upperExtrapolation_;
+        // variances on the quoted strikes, at the time of the slice
+        // or at the last quoted time when beyond it
+        std::vector<Real> variances_;
+        Interpolation interpolation_;
+        // copy of the surface, for interpolations without a
+        // one-dimensional counterpart
+        std::vector<Time> times_;
+        Matrix surfaceVariances_;
+        Interpolation2D varianceSurface_;
     };
 
 
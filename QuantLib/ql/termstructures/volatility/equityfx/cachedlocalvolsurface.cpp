@@ -0,0 +1,245 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/cachedlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Dupire's formula in terms of the total variance w(t,y),
+        // y = log(K/F); see LocalVolSurface
+        Volatility dupireLocalVol(Real strike, Time t, Real y, Real w,
+                                  Real dwdy, Real d2wdy2, Real dwdt) {
+            if (dwdy==0.0 && d2wdy2==0.0) // avoid /w where w might be 0.0
+                return std::sqrt(dwdt);
+
+            Real den1 = 1.0 - y/w*dwdy;
+            Real den2 = 0.25*(-0.25 - 1.0/w + y*y/w/w)*dwdy*dwdy;
+            Real den3 = 0.5*d2wdy2;
+            Real result = dwdt / (den1+den2+den3);
+
+            QL_ENSURE(result>=0.0,
+                      "negative local vol^2 at strike " << strike
+                      << " and time " << t
+                      << "; the black vol surface is not smooth enough");
+
+            return std::sqrt(result);
+        }
+
+    }
+
+    CachedLocalVolSurface::CachedLocalVolSurface(
+                                 const Handle<BlackVolTermStructure>& blackTS,
+                                 const Handle<YieldTermStructure>& riskFreeTS,
+                                 const Handle<YieldTermStructure>& dividendTS,
+                                 const Handle<Quote>& underlying,
+                                 const std::vector<Time>& times,
+                                 Real minStrike,
+                                 Real maxStrike,
+                                 Size strikeGridPoints,
+                                 StrikeInterpolation interpolation)
+    : LocalVolTermStructure(blackTS->businessDayConvention(),
+                            blackTS->dayCounter()),
+      blackTS_(blackTS), riskFreeTS_(riskFreeTS), dividendTS_(dividendTS),
+      underlying_(underlying), times_(times),
+      interpolation_(interpolation) {
+
+        QL_REQUIRE(!times_.empty(), "no times given");
+        QL_REQUIRE(times_.front() >= 0.0, "negative time given");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        QL_REQUIRE(minStrike > 0.0 && maxStrike > minStrike,
+                   "invalid strike range [" << minStrike << ", "
+                   << maxStrike << "]");
+        QL_REQUIRE(strikeGridPoints >= 3,
+                   "at least three strike grid points are required");
+
+        logStrikes_.resize(strikeGridPoints);
+        const Real xMin = std::log(minStrike), xMax = std::log(maxStrike);
+        dx_ = (xMax - xMin)/(strikeGridPoints - 1);
+        for (Size j=0; j<strikeGridPoints; ++j)
+            logStrikes_[j] = xMin + j*dx_;
+        logStrikes_.back() = xMax;
+
+        registerWith(blackTS_);
+        registerWith(riskFreeTS_);
+        registerWith(dividendTS_);
+        registerWith(underlying_);
+    }
+
+    const Date& CachedLocalVolSurface::referenceDate() const {
+        return blackTS_->referenceDate();
+    }
+
+    DayCounter CachedLocalVolSurface::dayCounter() const {
+        return blackTS_->dayCounter();
+    }
+
+    Date CachedLocalVolSurface::maxDate() const {
+        return blackTS_->maxDate();
+    }
+
+    Real CachedLocalVolSurface::minStrike() const {
+        return blackTS_->minStrike();
+    }
+
+    Real CachedLocalVolSurface::maxStrike() const {
+        return blackTS_->maxStrike();
+    }
+
+    void CachedLocalVolSurface::update() {
+        // it dispatches notifications only if (!calculated_ && !frozen_)
+        LazyObject::update();
+
+        // TermStructure::update() update part
+        if (moving_)
+            updated_ = false;
+    }
+
+    const Matrix& CachedLocalVolSurface::gridLocalVols() const {
+        calculate();
+        return vols_;
+    }
+
+    void CachedLocalVolSurface::performCalculations() const {
+
+        const Size nt = times_.size(), nx = logStrikes_.size();
+        vols_ = Matrix(nt, nx);
+
+        const boost::shared_ptr<BlackVarianceSurface> surface =
+            boost::dynamic_pointer_cast<BlackVarianceSurface>(
+                                                    blackTS_.currentLink());
+        const LocalVolSurface localVol(blackTS_, riskFreeTS_,
+                                       dividendTS_, underlying_);
+        const Real spot = underlying_->value();
+
+        for (Size i=0; i<nt; ++i) {
+            const Time t = times_[i];
+
+            Real forward = Null<Real>(), mu = Null<Real>();
+            if (surface && t > 0.0) {
+                forward = spot*dividendTS_->discount(t, true)
+                              /riskFreeTS_->discount(t, true);
+                // drift of the log-forward
+                const Time dt = std::min<Time>(0.0001, t/2.0);
+                mu = (std::log(dividendTS_->discount(t+dt, true)
+                               /riskFreeTS_->discount(t+dt, true))
+                      - std::log(dividendTS_->discount(t-dt, true)
+                                 /riskFreeTS_->discount(t-dt, true)))
+                     / (2.0*dt);
+            }
+
+            for (Size j=0; j<nx; ++j) {
+                const Real strike = std::exp(logStrikes_[j]);
+                Real dwdt, dwdk, d2wdk2;
+                if (forward != Null<Real>()
+                    && surface->varianceDerivatives(t, strike,
+                                                    dwdt, dwdk, d2wdk2)) {
+                    const Real w = surface->blackVariance(t, strike, true);
+                    const Real y = std::log(strike/forward);
+                    const Real dwdy = strike*dwdk;
+                    const Real d2wdy2 = strike*strike*d2wdk2 + dwdy;
+                    // time derivative at constant moneyness
+                    vols_[i][j] = dupireLocalVol(strike, t, y, w,
+                                                 dwdy, d2wdy2,
+                                                 dwdt + dwdy*mu);
+                } else {
+                    vols_[i][j] = localVol.localVol(t, strike, true);
+                }
+            }
+        }
+
+        if (interpolation_ == CubicInLogStrike) {
+            a_ = b_ = c_ = Matrix(nt, nx-1);
+            for (Size i=0; i<nt; ++i) {
+                CubicNaturalSpline spline(logStrikes_.begin(),
+                                          logStrikes_.end(),
+                                          vols_.row_begin(i));
+                std::copy(spline.aCoefficients().begin(),
+                          spline.aCoefficients().end(), a_.row_begin(i));
+                std::copy(spline.bCoefficients().begin(),
+                          spline.bCoefficients().end(), b_.row_begin(i));
+                std::copy(spline.cCoefficients().begin(),
+                          spline.cCoefficients().end(), c_.row_begin(i));
+            }
+        }
+    }
+
+    Real CachedLocalVolSurface::sliceValue(Size i, Size j, Real dx) const {
+        if (interpolation_ == CubicInLogStrike)
+            return vols_[i][j] + dx*(a_[i][j] + dx*(b_[i][j] + dx*c_[i][j]));
+        else
+            return vols_[i][j] + (vols_[i][j+1]-vols_[i][j])*dx/dx_;
+    }
+
+    void CachedLocalVolSurface::locateTime(Time t, Size& i,
+                                           Real& weight) const {
+        if (t <= times_.front()) {
+            i = 0;
+            weight = 0.0;
+        } else if (t >= times_.back()) {
+            i = times_.size()-1;
+            weight = 0.0;
+        } else {
+            i = std::upper_bound(times_.begin(), times_.end(), t)
+              - times_.begin() - 1;
+            weight = (t-times_[i])/(times_[i+1]-times_[i]);
+        }
+    }
+
+    Real CachedLocalVolSurface::lookup(Size i, Real weight,
+                                       Real strike) const {
+        // the grid is equally spaced in log-strike
+        const Real x = std::min(logStrikes_.back(),
+                                std::max(logStrikes_.front(),
+                                         std::log(strike)));
+        const Size j = std::min<Size>(
+            logStrikes_.size()-2,
+            static_cast<Size>((x - logStrikes_.front())/dx_));
+        const Real dx = x - logStrikes_[j];
+
+        const Real v0 = sliceValue(i, j, dx);
+        if (weight == 0.0)
+            return v0;
+        return v0 + (sliceValue(i+1, j, dx)-v0)*weight;
+    }
+
+    Volatility CachedLocalVolSurface::localVolImpl(Time t,
+                                                   Real strike) const {
+        calculate();
+        Size i;
+        Real weight;
+        locateTime(t, i, weight);
+        return lookup(i, weight, strike);
+    }
+
+    void CachedLocalVolSurface::localVolsImpl(Time t, const Array& strikes,
+                                              Array& vols) const {
+        calculate();
+        Size i;
+        Real weight;
+        locateTime(t, i, weight);
+        for (Size k=0; k<strikes.size(); ++k)
+            vols[k] = lookup(i, weight, strikes[k]);
+    }
+
+}
@@ -0,0 +1,112 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cachedlocalvolsurface.hpp
+    \brief Local volatility surface tabulated on a time/log-strike grid
+*/
+
+#ifndef quantlib_cached_local_vol_surface_hpp
+#define quantlib_cached_local_vol_surface_hpp
+
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! Local volatility surface derived from a Black vol surface on a grid
+    /*! The Dupire local volatility of the given Black surface is
+        computed once on a grid of times and equally spaced
+        log-strikes, and looked up afterwards; the grid is rebuilt
+        lazily when any of the underlying market data notify a change.
+
+        When the Black surface is a BlackVarianceSurface whose
+        interpolation provides analytic derivatives (e.g., bicubic
+        splines) these are used to build the grid; otherwise each
+        node is calculated by a LocalVolSurface, i.e., by finite
+        differences of the Black variance.
+
+        Lookups interpolate linearly or with natural cubic splines in
+        log-strike and linearly in time; values are extrapolated flat
+        outside the grid.
+
+        \warning the accuracy of the lookup depends on the grid; it
+                 is meant for engines querying the surface many times
+                 at points not known in advance.
+    */
+    class CachedLocalVolSurface : public LocalVolTermStructure,
+                                  public LazyObject {
+      public:
+        enum StrikeInterpolation { LinearInLogStrike, CubicInLogStrike };
+        CachedLocalVolSurface(const Handle<BlackVolTermStructure>& blackTS,
+                              const Handle<YieldTermStructure>& riskFreeTS,
+                              const Handle<YieldTermStructure>& dividendTS,
+                              const Handle<Quote>& underlying,
+                              const std::vector<Time>& times,
+                              Real minStrike,
+                              Real maxStrike,
+                              Size strikeGridPoints,
+                              StrikeInterpolation interpolation
+                                                      = LinearInLogStrike);
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const;
+        DayCounter dayCounter() const;
+        Date maxDate() const;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const;
+        Real maxStrike() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        const std::vector<Real>& logStrikes() const { return logStrikes_; }
+        //! local volatilities on the grid (times by log-strikes)
+        const Matrix& gridLocalVols() const;
+        //@}
+      protected:
+        Volatility localVolImpl(Time, Real) const;
+        void localVolsImpl(Time, const Array&, Array&) const;
+        void performCalculations() const;
+      private:
+        // slice i and weight of slice i+1 for time t
+        void locateTime(Time t, Size& i, Real& weight) const;
+        Real lookup(Size i, Real weight, Real strike) const;
+        Real sliceValue(Size i, Size j, Real dx) const;
+        Handle<BlackVolTermStructure> blackTS_;
+        Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
+        Handle<Quote> underlying_;
+        std::vector<Time> times_;
+        std::vector<Real> logStrikes_;
+        Real dx_;
+        StrikeInterpolation interpolation_;
+        // local vols and, for cubic interpolation, the spline
+        // coefficients of each time slice
+        mutable Matrix vols_, a_, b_, c_;
+    };
+
+}
+
+#endif
@@ -157,6 +157,22 @@ namespace QuantLib {
         const Size idx = std::distance(times_.begin(),
             std::lower_bound(times_.begin(), times_.end(), t));
 
+        return localVolAt(t, idx, strike);
+    }
+
+    void FixedLocalVolSurface::localVolsImpl(Time t, const Array& strikes,
+                                             Array& vols) const {
+        t = std::min(times_.back(), std::max(t, times_.front()));
+
+        const Size idx = std::distance(times_.begin(),
+            std::lower_bound(times_.begin(), times_.end(), t));
+
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = localVolAt(t, idx, strikes[i]);
+    }
+
+    Volatility FixedLocalVolSurface::localVolAt(Time t, Size idx,
+                                                Real strike) const {
         if (close_enough(t, times_[idx])) {
             if (strikes_[idx]->front() < strikes_[idx]->back())
                 return localVolInterpol_[idx](strike, true);
@@ -84,6 +84,7 @@ namespace QuantLib {
 
       protected:
         Volatility localVolImpl(Time t, Real strike) const;
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const;
 
         const Date maxDate_;
         std::vector<Time> times_;
@@ -95,6 +96,8 @@ namespace QuantLib {
 
       private:
         void checkSurface();
+        // t within the time range, idx the first time not before t
+        Volatility localVolAt(Time t, Size idx, Real strike) const;
     };
 }
 
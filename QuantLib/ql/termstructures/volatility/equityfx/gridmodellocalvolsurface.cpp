@@ -85,6 +85,12 @@ namespace QuantLib {
         return localVol_->localVol(t, strike, true);
     }
 
+    void GridModelLocalVolSurface::localVolsImpl(Time t,
+                                                 const Array& strikes,
+                                                 Array& vols) const {
+        localVol_->localVols(t, strikes, vols, true);
+    }
+
     void GridModelLocalVolSurface::generateArguments() {
         const boost::shared_ptr<Matrix> localVolMatrix(
             new Matrix(strikes_.front()->size(), times_.size()));
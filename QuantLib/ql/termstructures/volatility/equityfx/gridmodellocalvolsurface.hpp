@@ -55,6 +55,7 @@ namespace QuantLib {
       protected:
         void generateArguments();
         Volatility localVolImpl(Time t, Real strike) const;
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const;
 
         const Date referenceDate_;
         std::vector<Time> times_;
@@ -68,6 +68,7 @@ namespace QuantLib {
         //@}
       private:
         Volatility localVolImpl(Time, Real) const;
+        void localVolsImpl(Time, const Array&, Array& vols) const;
         Handle<Quote> volatility_;
         DayCounter dayCounter_;
     };
@@ -119,6 +120,11 @@ namespace QuantLib {
         return volatility_->value();
     }
 
+    inline void LocalConstantVol::localVolsImpl(Time, const Array&,
+                                                Array& vols) const {
+        std::fill(vols.begin(), vols.end(), volatility_->value());
+    }
+
 }
 
 
@@ -68,6 +68,7 @@ namespace QuantLib {
         //@}
       protected:
         Volatility localVolImpl(Time, Real) const;
+        void localVolsImpl(Time, const Array&, Array& vols) const;
       private:
         Handle<BlackVarianceCurve> blackVarianceCurve_;
     };
@@ -106,6 +107,13 @@ namespace QuantLib {
         return std::sqrt(derivative);
     }
 
+    inline void LocalVolCurve::localVolsImpl(Time t, const Array& strikes,
+                                             Array& vols) const {
+        if (!strikes.empty())
+            std::fill(vols.begin(), vols.end(),
+                      localVolImpl(t, strikes[0]));
+    }
+
 }
 
 
@@ -85,11 +85,45 @@ namespace QuantLib {
 
     Volatility LocalVolSurface::localVolImpl(Time t, Real underlyingLevel)
                                                                      const {
+        return sliceLocalVol(timeSlice(t), underlyingLevel);
+    }
+
+    void LocalVolSurface::localVolsImpl(Time t, const Array& strikes,
+                                        Array& vols) const {
+        const TimeSlice slice = timeSlice(t);
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = sliceLocalVol(slice, strikes[i]);
+    }
+
+    LocalVolSurface::TimeSlice LocalVolSurface::timeSlice(Time t) const {
+        TimeSlice slice;
+        slice.t = t;
+        slice.dr = riskFreeTS_->discount(t, true);
+        slice.dq = dividendTS_->discount(t, true);
+        slice.forwardValue = underlying_->value()*slice.dq/slice.dr;
+
+        if (t==0.0) {
+            slice.dt = 0.0001;
+            slice.drpt = riskFreeTS_->discount(t+slice.dt, true);
+            slice.dqpt = dividendTS_->discount(t+slice.dt, true);
+            slice.drmt = slice.dqmt = Null<Real>();
+        } else {
+            slice.dt = std::min<Time>(0.0001, t/2.0);
+            slice.drpt = riskFreeTS_->discount(t+slice.dt, true);
+            slice.drmt = riskFreeTS_->discount(t-slice.dt, true);
+            slice.dqpt = dividendTS_->discount(t+slice.dt, true);
+            slice.dqmt = dividendTS_->discount(t-slice.dt, true);
+        }
+        return slice;
+    }
+
+    Volatility LocalVolSurface::sliceLocalVol(const TimeSlice& slice,
+                                              Real underlyingLevel) const {
+
+        const Time t = slice.t, dt = slice.dt;
+        const DiscountFactor dr = slice.dr, dq = slice.dq;
+        const Real forwardValue = slice.forwardValue;
 
-        DiscountFactor dr = riskFreeTS_->discount(t, true);
-        DiscountFactor dq = dividendTS_->discount(t, true);
-        Real forwardValue = underlying_->value()*dq/dr;
-        
         // strike derivatives
         Real strike, y, dy, strikep, strikem;
         Real w, wp, wm, dwdy, d2wdy2;
@@ -105,12 +139,9 @@ namespace QuantLib {
         d2wdy2 = (wp-2.0*w+wm)/(dy*dy);
 
         // time derivative
-        Real dt, wpt, wmt, dwdt;
+        Real wpt, wmt, dwdt;
         if (t==0.0) {
-            dt = 0.0001;
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);           
-            Real strikept = strike*dr*dqpt/(drpt*dq);
+            Real strikept = strike*dr*slice.dqpt/(slice.drpt*dq);
         
             wpt = blackTS_->blackVariance(t+dt, strikept, true);
             QL_ENSURE(wpt>=w,
@@ -118,14 +149,8 @@ namespace QuantLib {
                       << " between time " << t << " and time " << t+dt);
             dwdt = (wpt-w)/dt;
         } else {
-            dt = std::min<Time>(0.0001, t/2.0);
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor drmt = riskFreeTS_->discount(t-dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);
-            DiscountFactor dqmt = dividendTS_->discount(t-dt, true);
-            
-            Real strikept = strike*dr*dqpt/(drpt*dq);
-            Real strikemt = strike*dr*dqmt/(drmt*dq);
+            Real strikept = strike*dr*slice.dqpt/(slice.drpt*dq);
+            Real strikemt = strike*dr*slice.dqmt/(slice.drmt*dq);
             
             wpt = blackTS_->blackVariance(t+dt, strikept, true);
             wmt = blackTS_->blackVariance(t-dt, strikemt, true);
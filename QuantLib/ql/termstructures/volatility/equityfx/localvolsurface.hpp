@@ -69,6 +69,15 @@ namespace QuantLib {
         //@}
       protected:
         Volatility localVolImpl(Time, Real) const;
+        void localVolsImpl(Time, const Array&, Array&) const;
+        // discount factors at and around t, shared by all strikes
+        struct TimeSlice {
+            Time t, dt;
+            DiscountFactor dr, dq, drpt, dqpt, drmt, dqmt;
+            Real forwardValue;
+        };
+        TimeSlice timeSlice(Time t) const;
+        Volatility sliceLocalVol(const TimeSlice& slice, Real strike) const;
       private:
         Handle<BlackVolTermStructure> blackTS_;
         Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
@@ -54,6 +54,27 @@ namespace QuantLib {
         return localVolImpl(t, underlyingLevel);
     }
 
+    void LocalVolTermStructure::localVols(Time t,
+                                          const Array& underlyingLevels,
+                                          Array& vols,
+                                          bool extrapolate) const {
+        checkRange(t, extrapolate);
+        if (!extrapolate && !allowsExtrapolation()) {
+            for (Size i=0; i<underlyingLevels.size(); ++i)
+                checkStrike(underlyingLevels[i], extrapolate);
+        }
+        if (vols.size() != underlyingLevels.size())
+            vols = Array(underlyingLevels.size());
+        localVolsImpl(t, underlyingLevels, vols);
+    }
+
+    void LocalVolTermStructure::localVolsImpl(Time t,
+                                              const Array& strikes,
+                                              Array& vols) const {
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = localVolImpl(t, strikes[i]);
+    }
+
     void LocalVolTermStructure::accept(AcyclicVisitor& v) {
         Visitor<LocalVolTermStructure>* v1 =
             dynamic_cast<Visitor<LocalVolTermStructure>*>(&v);
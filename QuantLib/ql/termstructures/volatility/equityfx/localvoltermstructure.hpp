@@ -27,6 +27,7 @@
 
 #include <ql/termstructures/voltermstructure.hpp>
 #include <ql/patterns/visitor.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -69,6 +70,14 @@ namespace QuantLib {
         Volatility localVol(Time t,
                             Real underlyingLevel,
                             bool extrapolate = false) const;
+        /*! local volatilities at the same time for several underlying
+            levels; vols is resized if needed. Derived classes can
+            share the work depending on time only among the levels.
+        */
+        void localVols(Time t,
+                       const Array& underlyingLevels,
+                       Array& vols,
+                       bool extrapolate = false) const;
         //@}
         //! \name Visitability
         //@{
@@ -85,6 +94,12 @@ namespace QuantLib {
         //@{
         //! local vol calculation
         virtual Volatility localVolImpl(Time t, Real strike) const = 0;
+        /*! batch local vol calculation; the default implementation
+            calls localVolImpl for each strike.
+        */
+        virtual void localVolsImpl(Time t,
+                                   const Array& strikes,
+                                   Array& vols) const;
         //@}
     };
 
@@ -26,6 +26,7 @@
 #define quantlib_no_except_localvolsurface_hpp
 
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -59,6 +60,23 @@ namespace QuantLib {
             return vol;
         }
 
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const {
+            TimeSlice slice;
+            try {
+                slice = timeSlice(t);
+            } catch (Error&) {
+                std::fill(vols.begin(), vols.end(), illegalLocalVolOverwrite_);
+                return;
+            }
+            for (Size i=0; i<strikes.size(); ++i) {
+                try {
+                    vols[i] = sliceLocalVol(slice, strikes[i]);
+                } catch (Error&) {
+                    vols[i] = illegalLocalVolOverwrite_;
+                }
+            }
+        }
+
       private:
         const Real illegalLocalVolOverwrite_;
     };
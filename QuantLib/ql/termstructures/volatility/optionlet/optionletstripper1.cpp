@@ -26,11 +26,10 @@
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
 #include <ql/pricingengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
-#include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 using boost::shared_ptr;
 
@@ -53,6 +52,10 @@ OptionletStripper1::OptionletStripper1(
 
         Real firstGuess = 0.14; // guess is only used for shifted lognormal vols
         optionletStDevs_ = Matrix(nOptionletTenors_, nStrikes_, firstGuess);
+
+        capFloors_.resize(nOptionletTenors_);
+        caplets_.resize(nOptionletTenors_);
+        stripped_ = false;
     }
 
     void OptionletStripper1::performCalculations() const {
@@ -60,19 +63,28 @@ OptionletStripper1::OptionletStripper1(
         // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
-        shared_ptr<BlackCapFloorEngine> dummy(new
+        const Date today = Settings::instance().evaluationDate();
+
+        // the cap schedules only change with the evaluation date
+        if (capFloorsDate_ != today) {
+            shared_ptr<BlackCapFloorEngine> dummy(new
                     BlackCapFloorEngine(// discounting does not matter here
                                         iborIndex_->forwardingTermStructure(),
                                         0.20, dc));
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                capFloors_[i] = MakeCapFloor(CapFloor::Cap,
+                                             capFloorLengths_[i],
+                                             iborIndex_,
+                                             0.04, // dummy strike
+                                             0*Days)
+                    .withPricingEngine(dummy);
+            }
+            capFloorsDate_ = today;
+        }
+
         for (Size i=0; i<nOptionletTenors_; ++i) {
-            CapFloor temp = MakeCapFloor(CapFloor::Cap,
-                                         capFloorLengths_[i],
-                                         iborIndex_,
-                                         0.04, // dummy strike
-                                         0*Days)
-                .withPricingEngine(dummy);
             shared_ptr<FloatingRateCoupon> lFRC =
-                                                temp.lastFloatingRateCoupon();
+                                        capFloors_[i]->lastFloatingRateCoupon();
             optionletDates_[i] = lFRC->fixingDate();
             optionletPaymentDates_[i] = lFRC->date();
             optionletAccrualPeriods_[i] = lFRC->accrualPeriod();
@@ -81,6 +93,7 @@ OptionletStripper1::OptionletStripper1(
             atmOptionletRate_[i] = lFRC->indexFixing();
         }
 
+        Rate previousSwitchStrike = switchStrike_;
         if (floatingSwitchStrike_) {
             Rate averageAtmOptionletRate = 0.0;
             for (Size i=0; i<nOptionletTenors_; ++i) {
@@ -94,84 +107,157 @@ OptionletStripper1::OptionletStripper1(
                 iborIndex_->forwardingTermStructure() :
                 discount_;
 
-        const std::vector<Rate>& strikes = termVolSurface_->strikes();
+        // caplet data as used by the cap/floor engines, which discard
+        // the caplets paid before the settlement date of the curve and
+        // measure fixing times from the evaluation date; the previous
+        // results can be kept for the maturities before the first cap
+        // whose data changed
+        Size firstChangedTenor =
+            stripped_ && switchStrike_ == previousSwitchStrike ?
+                nOptionletTenors_ : 0;
+        const Date settlement = discountCurve->referenceDate();
+        std::vector<DiscountFactor> optionletAnnuities(nOptionletTenors_);
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            const Leg& leg = capFloors_[i]->floatingLeg();
+            std::vector<Caplet> caplets;
+            caplets.reserve(leg.size());
+            for (Size k=0; k<leg.size(); ++k) {
+                shared_ptr<FloatingRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[k]);
+                if (coupon->date() <= settlement)
+                    continue;
+                Caplet caplet;
+                caplet.annuity = coupon->nominal() *
+                                 coupon->gearing() *
+                                 discountCurve->discount(coupon->date()) *
+                                 coupon->accrualPeriod();
+                caplet.forward = coupon->date() >= today ?
+                    coupon->adjustedFixing() : Null<Rate>();
+                caplet.spread = coupon->spread();
+                caplet.gearing = coupon->gearing();
+                caplet.fixingTime = coupon->fixingDate() > today ?
+                    dc.yearFraction(today, coupon->fixingDate()) :
+                    Null<Time>();
+                caplets.push_back(caplet);
+            }
+            if (i < firstChangedTenor && !(caplets == caplets_[i]))
+                firstChangedTenor = i;
+            caplets_[i].swap(caplets);
 
-        boost::shared_ptr<PricingEngine> capFloorEngine;
-        boost::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
-
-        if (volatilityType_ == ShiftedLognormal) {
-            capFloorEngine = boost::shared_ptr<BlackCapFloorEngine>(
-                        new BlackCapFloorEngine(
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc, displacement_));
-        } else if (volatilityType_ == Normal) {
-            capFloorEngine = boost::shared_ptr<BachelierCapFloorEngine>(
-                        new BachelierCapFloorEngine(
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc));
-        } else {
-            QL_FAIL("unknown volatility type: " << volatilityType_);
+            DiscountFactor d =
+                discountCurve->discount(optionletPaymentDates_[i]);
+            optionletAnnuities[i] = optionletAccrualPeriods_[i]*d;
         }
 
-        for (Size j=0; j<nStrikes_; ++j) {
+        // each strike is bootstrapped again from the first maturity
+        // whose data or cap volatility changed
+        const std::vector<Rate>& strikes = termVolSurface_->strikes();
+        std::vector<Size> firstTenor(nStrikes_, firstChangedTenor);
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            for (Size j=0; j<nStrikes_; ++j) {
+                Volatility v = termVolSurface_->volatility(
+                    capFloorLengths_[i], strikes[j], true);
+                if (v != capFloorVols_[i][j]) {
+                    firstTenor[j] = std::min(firstTenor[j], i);
+                    capFloorVols_[i][j] = v;
+                }
+            }
+        }
+
+        // strikes are independent; only the caplet data computed above
+        // are shared, and they are not modified by the loop
+        std::vector<std::string> errors(nStrikes_);
+        #pragma omp parallel for
+        for (long l=0; l<long(nStrikes_); ++l) {
+            const Size j = Size(l);
             // using out-of-the-money options
-            CapFloor::Type capFloorType =
-                strikes[j] < switchStrike_ ? CapFloor::Floor : CapFloor::Cap;
             Option::Type optionletType =
                 strikes[j] < switchStrike_ ? Option::Put : Option::Call;
 
-            Real previousCapFloorPrice = 0.0;
-            for (Size i=0; i<nOptionletTenors_; ++i) {
+            try {
+                Real previousCapFloorPrice =
+                    firstTenor[j] > 0 ? capFloorPrices_[firstTenor[j]-1][j]
+                                      : 0.0;
+                for (Size i=firstTenor[j]; i<nOptionletTenors_; ++i) {
 
-                capFloorVols_[i][j] = termVolSurface_->volatility(
-                    capFloorLengths_[i], strikes[j], true);
-                volQuote->setValue(capFloorVols_[i][j]);
-                boost::shared_ptr<CapFloor> capFloor =
-                    MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                 iborIndex_, strikes[j], -0 * Days)
-                        .withPricingEngine(capFloorEngine);
-                capFloorPrices_[i][j] = capFloor->NPV();
-                optionletPrices_[i][j] = capFloorPrices_[i][j] -
+                    capFloorPrices_[i][j] = capFloorPrice(i, optionletType,
+                                                          strikes[j],
+                                                          capFloorVols_[i][j]);
+                    optionletPrices_[i][j] = capFloorPrices_[i][j] -
                                                         previousCapFloorPrice;
-                previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
-                try {
-                  if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (volatilityType_ == Normal) {
-                    optionletStDevs_[i][j] =
-                        std::sqrt(optionletTimes_[i]) *
-                        bachelierBlackFormulaImpliedVol(
+                    previousCapFloorPrice = capFloorPrices_[i][j];
+                    DiscountFactor optionletAnnuity = optionletAnnuities[i];
+                    try {
+                      if (volatilityType_ == ShiftedLognormal) {
+                        optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
                             optionletType, strikes[j], atmOptionletRate_[i],
-                            optionletTimes_[i], optionletPrices_[i][j],
-                            optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown volatility type: " << volatilityType_);
-                  }
-                }
-                catch (std::exception &e) {
-                    if(dontThrow_)
-                        optionletStDevs_[i][j]=0.0;
-                    else
-                        QL_FAIL("could not bootstrap optionlet:"
-                            "\n type:    " << optionletType <<
-                            "\n strike:  " << io::rate(strikes[j]) <<
-                            "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
-                            "\n price:   " << optionletPrices_[i][j] <<
-                            "\n annuity: " << optionletAnnuity <<
-                            "\n expiry:  " << optionletDates_[i] <<
-                            "\n error:   " << e.what());
-                }
-                optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
+                            optionletPrices_[i][j], optionletAnnuity,
+                            displacement_, optionletStDevs_[i][j], accuracy_,
+                            maxIter_);
+                      } else if (volatilityType_ == Normal) {
+                        optionletStDevs_[i][j] =
+                            std::sqrt(optionletTimes_[i]) *
+                            bachelierBlackFormulaImpliedVol(
+                                optionletType, strikes[j],
+                                atmOptionletRate_[i], optionletTimes_[i],
+                                optionletPrices_[i][j], optionletAnnuity);
+                      } else {
+                        QL_FAIL("Unknown volatility type: "
+                                << volatilityType_);
+                      }
+                    }
+                    catch (std::exception &e) {
+                        if(dontThrow_)
+                            optionletStDevs_[i][j]=0.0;
+                        else
+                            QL_FAIL("could not bootstrap optionlet:"
+                                "\n type:    " << optionletType <<
+                                "\n strike:  " << io::rate(strikes[j]) <<
+                                "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
+                                "\n price:   " << optionletPrices_[i][j] <<
+                                "\n annuity: " << optionletAnnuity <<
+                                "\n expiry:  " << optionletDates_[i] <<
+                                "\n error:   " << e.what());
+                    }
+                    optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
                                                 std::sqrt(optionletTimes_[i]);
+                }
+            } catch (std::exception& e) {
+                errors[j] = e.what();
             }
         }
 
+        // partial results can't be reused
+        for (Size j=0; j<nStrikes_; ++j) {
+            if (!errors[j].empty()) {
+                stripped_ = false;
+                QL_FAIL(errors[j]);
+            }
+        }
+        stripped_ = true;
+    }
+
+    Real OptionletStripper1::capFloorPrice(Size i,
+                                           Option::Type type,
+                                           Rate strike,
+                                           Volatility volatility) const {
+        // same as the cap/floor engines with a constant volatility
+        Real value = 0.0;
+        const std::vector<Caplet>& caplets = caplets_[i];
+        for (Size k=0; k<caplets.size(); ++k) {
+            const Caplet& c = caplets[k];
+            Real stdDev = 0.0;
+            if (c.fixingTime != Null<Time>())
+                stdDev = std::sqrt(volatility*volatility*c.fixingTime);
+            Rate effectiveStrike = (strike-c.spread)/c.gearing;
+            if (volatilityType_ == ShiftedLognormal)
+                value += blackFormula(type, effectiveStrike, c.forward,
+                                      stdDev, c.annuity, displacement_);
+            else
+                value += bachelierBlackFormula(type, effectiveStrike,
+                                               c.forward, stdDev, c.annuity);
+        }
+        return value;
     }
 
     const Matrix &OptionletStripper1::capletVols() const {
@@ -30,6 +30,7 @@
 #define quantlib_optionletstripper1_hpp
 
 #include <ql/termstructures/volatility/optionlet/optionletstripper.hpp>
+#include <ql/option.hpp>
 
 namespace QuantLib {
 
@@ -46,6 +47,16 @@ namespace QuantLib {
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        The caps are built once per evaluation date; their prices are
+        then computed from the forwards and discounted accruals of
+        their caplets, which are shared by all strikes and give the
+        same results as the cap/floor Black or Bachelier engines.
+        Strikes are stripped independently, in parallel if OpenMP is
+        enabled.  On recalculation, each strike is only bootstrapped
+        again from the first maturity whose cap volatility or caplet
+        data changed, so that moving a single quote does not restrip
+        the whole surface.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
@@ -70,6 +81,29 @@ namespace QuantLib {
         void performCalculations() const;
         //@}
       private:
+        // caplet of a cap, with the data used by the cap/floor engines;
+        // the fixing time is null if the caplet has already fixed
+        struct Caplet {
+            Real annuity;
+            Rate forward;
+            Spread spread;
+            Real gearing;
+            Time fixingTime;
+            bool operator==(const Caplet& c) const {
+                return annuity == c.annuity && forward == c.forward &&
+                    spread == c.spread && gearing == c.gearing &&
+                    fixingTime == c.fixingTime;
+            }
+        };
+        Real capFloorPrice(Size i,
+                           Option::Type type,
+                           Rate strike,
+                           Volatility volatility) const;
+        mutable std::vector<boost::shared_ptr<CapFloor> > capFloors_;
+        mutable Date capFloorsDate_;
+        mutable std::vector<std::vector<Caplet> > caplets_;
+        mutable bool stripped_;
+
         mutable Matrix capFloorPrices_, optionletPrices_;
         mutable Matrix capFloorVols_;
         mutable Matrix optionletStDevs_, capletVols_;
@@ -81,6 +81,151 @@ namespace QuantLib {
 
     }
 
+    void unsafeShiftedSabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho,
+                                       Real shift,
+                                       std::vector<Volatility>& vols) {
+        // same expressions as in unsafeSabrVolatility, so that the
+        // results do not differ from the ones of the single strike call
+        forward += shift;
+        const Real oneMinusBeta = 1.0-beta;
+        const Real nuOverAlpha = nu/alpha;
+        const Real d1 = oneMinusBeta*oneMinusBeta*alpha*alpha;
+        const Real d2 = 0.25*rho*beta*nu*alpha;
+        const Real d3 = (2.0-3.0*rho*rho)*(nu*nu/24.0);
+        static const Real m = 10;
+        vols.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real strike = strikes[i]+shift;
+            const Real A = std::pow(forward*strike, oneMinusBeta);
+            const Real sqrtA= std::sqrt(A);
+            Real logM;
+            if (!close(forward, strike))
+                logM = std::log(forward/strike);
+            else {
+                const Real epsilon = (forward-strike)/strike;
+                logM = epsilon - .5 * epsilon * epsilon ;
+            }
+            const Real z = nuOverAlpha*sqrtA*logM;
+            const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
+            const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+            const Real d = 1.0 + expiryTime * (d1/(24.0*A) + d2/sqrtA + d3);
+            Real multiplier;
+            if (std::fabs(z*z)>QL_EPSILON * m) {
+                const Real B = 1.0-2.0*rho*z+z*z;
+                const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
+                multiplier = z/std::log(tmp);
+            } else {
+                multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
+            }
+            vols[i] = (alpha/D)*multiplier*d;
+        }
+    }
+
+    Disposable<Array> unsafeSabrVolatilityGradient(Rate strike,
+                                                   Rate forward,
+                                                   Time expiryTime,
+                                                   Real alpha,
+                                                   Real beta,
+                                                   Real nu,
+                                                   Real rho) {
+        // same expressions as in unsafeSabrVolatility, differentiated
+        // term by term; the d*_d* variables hold the partial derivatives
+        // with respect to alpha, beta, nu and rho (in this order)
+        const Real oneMinusBeta = 1.0-beta;
+        const Real logFK = std::log(forward*strike);
+        const Real A = std::pow(forward*strike, oneMinusBeta);
+        const Real sqrtA= std::sqrt(A);
+        const Real dSqrtA_dBeta = -0.5*sqrtA*logFK;
+        Real logM;
+        if (!close(forward, strike))
+            logM = std::log(forward/strike);
+        else {
+            const Real epsilon = (forward-strike)/strike;
+            logM = epsilon - .5 * epsilon * epsilon ;
+        }
+        const Real z = (nu/alpha)*sqrtA*logM;
+        const Real dz[] = { -z/alpha,
+                            (nu/alpha)*dSqrtA_dBeta*logM,
+                            sqrtA*logM/alpha,
+                            0.0 };
+        const Real dRho[] = { 0.0, 0.0, 0.0, 1.0 };
+
+        const Real B = 1.0-2.0*rho*z+z*z;
+        const Real sqrtB = std::sqrt(B);
+        const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
+        const Real dC_dBeta = -2.0*oneMinusBeta*logM*logM;
+        const Real tmp = (sqrtB+z-rho)/(1.0-rho);
+        const Real xx = std::log(tmp);
+        const Real Dc = 1.0+C/24.0+C*C/1920.0;
+        const Real D = sqrtA*Dc;
+        const Real dD[] = { 0.0,
+                            dSqrtA_dBeta*Dc
+                            + sqrtA*(1.0/24.0 + C/960.0)*dC_dBeta,
+                            0.0,
+                            0.0 };
+
+        const Real E1 = oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A);
+        const Real E2 = 0.25*rho*beta*nu*alpha/sqrtA;
+        const Real d = 1.0 + expiryTime *
+            (E1 + E2 + (2.0-3.0*rho*rho)*(nu*nu/24.0));
+        const Real dd[] = {
+            expiryTime*(oneMinusBeta*oneMinusBeta*alpha/(12.0*A)
+                        + 0.25*rho*beta*nu/sqrtA),
+            expiryTime*(-oneMinusBeta*alpha*alpha/(12.0*A) + E1*logFK
+                        + 0.25*rho*nu*alpha/sqrtA + 0.5*E2*logFK),
+            expiryTime*(0.25*rho*beta*alpha/sqrtA
+                        + (2.0-3.0*rho*rho)*nu/12.0),
+            expiryTime*(0.25*beta*nu*alpha/sqrtA - 0.25*rho*nu*nu) };
+
+        Real multiplier;
+        Real dMultiplier[4];
+        static const Real m = 10;
+        if (std::fabs(z*z)>QL_EPSILON * m) {
+            multiplier = z/xx;
+            for (Size i=0; i<4; ++i) {
+                const Real dB = -2.0*z*dRho[i] + 2.0*(z-rho)*dz[i];
+                const Real dxx = (0.5*dB/sqrtB + dz[i] - dRho[i])
+                                 /(sqrtB+z-rho) + dRho[i]/(1.0-rho);
+                dMultiplier[i] = dz[i]/xx - z*dxx/(xx*xx);
+            }
+        } else {
+            multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
+            for (Size i=0; i<4; ++i) {
+                dMultiplier[i] = -0.5*(dRho[i]*z + rho*dz[i])
+                    - (6.0*rho*dRho[i]*z*z
+                       + (3.0*rho*rho-2.0)*2.0*z*dz[i])/12.0;
+            }
+        }
+
+        Array gradient(4);
+        for (Size i=0; i<4; ++i) {
+            gradient[i] = (alpha/D)*(dMultiplier[i]*d + multiplier*dd[i])
+                - alpha*multiplier*d*dD[i]/(D*D);
+        }
+        gradient[0] += multiplier*d/D;
+        return gradient;
+    }
+
+    Disposable<Array> unsafeShiftedSabrVolatilityGradient(Rate strike,
+                                                          Rate forward,
+                                                          Time expiryTime,
+                                                          Real alpha,
+                                                          Real beta,
+                                                          Real nu,
+                                                          Real rho,
+                                                          Real shift) {
+
+        return unsafeSabrVolatilityGradient(strike+shift,forward+shift,
+                                            expiryTime,alpha,beta,nu,rho);
+
+    }
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
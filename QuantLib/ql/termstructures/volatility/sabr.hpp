@@ -27,7 +27,8 @@
 #ifndef quantlib_sabr_hpp
 #define quantlib_sabr_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -48,6 +49,19 @@ namespace QuantLib {
                               Real rho,
                               Real shift);
 
+    /*! unsafeShiftedSabrVolatility for a set of strikes; the terms
+        not depending on the strike are computed once.
+    */
+    void unsafeShiftedSabrVolatilities(const std::vector<Rate>& strikes,
+                                       Rate forward,
+                                       Time expiryTime,
+                                       Real alpha,
+                                       Real beta,
+                                       Real nu,
+                                       Real rho,
+                                       Real shift,
+                                       std::vector<Volatility>& vols);
+
     Real sabrVolatility(Rate strike,
                         Rate forward,
                         Time expiryTime,
@@ -65,6 +79,26 @@ namespace QuantLib {
                                  Real rho,
                                  Real shift);
 
+    /*! derivatives of unsafeSabrVolatility with respect to
+        alpha, beta, nu and rho (in this order)
+    */
+    Disposable<Array> unsafeSabrVolatilityGradient(Rate strike,
+                                                   Rate forward,
+                                                   Time expiryTime,
+                                                   Real alpha,
+                                                   Real beta,
+                                                   Real nu,
+                                                   Real rho);
+
+    Disposable<Array> unsafeShiftedSabrVolatilityGradient(Rate strike,
+                                                          Rate forward,
+                                                          Time expiryTime,
+                                                          Real alpha,
+                                                          Real beta,
+                                                          Real nu,
+                                                          Real rho,
+                                                          Real shift);
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
@@ -84,6 +84,45 @@ namespace QuantLib {
             return bachelierBlackFormula(type,strike,atm,sqrt(variance(strike)),discount);
     }
 
+    void SmileSection::optionPrices(const std::vector<Rate>& strikes,
+                                    std::vector<Real>& prices,
+                                    Option::Type type,
+                                    Real discount) const {
+        prices.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            prices[i] = optionPrice(strikes[i], type, discount);
+    }
+
+    void SmileSection::volatilitiesImpl(const std::vector<Rate>& strikes,
+                                        std::vector<Volatility>& vols) const {
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = volatilityImpl(strikes[i]);
+    }
+
+    void SmileSection::optionPricesFromVolatilities(
+                                      const std::vector<Rate>& strikes,
+                                      std::vector<Real>& prices,
+                                      Option::Type type,
+                                      Real discount) const {
+        Real atm = atmLevel();
+        QL_REQUIRE(atm != Null<Real>(),
+                   "smile section must provide atm level to compute option price");
+        std::vector<Volatility> vols;
+        volatilities(strikes, vols);
+        prices.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            Rate strike = strikes[i];
+            Real stdDev = sqrt(vols[i]*vols[i]*exerciseTime());
+            if (volatilityType() == ShiftedLognormal)
+                prices[i] = blackFormula(type,strike,atm,
+                                 std::fabs(strike+shift()) < QL_EPSILON ?
+                                 0.2 : stdDev,discount,shift());
+            else
+                prices[i] = bachelierBlackFormula(type,strike,atm,stdDev,
+                                                  discount);
+        }
+    }
+
     Real SmileSection::digitalOptionPrice(Rate strike,
                                           Option::Type type,
                                           Real discount,
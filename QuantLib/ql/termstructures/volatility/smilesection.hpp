@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -56,6 +57,12 @@ namespace QuantLib {
         virtual Real maxStrike() const = 0;
         Real variance(Rate strike) const;
         Volatility volatility(Rate strike) const;
+        /*! volatilities for a set of strikes; sections with a
+            closed form or a shared numerical grid evaluate the whole
+            set in one pass.
+        */
+        void volatilities(const std::vector<Rate>& strikes,
+                          std::vector<Volatility>& vols) const;
         virtual Real atmLevel() const = 0;
         virtual const Date& exerciseDate() const { return exerciseDate_; }
         virtual VolatilityType volatilityType() const {
@@ -68,6 +75,11 @@ namespace QuantLib {
         virtual Real optionPrice(Rate strike,
                                  Option::Type type = Option::Call,
                                  Real discount=1.0) const;
+        //! option prices for a set of strikes
+        virtual void optionPrices(const std::vector<Rate>& strikes,
+                                  std::vector<Real>& prices,
+                                  Option::Type type = Option::Call,
+                                  Real discount=1.0) const;
         virtual Real digitalOptionPrice(Rate strike,
                                         Option::Type type = Option::Call,
                                         Real discount=1.0,
@@ -82,6 +94,16 @@ namespace QuantLib {
         virtual void initializeExerciseTime() const;
         virtual Real varianceImpl(Rate strike) const;
         virtual Volatility volatilityImpl(Rate strike) const = 0;
+        //! the default implementation calls volatilityImpl for each strike
+        virtual void volatilitiesImpl(const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& vols) const;
+        /*! prices computed as in SmileSection::optionPrice, from
+            volatilities evaluated in a single volatilities() call
+        */
+        void optionPricesFromVolatilities(const std::vector<Rate>& strikes,
+                                          std::vector<Real>& prices,
+                                          Option::Type type,
+                                          Real discount) const;
       private:
         bool isFloating_;
         mutable Date referenceDate_;
@@ -103,6 +125,12 @@ namespace QuantLib {
         return volatilityImpl(strike);
     }
 
+    inline void SmileSection::volatilities(const std::vector<Rate>& strikes,
+                                           std::vector<Volatility>& vols) const {
+        vols.resize(strikes.size());
+        volatilitiesImpl(strikes, vols);
+    }
+
     inline const Date& SmileSection::referenceDate() const {
         QL_REQUIRE(referenceDate_!=Date(),
                    "referenceDate not available for this instance");
@@ -37,6 +37,7 @@
 #include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/stopwatch.hpp>
 
 #include <boost/make_shared.hpp>
 
@@ -53,6 +54,18 @@ namespace QuantLib {
     class EndCriteria;
     class OptimizationMethod;
 
+    /*! The SABR smiles of the (option tenor, swap tenor) nodes are
+        calibrated concurrently if OpenMP is enabled and no optimization
+        method is given (a shared one would be used by several threads).
+        A node is only recalibrated when its market volatilities,
+        forward, shift or parameter guesses changed since the last
+        calibration; otherwise its previous parameters are kept. When
+        \c warmStart is set, recalibrated nodes start from their
+        previous parameters (or, for the first dense calibration, from
+        the sparse ones) instead of the parameter guesses; this is
+        faster, but makes results depend slightly on the calibration
+        history.
+    */
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
@@ -130,7 +143,8 @@ namespace QuantLib {
             const bool useMaxError = false,
             const Size maxGuesses = 50,
             const bool backwardFlat = false,
-            const Real cutoffStrike = 0.0001);
+            const Real cutoffStrike = 0.0001,
+            const bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -151,6 +165,18 @@ namespace QuantLib {
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
         //@}
+        //! \name Calibration monitoring
+        //@{
+        /*! seconds spent calibrating each (option tenor, swap tenor)
+            node in the last calculation; nodes which were not
+            recalibrated report zero.
+        */
+        Matrix sparseCalibrationTimes() const;
+        Matrix denseCalibrationTimes() const;
+        //! cost function evaluations of each node in the last calculation
+        Matrix sparseCalibrationEvaluations() const;
+        Matrix denseCalibrationEvaluations() const;
+        //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
                                     const Period& swapTenor) const;
@@ -175,6 +201,33 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        // inputs and results of the calibration of a node
+        struct NodeCalibration {
+            NodeCalibration() : time(0.0), evaluations(0) {}
+            bool sameInputs(const NodeCalibration& o) const {
+                return optionTime == o.optionTime
+                    && swapLength == o.swapLength
+                    && forward == o.forward && shift == o.shift
+                    && strikes == o.strikes
+                    && volatilities == o.volatilities
+                    && guess == o.guess;
+            }
+            Time optionTime, swapLength;
+            Rate forward;
+            Real shift;
+            std::vector<Real> strikes, volatilities, guess, start;
+            // alpha, beta, nu, rho, forward, errors and end criteria as
+            // in the parameters cube; empty if not calibrated
+            std::vector<Real> result;
+            Real time;
+            Size evaluations;
+        };
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             std::vector<NodeCalibration>& nodes,
+                             const Cube* warmStartCube) const;
+        Matrix calibrationStatistics(const std::vector<NodeCalibration>& nodes,
+                                     const Cube& parametersCube,
+                                     bool times) const;
         Size requiredNumberOfStrikes() const { return 1; }
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
@@ -194,6 +247,8 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool warmStart_;
+        mutable std::vector<NodeCalibration> sparseNodes_, denseNodes_;
 
         class PrivateObserver : public Observer {
           public:
@@ -231,7 +286,8 @@ namespace QuantLib {
         const boost::shared_ptr<OptimizationMethod> &optMethod,
         const Real errorAccept, const bool useMaxError, const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool warmStart)
         : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                                  strikeSpreads, volSpreads, swapIndexBase,
                                  shortSwapIndexBase, vegaWeightedSmileFit),
@@ -240,7 +296,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          warmStart_(warmStart) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -311,7 +368,7 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseNodes_, 0);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -319,7 +376,9 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_,
+                                               &sparseParameters_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -328,7 +387,9 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_,
+                                               &sparseParameters_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -337,49 +398,86 @@ namespace QuantLib {
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        std::vector<NodeCalibration> nodes;
+        return sabrCalibration(marketVolCube, nodes, 0);
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                                    const Cube &marketVolCube,
+                                    std::vector<NodeCalibration>& nodes,
+                                    const Cube* warmStartCube) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
         const std::vector<Date>& optionDates = marketVolCube.optionDates();
         const std::vector<Period>& swapTenors = marketVolCube.swapTenors();
-        Matrix alphas(optionTimes.size(), swapLengths.size(),0.);
-        Matrix betas(alphas);
-        Matrix nus(alphas);
-        Matrix rhos(alphas);
-        Matrix forwards(alphas);
-        Matrix errors(alphas);
-        Matrix maxErrors(alphas);
-        Matrix endCriteria(alphas);
+        const Size nSwaps = swapLengths.size();
+        const Size nNodes = optionTimes.size()*nSwaps;
+        nodes.resize(nNodes);
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
+        // the inputs are collected serially, since the swap indexes
+        // and term structures providing them are not thread-safe
+        std::vector<NodeCalibration> calibrations(nNodes);
+        std::vector<Size> changed;
         for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+            for (Size k=0; k<nSwaps; k++) {
+                NodeCalibration& c = calibrations[j*nSwaps+k];
+                const NodeCalibration& previous = nodes[j*nSwaps+k];
+                c.optionTime = optionTimes[j];
+                c.swapLength = swapLengths[k];
+                c.forward = atmStrike(optionDates[j], swapTenors[k]);
+                c.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    Real strike = c.forward+strikeSpreads_[i];
+                    if(strike + c.shift >=cutoffStrike_) {
+                        c.strikes.push_back(strike);
+                        c.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
-
-                const std::vector<Real>& guess = parametersGuess_.operator()(
+                c.guess = parametersGuess_.operator()(
                     optionTimes[j], swapLengths[k]);
 
+                if (!previous.result.empty() && previous.sameInputs(c)) {
+                    c.result = previous.result;
+                    continue;
+                }
+
+                c.start = c.guess;
+                if (warmStart_) {
+                    std::vector<Real> warm = previous.result;
+                    if (warm.empty() && warmStartCube != 0)
+                        warm = (*warmStartCube)(optionTimes[j],
+                                                swapLengths[k]);
+                    if (!warm.empty()) {
+                        for (Size i=0; i<4; i++)
+                            if (!isParameterFixed_[i])
+                                c.start[i] = warm[i];
+                    }
+                }
+                changed.push_back(j*nSwaps+k);
+            }
+        }
+
+        std::vector<std::string> failures(changed.size());
+        #pragma omp parallel for schedule(dynamic) if(!optMethod_)
+        for (long m=0; m<(long)changed.size(); m++) {
+            NodeCalibration& c = calibrations[changed[m]];
+            const Date& optionDate = optionDates[changed[m]/nSwaps];
+            const Period& swapTenor = swapTenors[changed[m]%nSwaps];
+            try {
+                const StopWatch watch;
+
                 const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     boost::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
+                                          (typename Model::Interpolation)(c.strikes.begin(), c.strikes.end(),
+                                          c.volatilities.begin(),
+                                          c.optionTime, c.forward,
+                                          c.start[0], c.start[1],
+                                          c.start[2], c.start[3],
                                           isParameterFixed_[0],
                                           isParameterFixed_[1],
                                           isParameterFixed_[2],
@@ -390,49 +488,82 @@ namespace QuantLib {
                                           errorAccept_,
                                           useMaxError_,
                                           maxGuesses_,
-                                          shiftTmp));
+                                          c.shift));
                 sabrInterpolation->update();
 
                 Real rmsError = sabrInterpolation->rmsError();
                 Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
-
-                QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
+                c.result.resize(8);
+                c.result[0] = sabrInterpolation->alpha();
+                c.result[1] = sabrInterpolation->beta();
+                c.result[2] = sabrInterpolation->nu();
+                c.result[3] = sabrInterpolation->rho();
+                c.result[4] = c.forward;
+                c.result[5] = rmsError;
+                c.result[6] = maxError;
+                c.result[7] = sabrInterpolation->endCriteria();
+                c.evaluations = sabrInterpolation->functionEvaluations();
+                c.time = watch.elapsed();
+
+                QL_ENSURE(c.result[7]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
                           "MaxIterations reached: " << "\n" <<
-                          "option maturity = " << optionDates[j] << ", \n" <<
-                          "swap tenor = " << swapTenors[k] << ", \n" <<
-                          "error = " << io::rate(errors[j][k])  << ", \n" <<
-                          "max error = " << io::rate(maxErrors[j][k]) << ", \n" <<
-                          "   alpha = " <<  alphas[j][k] << "n" <<
-                          "   beta = " <<  betas[j][k] << "\n" <<
-                          "   nu = " <<  nus[j][k]   << "\n" <<
-                          "   rho = " <<  rhos[j][k]  << "\n"
+                          "option maturity = " << optionDate << ", \n" <<
+                          "swap tenor = " << swapTenor << ", \n" <<
+                          "error = " << io::rate(rmsError)  << ", \n" <<
+                          "max error = " << io::rate(maxError) << ", \n" <<
+                          "   alpha = " <<  c.result[0] << "n" <<
+                          "   beta = " <<  c.result[1] << "\n" <<
+                          "   nu = " <<  c.result[2]   << "\n" <<
+                          "   rho = " <<  c.result[3]  << "\n"
                           );
 
                 QL_ENSURE(useMaxError_ ? maxError : rmsError < maxErrorTolerance_,
                       "global swaptions calibration failed: "
-                      "option tenor " << optionDates[j] <<
-                      ", swap tenor " << swapTenors[k] <<
+                      "option tenor " << optionDate <<
+                      ", swap tenor " << swapTenor <<
                       (useMaxError_ ? ": max error " : ": error") <<
                       (useMaxError_ ? maxError : rmsError) <<
-                          "   alpha = " <<  alphas[j][k] << "\n" <<
-                          "   beta = " <<  betas[j][k] << "\n" <<
-                          "   nu = " <<  nus[j][k]   << "\n" <<
-                          "   rho = " <<  rhos[j][k]  << "\n" <<
+                          "   alpha = " <<  c.result[0] << "\n" <<
+                          "   beta = " <<  c.result[1] << "\n" <<
+                          "   nu = " <<  c.result[2]   << "\n" <<
+                          "   rho = " <<  c.result[3]  << "\n" <<
                       (useMaxError_ ? ": error" : ": max error ") <<
                       (useMaxError_ ? rmsError :maxError)
                 );
+            } catch (std::exception& e) {
+                c.result.clear();
+                failures[m] = e.what();
+            }
+        }
+
+        // successful calibrations are kept even if others failed
+        nodes.swap(calibrations);
+        for (Size m=0; m<failures.size(); m++)
+            QL_REQUIRE(failures[m].empty(), failures[m]);
 
+        Matrix alphas(optionTimes.size(), nSwaps, 0.);
+        Matrix betas(alphas);
+        Matrix nus(alphas);
+        Matrix rhos(alphas);
+        Matrix forwards(alphas);
+        Matrix errors(alphas);
+        Matrix maxErrors(alphas);
+        Matrix endCriteria(alphas);
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const std::vector<Real>& result = nodes[j*nSwaps+k].result;
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
+                errors     [j][k] = result[5];
+                maxErrors  [j][k] = result[6];
+                endCriteria[j][k] = result[7];
             }
         }
+
         Cube sabrParametersCube(optionDates, swapTenors,
                                 optionTimes, swapLengths, 8,
                                 true, backwardFlat_);
@@ -810,6 +941,43 @@ namespace QuantLib {
         return volCubeAtmCalibrated_.browse();
     }
 
+    template<class Model>
+    Matrix SwaptionVolCube1x<Model>::sparseCalibrationTimes() const {
+        calculate();
+        return calibrationStatistics(sparseNodes_, sparseParameters_, true);
+    }
+
+    template<class Model>
+    Matrix SwaptionVolCube1x<Model>::denseCalibrationTimes() const {
+        calculate();
+        return calibrationStatistics(denseNodes_, denseParameters_, true);
+    }
+
+    template<class Model>
+    Matrix SwaptionVolCube1x<Model>::sparseCalibrationEvaluations() const {
+        calculate();
+        return calibrationStatistics(sparseNodes_, sparseParameters_, false);
+    }
+
+    template<class Model>
+    Matrix SwaptionVolCube1x<Model>::denseCalibrationEvaluations() const {
+        calculate();
+        return calibrationStatistics(denseNodes_, denseParameters_, false);
+    }
+
+    template<class Model>
+    Matrix SwaptionVolCube1x<Model>::calibrationStatistics(
+                                const std::vector<NodeCalibration>& nodes,
+                                const Cube& parametersCube,
+                                bool times) const {
+        const Size nSwaps = parametersCube.swapLengths().size();
+        Matrix result(parametersCube.optionTimes().size(), nSwaps, 0.0);
+        for (Size n=0; n<nodes.size() && n<result.rows()*nSwaps; ++n)
+            result[n/nSwaps][n%nSwaps] =
+                times ? nodes[n].time : Real(nodes[n].evaluations);
+        return result;
+    }
+
     template<class Model> void SwaptionVolCube1x<Model>::recalibration(Real beta,
                                          const Period& swapTenor) {
 
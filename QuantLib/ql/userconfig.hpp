@@ -64,6 +64,17 @@
 //#   define QL_USE_INDEXED_COUPON
 #endif
 
+/* Define this to leave the absorption table of the no-arbitrage SABR
+   model out of the library; it must then be loaded at run time through
+   NoArbSabrAbsorptionTable::load() from a file generated by
+   tools/noarbsabr_table.py (the test suite reads it from its working
+   directory or from the file given with --noarbsabr-table=FILE). The
+   file ql/experimental/volatility/noarbsabrabsprobs.cpp should be
+   removed from the project as well. */
+#ifndef QL_NOARBSABR_EXTERNAL_TABLE
+//#   define QL_NOARBSABR_EXTERNAL_TABLE
+#endif
+
 /* Define this to have singletons return different instances for
    different sessions. You will have to provide and link with the
    library a sessionId() function in namespace QuantLib, returning a
@@ -0,0 +1,36 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/stopwatch.hpp>
+
+using boost::posix_time::microsec_clock;
+
+namespace QuantLib {
+
+    StopWatch::StopWatch()
+    : start_(microsec_clock::universal_time()) {}
+
+    void StopWatch::restart() {
+        start_ = microsec_clock::universal_time();
+    }
+
+    Real StopWatch::elapsed() const {
+        return (microsec_clock::universal_time() - start_)
+            .total_microseconds() * 1.0e-6;
+    }
+
+}
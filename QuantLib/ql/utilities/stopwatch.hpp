@@ -0,0 +1,50 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file stopwatch.hpp
+    \brief wall-clock stopwatch
+*/
+
+#ifndef quantlib_stopwatch_hpp
+#define quantlib_stopwatch_hpp
+
+#include <ql/types.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace QuantLib {
+
+    //! wall-clock stopwatch
+    /*! The elapsed real time is measured, so that timings of code
+        running on several threads are not inflated by the cpu time
+        spent by each of them.
+    */
+    class StopWatch {
+      public:
+        //! starts the measurement
+        StopWatch();
+        //! starts the measurement again
+        void restart();
+        //! seconds elapsed since the start of the measurement
+        Real elapsed() const;
+      private:
+        boost::posix_time::ptime start_;
+    };
+
+}
+
+
+#endif
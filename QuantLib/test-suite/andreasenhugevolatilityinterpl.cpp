@@ -993,6 +993,118 @@ void AndreasenHugeVolatilityInterplTest::testMovingReferenceDate() {
                 << "\n    tolerance           : " << tol);
 }
 
+void AndreasenHugeVolatilityInterplTest::testIncrementalCalibration() {
+    BOOST_TEST_MESSAGE(
+        "Testing incremental Andreasen-Huge recalibration "
+        "on quote updates...");
+
+    SavedSettings backup;
+
+    const CalibrationData data = BorovkovaExampleData();
+
+    const Date today = data.rTS->referenceDate();
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dc = data.rTS->dayCounter();
+
+    const AndreasenHugeVolatilityInterpl::CalibrationSet& calibrationSet
+        = data.calibrationSet;
+
+    const boost::shared_ptr<AndreasenHugeVolatilityInterpl> incremental(
+        boost::make_shared<AndreasenHugeVolatilityInterpl>(
+            calibrationSet, data.spot, data.rTS, data.qTS,
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::Call, 200));
+
+    const boost::shared_ptr<AndreasenHugeVolatilityInterpl> warmStart(
+        boost::make_shared<AndreasenHugeVolatilityInterpl>(
+            calibrationSet, data.spot, data.rTS, data.qTS,
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::Call, 200,
+            Null<Real>(), Null<Real>(),
+            boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt),
+            EndCriteria(500, 100, 1e-12, 1e-10, 1e-10), true));
+
+    const Real strikes[] = { 60.0, 80.0, 100.0, 120.0, 150.0 };
+    const Time early = 0.2, late = 1.8;
+
+    std::vector<Real> earlyLocalVols;
+    for (Size i=0; i < LENGTH(strikes); ++i)
+        earlyLocalVols.push_back(incremental->localVol(early, strikes[i]));
+    warmStart->calibrationError();
+
+    // bump the quotes of the last expiry
+    const Date lastExpiry =
+        calibrationSet.back().first->exercise()->lastDate();
+    for (Size i=0; i < calibrationSet.size(); ++i)
+        if (calibrationSet[i].first->exercise()->lastDate() == lastExpiry) {
+            const boost::shared_ptr<SimpleQuote> quote =
+                boost::dynamic_pointer_cast<SimpleQuote>(
+                    calibrationSet[i].second);
+            quote->setValue(quote->value() + 0.01);
+        }
+
+    const AndreasenHugeVolatilityInterpl fullCalibration(
+        calibrationSet, data.spot, data.rTS, data.qTS,
+        AndreasenHugeVolatilityInterpl::CubicSpline,
+        AndreasenHugeVolatilityInterpl::Call, 200);
+
+    const Real tol = 1e-12;
+    for (Size i=0; i < LENGTH(strikes); ++i) {
+        const Real strike = strikes[i];
+
+        const Volatility earlyLocalVol = incremental->localVol(early, strike);
+        if (std::fabs(earlyLocalVol - earlyLocalVols[i]) > tol)
+            BOOST_FAIL("local volatility before the changed expiry "
+                       "should not change"
+                       << "\n    strike    : " << strike
+                       << "\n    before    : " << earlyLocalVols[i]
+                       << "\n    after     : " << earlyLocalVol);
+
+        const Time times[] = { early, late };
+        for (Size j=0; j < LENGTH(times); ++j) {
+            const Real calculated =
+                incremental->optionPrice(times[j], strike, Option::Call);
+            const Real expected =
+                fullCalibration.optionPrice(times[j], strike, Option::Call);
+
+            if (std::fabs(calculated - expected) > tol)
+                BOOST_FAIL("incremental recalibration should match "
+                           "full recalibration"
+                           << "\n    time      : " << times[j]
+                           << "\n    strike    : " << strike
+                           << "\n    calculated: " << calculated
+                           << "\n    expected  : " << expected);
+        }
+    }
+
+    // warm started calibrations reach the same fit
+    const Real maxError = warmStart->calibrationError().get<1>();
+    const Real expectedMaxError =
+        fullCalibration.calibrationError().get<1>();
+    if (maxError > std::max(1.5*expectedMaxError, 1e-6))
+        BOOST_FAIL("warm started recalibration failed"
+                   << "\n    max calibration error:      " << maxError
+                   << "\n    full recalibration max error: "
+                   << expectedMaxError);
+
+    for (Size i=0; i < LENGTH(strikes); ++i) {
+        const Real strike = strikes[i];
+        const Time t = dc.yearFraction(today, lastExpiry);
+        const Real calculated =
+            warmStart->optionPrice(t, strike, Option::Call);
+        const Real expected =
+            fullCalibration.optionPrice(t, strike, Option::Call);
+
+        if (std::fabs(calculated - expected) > 1e-4*data.spot->value())
+            BOOST_FAIL("warm started recalibration should match "
+                       "full recalibration"
+                       << "\n    strike    : " << strike
+                       << "\n    calculated: " << calculated
+                       << "\n    expected  : " << expected);
+    }
+}
+
 test_suite* AndreasenHugeVolatilityInterplTest::suite(SpeedLevel speed) {
     test_suite* suite =
         BOOST_TEST_SUITE("Andreasen-Huge volatility interpolation tests");
@@ -1002,6 +1114,7 @@ test_suite* AndreasenHugeVolatilityInterplTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(AndreasenHugeVolatilityInterplTest::testPeterAndFabiensExample));
     suite->add(QUANTLIB_TEST_CASE(AndreasenHugeVolatilityInterplTest::testDifferentOptimizers));
     suite->add(QUANTLIB_TEST_CASE(AndreasenHugeVolatilityInterplTest::testMovingReferenceDate));
+    suite->add(QUANTLIB_TEST_CASE(AndreasenHugeVolatilityInterplTest::testIncrementalCalibration));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(AndreasenHugeVolatilityInterplTest::testAndreasenHugePut));
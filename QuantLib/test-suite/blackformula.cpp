@@ -23,6 +23,7 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
 
 #include <boost/make_shared.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -278,6 +279,155 @@ void BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation() {
     }
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+    BOOST_TEST_MESSAGE("Testing batch versions of Black formulas...");
+
+    const Real forward = 100.0;
+    const DiscountFactor df = 0.95;
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real displacements[] = { 0, 25, 100 };
+
+    // from far out-of-the-money to far in-the-money options
+    Array strikes(31), stdDevs(31);
+    for (Size i=0; i < strikes.size(); ++i) {
+        const Real logMoneyness = -1.5 + 0.1*i;
+        strikes[i] = forward*std::exp(logMoneyness);
+        stdDevs[i] = 0.2 + 0.3*std::fabs(logMoneyness);
+    }
+
+    const Real tol = 1e-12;
+
+    for (Size j=0; j < LENGTH(types); ++j) {
+        for (Size k=0; k < LENGTH(displacements); ++k) {
+            const Option::Type type = types[j];
+            const Real displacement = displacements[k];
+
+            const Array prices = blackFormula(
+                type, strikes, forward, stdDevs, df, displacement);
+            const Array vegas = blackFormulaStdDevDerivative(
+                strikes, forward, stdDevs, df, displacement);
+            const Array bachelierPrices = bachelierBlackFormula(
+                type, strikes, forward, stdDevs*forward, df);
+            const Array impliedStdDevs = blackFormulaImpliedStdDev(
+                type, strikes, forward, prices, df, displacement, 1e-14);
+
+            for (Size i=0; i < strikes.size(); ++i) {
+                const Real price = blackFormula(
+                    type, strikes[i], forward, stdDevs[i], df, displacement);
+                const Real vega = blackFormulaStdDevDerivative(
+                    strikes[i], forward, stdDevs[i], df, displacement);
+                const Real bachelierPrice = bachelierBlackFormula(
+                    type, strikes[i], forward, stdDevs[i]*forward, df);
+
+                if (std::fabs(prices[i] - price) > tol
+                    || std::fabs(vegas[i] - vega) > tol
+                    || std::fabs(bachelierPrices[i] - bachelierPrice) > tol) {
+                    BOOST_ERROR("Failed to reproduce scalar Black formulas"
+                                << "\n type        :" << type
+                                << "\n strike      :" << strikes[i]
+                                << "\n stdDev      :" << stdDevs[i]
+                                << "\n displacement:" << displacement
+                                << "\n price       :" << prices[i]
+                                << "\n expected    :" << price
+                                << "\n vega        :" << vegas[i]
+                                << "\n expected    :" << vega
+                                << "\n Bachelier   :" << bachelierPrices[i]
+                                << "\n expected    :" << bachelierPrice);
+                }
+
+                const Real error = std::fabs(impliedStdDevs[i] - stdDevs[i]);
+                if (error > 1e-10) {
+                    BOOST_ERROR("Failed to calculate implied standard "
+                                "deviation in batch"
+                                << "\n type        :" << type
+                                << "\n strike      :" << strikes[i]
+                                << "\n stdDev      :" << stdDevs[i]
+                                << "\n displacement:" << displacement
+                                << "\n result      :" << impliedStdDevs[i]
+                                << "\n error       :" << error);
+                }
+            }
+        }
+    }
+}
+
+void BlackFormulaTest::testBatchGreeks() {
+    BOOST_TEST_MESSAGE("Testing batch versions of Black greeks...");
+
+    const Real forward = 100.0;
+    const DiscountFactor df = 0.95;
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real displacements[] = { 0, 25, 100 };
+
+    // includes a null standard deviation and, with the largest
+    // displacement, a null displaced strike
+    Array strikes(32), stdDevs(32);
+    for (Size i=0; i < strikes.size()-1; ++i) {
+        const Real logMoneyness = -1.5 + 0.1*i;
+        strikes[i] = forward*std::exp(logMoneyness);
+        stdDevs[i] = (i == 10 ? 0.0 : 0.2 + 0.3*std::fabs(logMoneyness));
+    }
+    strikes[31] = -100.0;
+    stdDevs[31] = 0.3;
+
+    const Real tol = 1e-12;
+
+    for (Size j=0; j < LENGTH(types); ++j) {
+        for (Size k=0; k < LENGTH(displacements); ++k) {
+            const Option::Type type = types[j];
+            const Real displacement = displacements[k];
+            const Size n = (displacement == 100.0 ? strikes.size()
+                                                  : strikes.size()-1);
+            const Array s(strikes.begin(), strikes.begin()+n);
+            const Array v(stdDevs.begin(), stdDevs.begin()+n);
+
+            const Array deltas = blackFormulaForwardDerivative(
+                type, s, forward, v, df, displacement);
+            const Array gammas = blackFormulaForwardSecondDerivative(
+                s, forward, v, df, displacement);
+            const Array itmProbabilities = blackFormulaCashItmProbability(
+                type, s, forward, v, displacement);
+
+            for (Size i=0; i < n; ++i) {
+                // BlackCalculator has no displacement and, with a null
+                // strike, returns no gamma
+                const BlackCalculator calculator(
+                    type, s[i] + displacement, forward + displacement,
+                    v[i], df);
+                const Real gamma = (s[i] + displacement == 0.0
+                                    ? 0.0 : calculator.gammaForward());
+
+                if (std::fabs(deltas[i] - calculator.deltaForward()) > tol
+                    || std::fabs(gammas[i] - gamma) > tol) {
+                    BOOST_ERROR("Failed to reproduce BlackCalculator greeks"
+                                << "\n type        :" << type
+                                << "\n strike      :" << s[i]
+                                << "\n stdDev      :" << v[i]
+                                << "\n displacement:" << displacement
+                                << "\n delta       :" << deltas[i]
+                                << "\n expected    :"
+                                << calculator.deltaForward()
+                                << "\n gamma       :" << gammas[i]
+                                << "\n expected    :" << gamma);
+                }
+
+                const Real itmProbability = blackFormulaCashItmProbability(
+                    type, s[i], forward, v[i], displacement);
+                if (std::fabs(itmProbabilities[i] - itmProbability) > tol)
+                    BOOST_ERROR("Failed to reproduce scalar itm probability"
+                                << "\n type        :" << type
+                                << "\n strike      :" << s[i]
+                                << "\n stdDev      :" << v[i]
+                                << "\n displacement:" << displacement
+                                << "\n result      :" << itmProbabilities[i]
+                                << "\n expected    :" << itmProbability);
+            }
+        }
+    }
+}
+
 
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
@@ -287,6 +437,8 @@ test_suite* BlackFormulaTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(BlackFormulaTest::testRadoicicStefanicaImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(BlackFormulaTest::testRadoicicStefanicaLowerBound));
     suite->add(QUANTLIB_TEST_CASE(BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation));
+    suite->add(QUANTLIB_TEST_CASE(BlackFormulaTest::testBatchFormulas));
+    suite->add(QUANTLIB_TEST_CASE(BlackFormulaTest::testBatchGreeks));
 
     return suite;
 }
@@ -32,6 +32,8 @@ class BlackFormulaTest {
     static void testRadoicicStefanicaImpliedVol();
     static void testRadoicicStefanicaLowerBound();
     static void testImpliedVolAdaptiveSuccessiveOverRelaxation();
+    static void testBatchFormulas();
+    static void testBatchGreeks();
 
     static boost::unit_test_framework::test_suite* suite();
 };
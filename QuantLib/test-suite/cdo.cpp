@@ -24,8 +24,12 @@
 #include <ql/experimental/credit/integralcdoengine.hpp>
 #include <ql/experimental/credit/midpointcdoengine.hpp>
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
+#include <ql/experimental/credit/defaultprobabilitylatentmodel.hpp>
+#include <ql/experimental/credit/binomiallossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
+#include <ql/experimental/credit/lossdistribution.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -371,9 +375,606 @@ void CdoTest::testHW(unsigned dataSet) {
 }
 
 
+namespace {
+
+    template <class RandomModel, class LatentModel>
+    void checkRandomModelWorkers(
+                     const boost::shared_ptr<LatentModel>& latentModel,
+                     const boost::shared_ptr<Basket>& basket,
+                     const std::string& modelName) {
+        Size numSims = 2000;
+        Size workers[] = { 1, 3, 8 };
+        std::vector<Date> dates;
+        dates.push_back(basket->refDate() + 1*Years);
+        dates.push_back(basket->refDate() + 5*Years);
+
+        std::vector<Real> expected;
+        for (Size k=0; k<LENGTH(workers); k++) {
+            boost::shared_ptr<RandomModel> model(
+                                      new RandomModel(latentModel, numSims));
+            model->setNumberOfWorkers(workers[k]);
+            basket->setLossModel(model);
+
+            std::vector<Real> results;
+            for (Size i=0; i<dates.size(); i++) {
+                results.push_back(basket->expectedTrancheLoss(dates[i]));
+                results.push_back(basket->percentile(dates[i], 0.95));
+                results.push_back(basket->probAtLeastNEvents(2, dates[i]));
+            }
+            if (k == 0) {
+                expected = results;
+                continue;
+            }
+            for (Size i=0; i<results.size(); i++) {
+                if (std::fabs(results[i]-expected[i]) > 1.0e-12)
+                    BOOST_ERROR(modelName << ": results depend on the "
+                                "number of workers"
+                                << "\n    workers:    " << workers[k]
+                                << "\n    statistic:  " << i
+                                << "\n    expected:   " << expected[i]
+                                << "\n    calculated: " << results[i]);
+            }
+        }
+    }
+
+}
+
+void CdoTest::testRandomDefaultWorkers() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing random default models "
+                       "with several simulation workers...");
+
+    SavedSettings backup;
+
+    Size poolSize = 50;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(boost::shared_ptr<Quote>(
+                                                   new SimpleQuote(0.02))),
+                           ActualActual()));
+    std::vector<std::pair<DefaultProbKey,
+        Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0,Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+
+    boost::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    boost::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, std::vector<Real>(poolSize, 100.0),
+                   pool, 0.0, 0.1));
+
+    Handle<Quote> correlation(
+                       boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    std::vector<Real> recoveries(poolSize, 0.4);
+
+    // Sobol sequence, split by jumping ahead
+    boost::shared_ptr<GaussianConstantLossLM> gaussianLM(
+        new GaussianConstantLossLM(correlation, recoveries,
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+    checkRandomModelWorkers<RandomDefaultLM<GaussianCopulaPolicy> >(
+        gaussianLM, basket, "Gaussian, Sobol");
+
+    // pseudo-random sequence, split by drawing
+    TCopulaPolicy::initTraits initT;
+    initT.tOrders = std::vector<Integer>(2, 5);
+    boost::shared_ptr<TConstantLossLM> studentLM(
+        new TConstantLossLM(correlation, recoveries,
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            initT));
+    checkRandomModelWorkers<RandomDefaultLM<TCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > >(
+        studentLM, basket, "Student T, Mersenne Twister");
+
+    #endif
+}
+
+
+void CdoTest::testSparseGridIntegration() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing sparse-grid integration "
+                       "of multi-factor latent models...");
+
+    SavedSettings backup;
+
+    Size poolSize = 5;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(boost::shared_ptr<Quote>(
+                                                   new SimpleQuote(0.02))),
+                           ActualActual()));
+    std::vector<std::pair<DefaultProbKey,
+        Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0,Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+
+    boost::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    boost::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, std::vector<Real>(poolSize, 100.0),
+                   pool, 0.0, 1.0));
+
+    // three factors
+    std::vector<std::vector<Real> > factorWeights(poolSize);
+    for (Size i=0; i<poolSize; ++i) {
+        factorWeights[i].push_back(0.5);
+        factorWeights[i].push_back(0.1*i - 0.2);
+        factorWeights[i].push_back(0.3 - 0.05*i);
+    }
+
+    LatentModelIntegrationType::LatentModelIntegrationType types[] = {
+        LatentModelIntegrationType::GaussianQuadrature,
+        LatentModelIntegrationType::SparseGaussianQuadrature,
+        LatentModelIntegrationType::ParallelSparseGaussianQuadrature
+    };
+    std::string typeNames[] = {
+        "tensor quadrature", "sparse grid", "parallel sparse grid"
+    };
+
+    Date date = asofDate + 5*Years;
+    Probability pUncond = ptr->defaultProbability(date);
+
+    std::vector<Real> expected, tensor;
+    for (Size k=0; k<LENGTH(types); ++k) {
+        GaussianDefProbLM model(factorWeights, types[k]);
+        model.resetBasket(basket);
+
+        std::vector<Real> results;
+        results.push_back(model.probOfDefault(1, date));
+        results.push_back(model.defaultCorrelation(date, 0, 4));
+        results.push_back(model.probAtLeastNEvents(2, date));
+
+        // integrating the conditional probability gives back the
+        // unconditional one
+        if (std::fabs(results[0]-pUncond) > 1.0e-8)
+            BOOST_ERROR(typeNames[k] << ": wrong default probability"
+                        << "\n    expected:   " << pUncond
+                        << "\n    calculated: " << results[0]);
+
+        if (k == 0) {
+            expected = tensor = results;
+            continue;
+        }
+        // the parallel evaluation sums in node order; it reproduces
+        // the serial sparse grid exactly
+        Real tolerance = (k == 2 ? 1.0e-15 : 1.0e-7);
+        for (Size i=0; i<results.size(); ++i) {
+            if (std::fabs(results[i]-expected[i]) > tolerance)
+                BOOST_ERROR(typeNames[k] << ": integral mismatch"
+                            << "\n    statistic:  " << i
+                            << "\n    expected:   " << expected[i]
+                            << "\n    calculated: " << results[i]
+                            << "\n    tolerance:  " << tolerance);
+        }
+        if (k == 1)
+            expected = results;
+    }
+
+    // a finer sparse grid still reproduces the tensor quadrature
+    Size level = 10;
+    GaussianDefProbLM fineModel(factorWeights,
+        LatentModelIntegrationType::SparseGaussianQuadrature,
+        GaussianCopulaPolicy::initTraits(), level);
+    fineModel.resetBasket(basket);
+    std::vector<Real> results;
+    results.push_back(fineModel.probOfDefault(1, date));
+    results.push_back(fineModel.defaultCorrelation(date, 0, 4));
+    results.push_back(fineModel.probAtLeastNEvents(2, date));
+    for (Size i=0; i<results.size(); ++i) {
+        if (std::fabs(results[i]-tensor[i]) > 1.0e-7)
+            BOOST_ERROR("level " << level << " sparse grid: "
+                        "integral mismatch"
+                        << "\n    statistic:  " << i
+                        << "\n    expected:   " << tensor[i]
+                        << "\n    calculated: " << results[i]);
+    }
+
+    #endif
+}
+
+
+namespace {
+
+    // expected tranche losses obtained by integrating the conditional
+    // tranche loss over the market factor separately for each tranche,
+    // as the models did before sharing the unconditional distributions
+
+    class PerTrancheBinomialLossModel : public GaussianBinomialLossModel {
+      public:
+        explicit PerTrancheBinomialLossModel(
+                 const boost::shared_ptr<GaussianConstantLossLM>& copula)
+        : GaussianBinomialLossModel(copula) {}
+        Real expectedTrancheLoss(const Date& d) const {
+            std::vector<Real> lossVals = lossPoints(d);
+            std::vector<Real> notionals = basket_->remainingNotionals(d);
+            std::vector<Probability> invProbs =
+                basket_->remainingProbabilities(d);
+            for (Size i=0; i<invProbs.size(); ++i)
+                invProbs[i] = copula_->inverseCumulativeY(invProbs[i], i);
+            return copula_->integratedExpectedValue(
+                boost::function<Real (const std::vector<Real>&)>(
+                    boost::bind(
+                        &PerTrancheBinomialLossModel::condTrancheLoss,
+                        this, boost::cref(d), boost::cref(lossVals),
+                        boost::cref(notionals), boost::cref(invProbs),
+                        _1)));
+        }
+    };
+
+    // exact convolution of the name losses; with loss given defaults
+    // on the loss unit it reproduces the recursive model
+    class PerTrancheRecursiveLossModel : public DefaultLossModel {
+      public:
+        explicit PerTrancheRecursiveLossModel(
+                 const boost::shared_ptr<GaussianConstantLossLM>& copula)
+        : copula_(copula) {}
+        Real expectedTrancheLoss(const Date& d) const {
+            std::vector<Probability> invProbs =
+                basket_->remainingProbabilities(d);
+            for (Size i=0; i<invProbs.size(); ++i)
+                invProbs[i] = copula_->inverseCumulativeY(invProbs[i], i);
+            return copula_->integratedExpectedValue(
+                boost::function<Real (const std::vector<Real>&)>(
+                    boost::bind(
+                        &PerTrancheRecursiveLossModel::condTrancheLoss,
+                        this, boost::cref(invProbs), _1)));
+        }
+      private:
+        void resetModel() {
+            copula_->resetBasket(basket_.currentLink());
+        }
+        Real condTrancheLoss(const std::vector<Real>& invProbs,
+                             const std::vector<Real>& mktFactor) const {
+            const std::vector<Real>& notionals =
+                basket_->remainingNotionals();
+            std::map<Real, Probability> distribution;
+            distribution[0.0] = 1.0;
+            for (Size i=0; i<invProbs.size(); ++i) {
+                Probability p = copula_->conditionalDefaultProbabilityInvP(
+                                               invProbs[i], i, mktFactor);
+                Real lgd = notionals[i] * (1.0 - copula_->recoveries()[i]);
+                std::map<Real, Probability> next;
+                for (std::map<Real, Probability>::const_iterator it =
+                         distribution.begin();
+                     it != distribution.end(); ++it) {
+                    next[it->first] += it->second * (1.0 - p);
+                    next[it->first + lgd] += it->second * p;
+                }
+                distribution.swap(next);
+            }
+            Real attach = basket_->remainingAttachmentAmount();
+            Real detach = basket_->remainingDetachmentAmount();
+            Real loss = 0.0;
+            for (std::map<Real, Probability>::const_iterator it =
+                     distribution.begin();
+                 it != distribution.end(); ++it)
+                loss += it->second *
+                    std::min(std::max(it->first - attach, 0.0),
+                             detach - attach);
+            return loss;
+        }
+        boost::shared_ptr<GaussianConstantLossLM> copula_;
+    };
+
+    template <class LossModel, class ReferenceModel>
+    void checkSharedLossModel(
+                 const std::vector<boost::shared_ptr<Basket> >& tranches,
+                 const boost::shared_ptr<Basket>& wholePool,
+                 const boost::shared_ptr<GaussianConstantLossLM>& latentModel,
+                 const boost::shared_ptr<SimpleQuote>& correlation,
+                 const std::string& modelName) {
+        std::vector<Date> dates;
+        dates.push_back(tranches[0]->refDate() + 1*Years);
+        dates.push_back(tranches[0]->refDate() + 5*Years);
+
+        boost::shared_ptr<DefaultLossModel> sharedModel(
+                                            new LossModel(latentModel));
+        for (Size k=0; k<2; ++k) {
+            if (k == 1)
+                correlation->setValue(0.5);
+            for (Size i=0; i<dates.size(); ++i) {
+                Real totalLoss = 0.0;
+                for (Size j=0; j<tranches.size(); ++j) {
+                    tranches[j]->setLossModel(sharedModel);
+                    Real shared = tranches[j]->expectedTrancheLoss(dates[i]);
+                    totalLoss += shared;
+
+                    // a model on its own is not reused across tranches
+                    boost::shared_ptr<DefaultLossModel> ownModel(
+                                            new LossModel(latentModel));
+                    tranches[j]->setLossModel(ownModel);
+                    Real own = tranches[j]->expectedTrancheLoss(dates[i]);
+
+                    // nor is the distribution in the reference model
+                    boost::shared_ptr<DefaultLossModel> referenceModel(
+                                            new ReferenceModel(latentModel));
+                    tranches[j]->setLossModel(referenceModel);
+                    Real reference =
+                        tranches[j]->expectedTrancheLoss(dates[i]);
+
+                    if (std::fabs(shared-own) > 1.0e-10)
+                        BOOST_ERROR(modelName << ": shared model mismatch"
+                                    << "\n    correlation: "
+                                    << correlation->value()
+                                    << "\n    tranche:     " << j
+                                    << "\n    date:        " << dates[i]
+                                    << "\n    shared:      " << shared
+                                    << "\n    own:         " << own);
+                    if (std::fabs(shared-reference) > 1.0e-8)
+                        BOOST_ERROR(modelName
+                                    << ": per-tranche integration mismatch"
+                                    << "\n    correlation: "
+                                    << correlation->value()
+                                    << "\n    tranche:     " << j
+                                    << "\n    date:        " << dates[i]
+                                    << "\n    shared:      " << shared
+                                    << "\n    per tranche: " << reference);
+                }
+                // the tranches add up to the whole pool
+                wholePool->setLossModel(sharedModel);
+                Real poolLoss = wholePool->expectedTrancheLoss(dates[i]);
+                if (std::fabs(totalLoss-poolLoss) > 1.0e-8*poolLoss)
+                    BOOST_ERROR(modelName << ": tranches do not add up"
+                                << "\n    correlation: "
+                                << correlation->value()
+                                << "\n    date:        " << dates[i]
+                                << "\n    tranches:    " << totalLoss
+                                << "\n    pool:        " << poolLoss);
+            }
+        }
+        correlation->setValue(0.3);
+    }
+
+}
+
+void CdoTest::testTrancheSharedLossModel() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing loss models shared among tranches...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(boost::shared_ptr<Quote>(
+                                                   new SimpleQuote(0.03))),
+                           ActualActual()));
+    std::vector<std::pair<DefaultProbKey,
+        Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0,Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+
+    boost::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    std::vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        notionals.push_back(i % 2 == 0 ? 100.0 : 200.0);
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    Real attachments[] = { 0.00, 0.03, 0.06, 0.10, 0.20 };
+    Real detachments[] = { 0.03, 0.06, 0.10, 0.20, 1.00 };
+    std::vector<boost::shared_ptr<Basket> > tranches;
+    for (Size j=0; j<LENGTH(attachments); ++j)
+        tranches.push_back(boost::shared_ptr<Basket>(
+            new Basket(asofDate, names, notionals, pool,
+                       attachments[j], detachments[j])));
+
+    boost::shared_ptr<Basket> wholePool(
+        new Basket(asofDate, names, notionals, pool, 0.0, 1.0));
+
+    boost::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    boost::shared_ptr<GaussianConstantLossLM> latentModel(
+        new GaussianConstantLossLM(Handle<Quote>(correlation),
+            std::vector<Real>(poolSize, 0.4),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    checkSharedLossModel<GaussianBinomialLossModel,
+                         PerTrancheBinomialLossModel>(
+        tranches, wholePool, latentModel, correlation, "binomial");
+    checkSharedLossModel<RecursiveGaussLossModel,
+                         PerTrancheRecursiveLossModel>(
+        tranches, wholePool, latentModel, correlation, "recursive");
+
+    #endif
+}
+
+void CdoTest::testRecursiveLossDistribution() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing recursive loss distribution "
+                       "on an inhomogeneous pool...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate,
+                           Handle<Quote>(boost::shared_ptr<Quote>(
+                                                   new SimpleQuote(0.03))),
+                           ActualActual()));
+    std::vector<std::pair<DefaultProbKey,
+        Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                   Period(0,Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr)));
+
+    boost::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    std::vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        notionals.push_back(i % 2 == 0 ? 100.0 : 200.0);
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    boost::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, notionals, pool, 0.0, 1.0));
+
+    Real recovery = 0.4;
+    boost::shared_ptr<GaussianConstantLossLM> latentModel(
+        new GaussianConstantLossLM(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.3))),
+            std::vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    // two buckets per smallest loss: the name losses are two and four
+    // loss units, so that odd multiples of the unit are not attainable
+    Size nBuckets = 2;
+    Real lossUnit = 100.0 * (1.0 - recovery) / nBuckets;
+    boost::shared_ptr<RecursiveGaussLossModel> lossModel(
+        new RecursiveGaussLossModel(latentModel, nBuckets));
+    basket->setLossModel(lossModel);
+
+    Date date = asofDate + 5*Years;
+    std::map<Real, Probability> distribution =
+        basket->lossDistribution(date);
+
+    // the expected pool loss only depends on the single-name defaults
+    std::vector<Probability> pd = basket->remainingProbabilities(date);
+    Real expected = 0.0;
+    for (Size i=0; i<poolSize; ++i)
+        expected += pd[i] * notionals[i] * (1.0 - recovery);
+
+    Real calculated = 0.0, previous = 0.0;
+    Size k = 0;
+    for (std::map<Real, Probability>::const_iterator it =
+             distribution.begin();
+         it != distribution.end(); ++it, ++k) {
+        if (std::fabs(it->first - k * lossUnit) > 1.0e-10)
+            BOOST_FAIL("loss " << it->first << " not on the loss unit "
+                       << k * lossUnit);
+        Probability p = it->second - previous;
+        if (k % 2 == 1 && std::fabs(p) > 1.0e-15)
+            BOOST_ERROR("non-null probability (" << p
+                        << ") of unattainable loss " << it->first);
+        calculated += it->first * p;
+        previous = it->second;
+    }
+    if (std::fabs(previous - 1.0) > 1.0e-10)
+        BOOST_ERROR("loss probabilities do not add up to one: " << previous);
+
+    if (std::fabs(calculated - expected) > 1.0e-6 * expected)
+        BOOST_ERROR("expected loss from the loss distribution mismatch"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    Real trancheLoss = basket->expectedTrancheLoss(date);
+    if (std::fabs(trancheLoss - expected) > 1.0e-6 * expected)
+        BOOST_ERROR("expected pool loss mismatch"
+                    << "\n    calculated: " << trancheLoss
+                    << "\n    expected:   " << expected);
+
+    #endif
+}
+
+void CdoTest::testFourierLossDistribution() {
+    BOOST_TEST_MESSAGE("Testing loss distribution by Fourier inversion "
+                       "against recursive convolutions...");
+
+    const Real tolerance = 1.0e-10;
+
+    // equal volumes: the whole pool fits the grid, no damping
+    Size nBuckets = 200;
+    Real maximum = 100.0, dx = maximum / nBuckets;
+    std::vector<Real> volumes(60, 1.0), probabilities;
+    for (Size i=0; i<volumes.size(); i++)
+        probabilities.push_back(0.02 + 0.003 * (i % 11));
+
+    Distribution expected = LossDistHomogeneous(nBuckets, maximum)(
+                                                    volumes, probabilities);
+    Distribution calculated = LossDistFFT(nBuckets, maximum)(
+                                                    volumes, probabilities);
+    for (Size k=0; k<nBuckets; k++) {
+        if (std::fabs(calculated.density(k) - expected.density(k)) * dx
+                                                             > tolerance)
+            BOOST_ERROR("homogeneous pool, bucket " << k << ":"
+                        << std::scientific << std::setprecision(10)
+                        << "\n    Fourier:   " << calculated.density(k) * dx
+                        << "\n    recursive: " << expected.density(k) * dx);
+    }
+
+    // volumes on the bucket grid: Hull-White bucketing is exact and the
+    // pool exceeds the grid, so that the damped inversion is tested
+    nBuckets = 400;
+    maximum = 200.0;
+    dx = maximum / nBuckets;
+    volumes.clear();
+    probabilities.clear();
+    for (Size i=0; i<200; i++) {
+        volumes.push_back(dx * (1 + i % 7));
+        probabilities.push_back(0.01 + 0.0005 * (i % 13));
+    }
+
+    expected = LossDistBucketing(nBuckets, maximum)(volumes, probabilities);
+    calculated = LossDistFFT(nBuckets, maximum)(volumes, probabilities);
+    for (Size k=0; k<nBuckets; k++) {
+        if (std::fabs(calculated.density(k) - expected.density(k)) * dx
+                                                             > tolerance)
+            BOOST_ERROR("inhomogeneous pool, bucket " << k << ":"
+                        << std::scientific << std::setprecision(10)
+                        << "\n    Fourier:   " << calculated.density(k) * dx
+                        << "\n    bucketing: " << expected.density(k) * dx);
+    }
+}
+
+
 test_suite* CdoTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     #ifndef QL_PATCH_SOLARIS
+    suite->add(QUANTLIB_TEST_CASE(CdoTest::testRandomDefaultWorkers));
+    suite->add(QUANTLIB_TEST_CASE(CdoTest::testSparseGridIntegration));
+    suite->add(QUANTLIB_TEST_CASE(CdoTest::testTrancheSharedLossModel));
+    suite->add(QUANTLIB_TEST_CASE(CdoTest::testRecursiveLossDistribution));
+    suite->add(QUANTLIB_TEST_CASE(CdoTest::testFourierLossDistribution));
     if (speed == Slow) {
         #define BOOST_PP_LOCAL_MACRO(n) \
             suite->add(QUANTLIB_TEST_CASE(boost::bind(&CdoTest::testHW, n)));
@@ -29,6 +29,11 @@
 class CdoTest {
   public:
     static void testHW(unsigned dataSet);
+    static void testRandomDefaultWorkers();
+    static void testSparseGridIntegration();
+    static void testTrancheSharedLossModel();
+    static void testRecursiveLossDistribution();
+    static void testFourierLossDistribution();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
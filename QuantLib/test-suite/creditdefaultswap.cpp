@@ -26,6 +26,8 @@
 #include <ql/pricingengines/credit/isdacdsengine.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
+#include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
@@ -713,6 +715,139 @@ void CreditDefaultSwapTest::testIsdaEngine() {
 
 }
 
+void CreditDefaultSwapTest::testIsdaEngineSharedCache() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing ISDA engine shared among credit-default swaps...");
+
+    SavedSettings backup;
+
+    Date tradeDate(21, May, 2009);
+    Settings::instance().evaluationDate() = tradeDate;
+
+    boost::shared_ptr<SimpleQuote> rate =
+        boost::make_shared<SimpleQuote>(0.02);
+    Handle<YieldTermStructure> discountCurve(
+        boost::make_shared<FlatForward>(0, WeekendsOnly(),
+                                        Handle<Quote>(rate),
+                                        Actual365Fixed()));
+
+    // credit curve bootstrapped on ISDA spread helpers
+    Integer tenors[] = { 1, 2, 3, 5, 7, 10 };
+    std::vector<boost::shared_ptr<SimpleQuote> > spreads;
+    std::vector<boost::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Size i=0; i<LENGTH(tenors); i++) {
+        spreads.push_back(boost::make_shared<SimpleQuote>(0.005 + 0.001*i));
+        helpers.push_back(boost::make_shared<SpreadCdsHelper>(
+            Handle<Quote>(spreads.back()), tenors[i] * Years, 1,
+            WeekendsOnly(), Quarterly, Following, DateGeneration::CDS,
+            Actual360(), 0.4, discountCurve, true, true, Date(),
+            Actual360(true), true, CreditDefaultSwap::ISDA));
+    }
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(
+        boost::make_shared<PiecewiseDefaultCurve<HazardRate, BackwardFlat> >(
+            0, WeekendsOnly(), helpers, Actual365Fixed()));
+
+    boost::shared_ptr<PricingEngine> sharedEngine =
+        boost::make_shared<IsdaCdsEngine>(probabilityCurve, 0.4,
+                                          discountCurve);
+
+    // a book of contracts with different maturities and coupons
+    Date termDates[] = { Date(20, June, 2010), Date(20, December, 2011),
+                         Date(20, June, 2014), Date(20, March, 2016),
+                         Date(20, December, 2018), Date(20, June, 2019) };
+    Rate coupons[] = { 0.001, 0.01, 0.05 };
+    std::vector<boost::shared_ptr<CreditDefaultSwap> > book, reference;
+    for (Size i=0; i<LENGTH(termDates); i++) {
+        for (Size j=0; j<LENGTH(coupons); j++) {
+            book.push_back(MakeCreditDefaultSwap(termDates[i], coupons[j])
+                           .withNominal(10000000.)
+                           .withPricingEngine(sharedEngine));
+            reference.push_back(MakeCreditDefaultSwap(termDates[i], coupons[j])
+                                .withNominal(10000000.)
+                                .withPricingEngine(
+                                    boost::make_shared<IsdaCdsEngine>(
+                                        probabilityCurve, 0.4,
+                                        discountCurve)));
+        }
+    }
+
+    const Real tolerance = 1.0e-8;
+
+    // the cached values must follow changes in either curve
+    for (Size scenario=0; scenario<3; scenario++) {
+        if (scenario == 1)
+            spreads[3]->setValue(spreads[3]->value() + 0.002);
+        else if (scenario == 2)
+            rate->setValue(0.03);
+
+        for (Size i=0; i<book.size(); i++) {
+            // fresh engines do not reuse any value
+            reference[i]->setPricingEngine(boost::make_shared<IsdaCdsEngine>(
+                probabilityCurve, 0.4, discountCurve));
+            Real calculated = book[i]->NPV();
+            Real expected = reference[i]->NPV();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce NPV with shared engine"
+                            << "\n    scenario:   " << scenario
+                            << "\n    maturity:   " << book[i]->protectionEndDate()
+                            << "\n    coupon:     "
+                            << io::rate(book[i]->runningSpread())
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        // the bootstrapped curve still reprices its helpers
+        for (Size i=0; i<helpers.size(); i++) {
+            Real error = helpers[i]->impliedQuote() - spreads[i]->value();
+            if (std::fabs(error) > 1.0e-10)
+                BOOST_ERROR("failed to reprice helper #" << i
+                            << "\n    scenario: " << scenario
+                            << "\n    error:    " << error);
+        }
+    }
+
+    // flat curves whose reference dates move with the evaluation date
+    // while their rates stay the same
+    RelinkableHandle<YieldTermStructure> flatDiscountCurve(
+        boost::make_shared<FlatForward>(0, WeekendsOnly(), 0.02,
+                                        Actual365Fixed()));
+    RelinkableHandle<DefaultProbabilityTermStructure> flatProbabilityCurve(
+        boost::make_shared<FlatHazardRate>(0, WeekendsOnly(), 0.01,
+                                           Actual365Fixed()));
+    sharedEngine = boost::make_shared<IsdaCdsEngine>(flatProbabilityCurve,
+                                                     0.4, flatDiscountCurve);
+    boost::shared_ptr<CreditDefaultSwap> swap =
+        MakeCreditDefaultSwap(Date(20, June, 2014), 0.01)
+        .withNominal(10000000.)
+        .withPricingEngine(sharedEngine);
+    swap->NPV();
+
+    for (Size scenario=0; scenario<2; scenario++) {
+        Settings::instance().evaluationDate() =
+            WeekendsOnly().advance(tradeDate, scenario+1, Days);
+        if (scenario == 0)
+            flatDiscountCurve.linkTo(boost::make_shared<FlatForward>(
+                0, WeekendsOnly(), 0.02, Actual365Fixed()));
+        else
+            flatProbabilityCurve.linkTo(boost::make_shared<FlatHazardRate>(
+                0, WeekendsOnly(), 0.01, Actual365Fixed()));
+
+        Real calculated = swap->NPV();
+        swap->setPricingEngine(boost::make_shared<IsdaCdsEngine>(
+            flatProbabilityCurve, 0.4, flatDiscountCurve));
+        Real expected = swap->NPV();
+        swap->setPricingEngine(sharedEngine);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce NPV after relinking flat curve"
+                        << "\n    scenario:   " << scenario
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
     suite->add(QUANTLIB_TEST_CASE(CreditDefaultSwapTest::testCachedValue));
@@ -721,5 +856,7 @@ test_suite* CreditDefaultSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(CreditDefaultSwapTest::testFairUpfront));
     suite->add(QUANTLIB_TEST_CASE(CreditDefaultSwapTest::testIsdaEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                          CreditDefaultSwapTest::testIsdaEngineSharedCache));
     return suite;
 }
@@ -119,8 +119,68 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
+void CreditRiskPlusTest::testFourierInversion() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit risk plus loss distribution by Fourier inversion...");
+
+    // inhomogeneous exposures in three correlated sectors
+    std::vector<Real> exposure, pd;
+    std::vector<Size> sector;
+    for (Size i = 0; i < 600; ++i) {
+        exposure.push_back(0.5 + 0.25 * (i % 17));
+        pd.push_back(0.005 + 0.001 * (i % 23));
+        sector.push_back(i % 3);
+    }
+
+    std::vector<Real> relativeDefaultVariance;
+    relativeDefaultVariance.push_back(0.75 * 0.75);
+    relativeDefaultVariance.push_back(0.60 * 0.60);
+    relativeDefaultVariance.push_back(0.90 * 0.90);
+
+    Matrix rho(3, 3, 0.30);
+    rho[0][0] = rho[1][1] = rho[2][2] = 1.0;
+
+    Real unit = 0.25;
+
+    CreditRiskPlus panjer(exposure, pd, sector, relativeDefaultVariance, rho,
+                          unit, CreditRiskPlus::PanjerRecursion);
+    CreditRiskPlus fourier(exposure, pd, sector, relativeDefaultVariance, rho,
+                           unit, CreditRiskPlus::FourierInversion);
+
+    const std::vector<Real>& expected = panjer.loss();
+    const std::vector<Real>& calculated = fourier.loss();
+    if (calculated.size() != expected.size())
+        BOOST_FAIL("loss distribution sizes differ ("
+                   << calculated.size() << " vs " << expected.size() << ")");
+
+    static const Real tol = 1.0E-10;
+    for (Size i = 0; i < expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tol)
+            BOOST_FAIL("failed to reproduce Panjer recursion at loss unit "
+                       << i << ":"
+                       << std::scientific << std::setprecision(10)
+                       << "\n    Fourier inversion: " << calculated[i]
+                       << "\n    Panjer recursion:  " << expected[i]
+                       << "\n    tolerance:         " << tol);
+    }
+
+    Real quantiles[] = { 0.90, 0.99, 0.999 };
+    for (Size i = 0; i < LENGTH(quantiles); ++i) {
+        Real q1 = panjer.lossQuantile(quantiles[i]);
+        Real q2 = fourier.lossQuantile(quantiles[i]);
+        if (std::fabs(q1 - q2) > 1.0E-6)
+            BOOST_FAIL("failed to reproduce " << quantiles[i]
+                       << " loss quantile:"
+                       << std::setprecision(10)
+                       << "\n    Fourier inversion: " << q2
+                       << "\n    Panjer recursion:  " << q1);
+    }
+}
+
 test_suite *CreditRiskPlusTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(CreditRiskPlusTest::testReferenceValues));
+    suite->add(QUANTLIB_TEST_CASE(CreditRiskPlusTest::testFourierInversion));
     return suite;
 }
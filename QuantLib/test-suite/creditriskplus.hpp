@@ -28,6 +28,7 @@
 class CreditRiskPlusTest {
   public:
     static void testReferenceValues();
+    static void testFourierInversion();
     static boost::unit_test_framework::test_suite *suite();
 };
 
@@ -32,6 +32,7 @@
 #include <ql/math/randomnumbers/stochasticcollocationinvcdf.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/functional.hpp>
+#include <ql/utilities/stopwatch.hpp>
 
 #if defined(__GNUC__) && !defined(__clang__) && BOOST_VERSION > 106300
 #pragma GCC diagnostic push
@@ -310,6 +311,141 @@ void DistributionTest::testNormal() {
     }
 }
 
+namespace {
+
+    template <class Accuracy>
+    void checkNormalAccuracy(const std::string& name,
+                             Real cumulativeTolerance,
+                             Real inverseTolerance) {
+
+        const CumulativeNormalDistribution cum;
+        const FastCumulativeNormal<Accuracy> fastCum;
+        const FastInverseCumulativeNormal<Accuracy> fastInvCum;
+
+        Real maxError = 0.0;
+        for (Real x=-40.0; x < 40.0; x+=0.001)
+            maxError = std::max(maxError, std::fabs(fastCum(x) - cum(x)));
+
+        if (maxError > cumulativeTolerance) {
+            BOOST_ERROR("maximum error of " << name
+                        << " cumulative normal: "
+                        << std::scientific << maxError << "\n"
+                        << "tolerance exceeded");
+        }
+
+        Real maxInverseError = 0.0;
+        for (Real u=1e-6; u < 1.0-1e-6; u+=1e-5)
+            maxInverseError = std::max(maxInverseError,
+                                       std::fabs(cum(fastInvCum(u)) - u));
+
+        if (maxInverseError > inverseTolerance) {
+            BOOST_ERROR("maximum error of " << name
+                        << " inverse cumulative normal: "
+                        << std::scientific << maxInverseError << "\n"
+                        << "tolerance exceeded");
+        }
+
+        // the bounds are returned as by InverseCumulativeNormal, and
+        // the far tails are not spoiled by the refinement
+        const InverseCumulativeNormal invCum;
+        const Real u[] = { 0.0, 1.0e-310, 1.0e-300, 1.0 };
+        for (Size i=0; i<LENGTH(u); ++i) {
+            const Real z = fastInvCum(u[i]);
+            const Real expected = invCum(u[i]);
+            if (!(std::fabs(z - expected) <= 1.0e-12*std::fabs(expected)))
+                BOOST_ERROR(name << " inverse cumulative normal failed "
+                            << "in the tails:"
+                            << std::scientific
+                            << "\n    u:          " << u[i]
+                            << "\n    calculated: " << z
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    template <class Cumulative, class InverseCumulative>
+    void benchmarkNormal(const std::string& name) {
+
+        const CumulativeNormalDistribution cum;
+        const Cumulative fastCum;
+        const InverseCumulative fastInvCum;
+
+        Real maxError = 0.0;
+        for (Real x=-40.0; x < 40.0; x+=0.001)
+            maxError = std::max(maxError, std::fabs(fastCum(x) - cum(x)));
+        Real maxInverseError = 0.0;
+        for (Real u=1e-6; u < 1.0-1e-6; u+=1e-5)
+            maxInverseError = std::max(maxInverseError,
+                                       std::fabs(cum(fastInvCum(u)) - u));
+
+        const Size n = 2000000;
+        Real sum = 0.0;
+        StopWatch watch;
+        for (Size i=0; i < n; ++i)
+            sum += fastCum(-8.0 + 16.0*i/n);
+        const Real cumTime = watch.elapsed();
+        watch.restart();
+        for (Size i=0; i < n; ++i)
+            sum += fastInvCum((i+0.5)/n);
+        const Real invCumTime = watch.elapsed();
+
+        BOOST_TEST_MESSAGE("    " << std::setw(28) << std::left << name
+                           << std::scientific << std::setprecision(2)
+                           << "max error " << maxError
+                           << " / " << maxInverseError << ", "
+                           << std::fixed << std::setprecision(1)
+                           << 1.0e9*cumTime/n << " / "
+                           << 1.0e9*invCumTime/n << " ns"
+                           << (sum == 0.0 ? " " : ""));
+    }
+
+}
+
+void DistributionTest::testNormalAccuracyPolicies() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing normal distributions with selectable accuracy...");
+
+    checkNormalAccuracy<FullNormalAccuracy>("full accuracy", 1e-16, 1e-15);
+    checkNormalAccuracy<HighNormalAccuracy>("high accuracy", 1e-14, 1e-14);
+    checkNormalAccuracy<LowNormalAccuracy>("low accuracy", 7.5e-8, 1e-9);
+
+    // average and standard deviation are taken into account
+    const CumulativeNormalDistribution cum(average, sigma);
+    const FastCumulativeNormal<HighNormalAccuracy> fastCum(average, sigma);
+    const FastInverseCumulativeNormal<FullNormalAccuracy>
+        fastInvCum(average, sigma);
+    for (Real x=average-5*sigma; x < average+5*sigma; x+=0.01) {
+        if (std::fabs(fastCum(x) - cum(x)) > 1e-14
+            || std::fabs(fastCum.derivative(x) - cum.derivative(x)) > 1e-15
+            || std::fabs(fastInvCum(cum(x)) - x) > 1e-9) {
+            BOOST_ERROR("failed to reproduce cumulative normal distribution"
+                        << "\n    x:          " << x
+                        << "\n    cumulative: " << fastCum(x)
+                        << "\n    expected:   " << cum(x)
+                        << "\n    inverse:    " << fastInvCum(cum(x)));
+        }
+    }
+}
+
+void DistributionTest::testNormalAccuracyPerformance() {
+
+    BOOST_TEST_MESSAGE("Benchmarking normal distributions with "
+                       "selectable accuracy...");
+    BOOST_TEST_MESSAGE("    (cumulative / inverse cumulative)");
+
+    benchmarkNormal<CumulativeNormalDistribution,
+                    InverseCumulativeNormal>("default classes");
+    benchmarkNormal<FastCumulativeNormal<FullNormalAccuracy>,
+                    FastInverseCumulativeNormal<FullNormalAccuracy> >(
+                                                        "full accuracy");
+    benchmarkNormal<FastCumulativeNormal<HighNormalAccuracy>,
+                    FastInverseCumulativeNormal<HighNormalAccuracy> >(
+                                                        "high accuracy");
+    benchmarkNormal<FastCumulativeNormal<LowNormalAccuracy>,
+                    FastInverseCumulativeNormal<LowNormalAccuracy> >(
+                                                        "low accuracy");
+}
+
 void DistributionTest::testBivariate() {
 
     BOOST_TEST_MESSAGE("Testing bivariate cumulative normal distribution...");
@@ -721,6 +857,8 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
 
     suite->add(QUANTLIB_TEST_CASE(DistributionTest::testNormal));
+    suite->add(QUANTLIB_TEST_CASE(
+                           DistributionTest::testNormalAccuracyPolicies));
     suite->add(QUANTLIB_TEST_CASE(DistributionTest::testBivariate));
     suite->add(QUANTLIB_TEST_CASE(DistributionTest::testPoisson));
     suite->add(QUANTLIB_TEST_CASE(DistributionTest::testCumulativePoisson));
@@ -732,6 +870,11 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
         suite->add(QUANTLIB_TEST_CASE(DistributionTest::testBivariateCumulativeStudentVsBivariate));
     }
 
+    if (speed == Slow) {
+        suite->add(QUANTLIB_TEST_CASE(
+                         DistributionTest::testNormalAccuracyPerformance));
+    }
+
     return suite;
 }
 
@@ -31,6 +31,8 @@
 class DistributionTest {
   public:
     static void testNormal();
+    static void testNormalAccuracyPolicies();
+    static void testNormalAccuracyPerformance();
     static void testBivariate();
     static void testPoisson();
     static void testCumulativePoisson();
@@ -27,6 +27,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -38,6 +39,11 @@
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/cachedlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <boost/make_shared.hpp>
@@ -1251,6 +1257,66 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcEnginesNormalAccuracy() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engines with "
+                       "accurate inverse normal...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual360();
+
+    const boost::shared_ptr<BlackScholesMertonProcess> process =
+        boost::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(boost::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.06, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    EuropeanOption option(
+        boost::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        boost::make_shared<EuropeanExercise>(today + 1*Years));
+
+    option.setPricingEngine(
+        boost::make_shared<AnalyticEuropeanEngine>(process));
+    const Real analytic = option.NPV();
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1).withSamples(20000).withSeed(42));
+    const Real pseudo = option.NPV();
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<HighAccuracyPseudoRandom>(process)
+        .withSteps(1).withSamples(20000).withSeed(42));
+    const Real accuratePseudo = option.NPV();
+    const Real error = option.errorEstimate();
+
+    option.setPricingEngine(MakeMCEuropeanEngine<LowDiscrepancy>(process)
+                            .withSteps(1).withSamples(4095));
+    const Real quasi = option.NPV();
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<HighAccuracyLowDiscrepancy>(process)
+        .withSteps(1).withSamples(4095));
+    const Real accurateQuasi = option.NPV();
+
+    // the same uniforms are mapped to variates differing by about 1e-9
+    if (std::fabs(accuratePseudo - pseudo) > 1.0e-6
+        || std::fabs(accurateQuasi - quasi) > 1.0e-6)
+        BOOST_ERROR("accurate inverse normal changes Monte Carlo prices:"
+                    << "\n    pseudo-random:     " << pseudo
+                    << " vs " << accuratePseudo
+                    << "\n    low-discrepancy:   " << quasi
+                    << " vs " << accurateQuasi);
+    if (std::fabs(accuratePseudo - analytic) > 3.0*error
+        || std::fabs(accurateQuasi - analytic) > 0.01*analytic)
+        BOOST_ERROR("failed to reproduce analytic price:"
+                    << "\n    analytic:          " << analytic
+                    << "\n    pseudo-random:     " << accuratePseudo
+                    << " +/- " << error
+                    << "\n    low-discrepancy:   " << accurateQuasi);
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_TEST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1514,6 +1580,394 @@ void EuropeanOptionTest::testLocalVolatility() {
     }
 }
 
+namespace {
+
+    // smile around 100 with a mild term structure
+    boost::shared_ptr<BlackVarianceSurface> smileSurface(
+                                            const Date& today,
+                                            const Calendar& calendar,
+                                            const DayCounter& dayCounter) {
+        std::vector<Date> dates;
+        for (Size i=1; i<=20; ++i)
+            dates.push_back(today + Period(3*i, Months));
+        std::vector<Real> strikes;
+        for (Size i=0; i<=16; ++i)
+            strikes.push_back(40.0 + 10.0*i);
+
+        Matrix blackVolMatrix(strikes.size(), dates.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real x = std::log(strikes[i]/100.0);
+            for (Size j=0; j < dates.size(); ++j) {
+                const Time t = dayCounter.yearFraction(today, dates[j]);
+                blackVolMatrix[i][j] =
+                    0.2 + 0.02*std::exp(-t) - 0.05*x + 0.08*x*x;
+            }
+        }
+
+        return boost::make_shared<BlackVarianceSurface>(
+            today, calendar, dates, strikes, blackVolMatrix, dayCounter);
+    }
+
+}
+
+void EuropeanOptionTest::testCachedLocalVolatility() {
+    BOOST_TEST_MESSAGE("Testing cached local volatility surface...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const boost::shared_ptr<SimpleQuote> s0(new SimpleQuote(100.0));
+    const Handle<Quote> spot(s0);
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dayCounter));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dayCounter));
+
+    const boost::shared_ptr<BlackVarianceSurface> volTS =
+        smileSurface(today, calendar, dayCounter);
+    const Handle<BlackVolTermStructure> blackTS(volTS);
+
+    const LocalVolSurface expected(blackTS, rTS, qTS, spot);
+
+    std::vector<Time> times;
+    for (Size i=1; i<=45; ++i)
+        times.push_back(0.1*i);
+    const Size strikePoints = 101;
+
+    const CachedLocalVolSurface::StrikeInterpolation interpolations[] =
+        { CachedLocalVolSurface::LinearInLogStrike,
+          CachedLocalVolSurface::CubicInLogStrike };
+
+    for (Size n=0; n<LENGTH(interpolations); ++n) {
+
+        // bilinear variance surface: the grid is filled by the
+        // finite-difference local vol
+        volTS->setInterpolation<Bilinear>();
+        const CachedLocalVolSurface cached(blackTS, rTS, qTS, spot, times,
+                                           60.0, 160.0, strikePoints,
+                                           interpolations[n]);
+
+        for (Size i=0; i<times.size(); i+=4) {
+            for (Size j=0; j<strikePoints; j+=10) {
+                const Real strike = std::exp(cached.logStrikes()[j]);
+                const Volatility calculated =
+                    cached.localVol(times[i], strike, true);
+                const Volatility expectedVol =
+                    expected.localVol(times[i], strike, true);
+                if (std::fabs(calculated - expectedVol) > 1.0e-10)
+                    BOOST_ERROR("failed to reproduce local vol on grid node"
+                                << "\n    time:       " << times[i]
+                                << "\n    strike:     " << strike
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expectedVol);
+            }
+        }
+
+        // bicubic variance surface: analytic derivatives are used,
+        // and the grid must be rebuilt after the notification
+        volTS->setInterpolation<Bicubic>();
+
+        const Real tolerance = 2.0e-3;
+        for (Size k=0; k<2; ++k) {
+            for (Time t=0.25; t<4.4; t+=0.37) {
+                for (Real strike=65.0; strike<155.0; strike+=7.3) {
+                    const Volatility calculated =
+                        cached.localVol(t, strike, true);
+                    const Volatility expectedVol =
+                        expected.localVol(t, strike, true);
+                    if (std::fabs(calculated - expectedVol) > tolerance)
+                        BOOST_ERROR("failed to reproduce local vol"
+                                    << "\n    spot:       " << s0->value()
+                                    << "\n    time:       " << t
+                                    << "\n    strike:     " << strike
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expectedVol
+                                    << "\n    tolerance:  " << tolerance);
+                }
+            }
+            // moving the spot must invalidate the grid
+            s0->setValue(105.0);
+        }
+        s0->setValue(100.0);
+    }
+}
+
+void EuropeanOptionTest::testBatchedLocalVolatility() {
+    BOOST_TEST_MESSAGE("Testing batched local volatility evaluation...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dayCounter));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dayCounter));
+
+    const boost::shared_ptr<BlackVarianceSurface> volTS =
+        smileSurface(today, calendar, dayCounter);
+    volTS->setInterpolation<Bicubic>();
+    const Handle<BlackVolTermStructure> blackTS(volTS);
+
+    std::vector<Time> times;
+    for (Size i=1; i<=10; ++i)
+        times.push_back(0.4*i);
+    const boost::shared_ptr<Matrix> fixedVols(new Matrix(21, times.size()));
+    std::vector<Real> fixedStrikes(fixedVols->rows());
+    for (Size i=0; i < fixedVols->rows(); ++i) {
+        fixedStrikes[i] = 50.0 + 5.0*i;
+        for (Size j=0; j < fixedVols->columns(); ++j)
+            (*fixedVols)[i][j] = 0.2 + 0.001*i - 0.002*j;
+    }
+
+    std::vector<boost::shared_ptr<LocalVolTermStructure> > surfaces;
+    surfaces.push_back(
+        boost::make_shared<LocalVolSurface>(blackTS, rTS, qTS, spot));
+    surfaces.push_back(boost::make_shared<NoExceptLocalVolSurface>(
+        blackTS, rTS, qTS, spot, 0.25));
+    surfaces.push_back(boost::make_shared<CachedLocalVolSurface>(
+        blackTS, rTS, qTS, spot, times, 50.0, 180.0, 51,
+        CachedLocalVolSurface::CubicInLogStrike));
+    surfaces.push_back(boost::make_shared<FixedLocalVolSurface>(
+        today, times, fixedStrikes, fixedVols, dayCounter));
+    surfaces.push_back(
+        boost::make_shared<LocalConstantVol>(today, 0.3, dayCounter));
+
+    Array strikes(40);
+    for (Size i=0; i < strikes.size(); ++i)
+        strikes[i] = 55.0 + 3.1*i;
+
+    const Time t[] = { 0.0, 0.3, 1.0, 2.55, 4.0 };
+    for (Size n=0; n < surfaces.size(); ++n) {
+        for (Size k=0; k < LENGTH(t); ++k) {
+            Array vols;
+            surfaces[n]->localVols(t[k], strikes, vols, true);
+            for (Size i=0; i < strikes.size(); ++i) {
+                const Volatility expected =
+                    surfaces[n]->localVol(t[k], strikes[i], true);
+                if (std::fabs(vols[i] - expected) > 1.0e-14)
+                    BOOST_ERROR("batched local vol differs from single one"
+                                << "\n    surface:    " << n
+                                << "\n    time:       " << t[k]
+                                << "\n    strike:     " << strikes[i]
+                                << "\n    batched:    " << vols[i]
+                                << "\n    single:     " << expected);
+            }
+        }
+    }
+
+    // without extrapolation, strikes outside the surface must be rejected
+    Array outside(1, volTS->maxStrike()*1.5), vols;
+    bool thrown = false;
+    try {
+        surfaces[0]->localVols(1.0, outside, vols);
+    } catch (Error&) {
+        thrown = true;
+    }
+    if (!thrown)
+        BOOST_ERROR("batched local vol accepted a strike outside the range"
+                    << "\n    strike:     " << outside[0]);
+
+    // a failing time slice must give the overwrite value, as the
+    // single evaluation does
+    const Volatility overwrite = 0.25;
+    const NoExceptLocalVolSurface noRates(
+        blackTS, Handle<YieldTermStructure>(), qTS, spot, overwrite);
+    noRates.localVols(1.0, strikes, vols, true);
+    for (Size i=0; i < strikes.size(); ++i) {
+        const Volatility single = noRates.localVol(1.0, strikes[i], true);
+        if (vols[i] != overwrite || single != overwrite)
+            BOOST_ERROR("failing local vol not overwritten"
+                        << "\n    strike:     " << strikes[i]
+                        << "\n    batched:    " << vols[i]
+                        << "\n    single:     " << single
+                        << "\n    expected:   " << overwrite);
+    }
+}
+
+void EuropeanOptionTest::testBlackVarianceSurfaceSlices() {
+    BOOST_TEST_MESSAGE("Testing Black variance surface slices...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    std::vector<Date> dates;
+    for (Size i=1; i<=8; ++i)
+        dates.push_back(today + Period(6*i, Months));
+    std::vector<Real> strikes;
+    for (Size i=0; i<=10; ++i)
+        strikes.push_back(50.0 + 10.0*i);
+
+    Matrix vols(strikes.size(), dates.size());
+    for (Size i=0; i<strikes.size(); ++i) {
+        const Real x = std::log(strikes[i]/100.0);
+        for (Size j=0; j<dates.size(); ++j)
+            vols[i][j] = 0.25 - 0.01*j - 0.1*x + 0.15*x*x;
+    }
+
+    const boost::shared_ptr<BlackVarianceSurface> surface =
+        boost::make_shared<BlackVarianceSurface>(
+            today, calendar, dates, strikes, vols, dayCounter,
+            BlackVarianceSurface::ConstantExtrapolation,
+            BlackVarianceSurface::InterpolatorDefaultExtrapolation);
+
+    // reference bicubic interpolation of the same variances
+    std::vector<Time> times(1, 0.0);
+    Matrix variances(strikes.size(), dates.size()+1, 0.0);
+    for (Size j=0; j<dates.size(); ++j) {
+        times.push_back(dayCounter.yearFraction(today, dates[j]));
+        for (Size i=0; i<strikes.size(); ++i)
+            variances[i][j+1] = times.back()*vols[i][j]*vols[i][j];
+    }
+
+    std::vector<Time> testTimes;
+    for (Time t=0.1; t<5.0; t+=0.35)
+        testTimes.push_back(t);
+    testTimes.push_back(times[3]);
+    std::vector<Real> testStrikes;
+    for (Real k=35.0; k<170.0; k+=6.5)
+        testStrikes.push_back(k);
+    testStrikes.push_back(strikes[4]);
+
+    for (Size n=0; n<2; ++n) {
+        if (n == 0)
+            surface->setInterpolation<Bilinear>();
+        else
+            surface->setInterpolation<Bicubic>();
+        Interpolation2D reference = n == 0 ?
+            Bilinear().interpolate(times.begin(), times.end(),
+                                   strikes.begin(), strikes.end(),
+                                   variances) :
+            Bicubic().interpolate(times.begin(), times.end(),
+                                  strikes.begin(), strikes.end(),
+                                  variances);
+        const Real tolerance = 1.0e-14;
+
+        for (Size i=0; i<testTimes.size(); ++i) {
+            const Time t = testTimes[i];
+            boost::shared_ptr<const BlackVarianceSurface::Slice> slice =
+                surface->slice(t);
+            if (surface->slice(t) != slice)
+                BOOST_ERROR("slice not cached at time " << t);
+            for (Size j=0; j<testStrikes.size(); ++j) {
+                const Real k = testStrikes[j];
+                const Real clamped = std::max(k, strikes.front());
+                const Real expected = t <= times.back() ?
+                    reference(t, clamped, true) :
+                    reference(times.back(), clamped, true)*t/times.back();
+                const Real calculated = surface->blackVariance(t, k, true);
+                const Real fromSlice = slice->blackVariance(k);
+                if (std::fabs(calculated - expected) > tolerance
+                    || std::fabs(fromSlice - expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce "
+                                << (n == 0 ? "bilinear" : "bicubic")
+                                << " variance"
+                                << "\n    time:       " << t
+                                << "\n    strike:     " << k
+                                << "\n    surface:    " << calculated
+                                << "\n    slice:      " << fromSlice
+                                << "\n    expected:   " << expected);
+                const Volatility vol = slice->blackVol(k);
+                if (std::fabs(vol - std::sqrt(fromSlice/t)) > tolerance)
+                    BOOST_ERROR("inconsistent slice volatility"
+                                << "\n    time:       " << t
+                                << "\n    strike:     " << k
+                                << "\n    volatility: " << vol
+                                << "\n    variance:   " << fromSlice);
+            }
+        }
+    }
+
+    // in-place updates must match a surface built from the new quotes
+    Flag flag;
+    flag.registerWith(surface);
+    Matrix newVols = vols;
+    newVols[3][2] += 0.05;
+    surface->setVolatility(3, 2, newVols[3][2]);
+    if (!flag.isUp())
+        BOOST_ERROR("observers not notified of volatility update");
+    for (Size i=0; i<strikes.size(); ++i)
+        for (Size j=0; j<dates.size(); ++j)
+            newVols[i][j] *= 1.1;
+    boost::shared_ptr<const BlackVarianceSurface::Slice> oldSlice =
+        surface->slice(1.3);
+    surface->setVolatilities(newVols);
+
+    BlackVarianceSurface rebuilt(today, calendar, dates, strikes, newVols,
+                                 dayCounter,
+                                 BlackVarianceSurface::ConstantExtrapolation,
+                                 BlackVarianceSurface::
+                                 InterpolatorDefaultExtrapolation);
+    rebuilt.setInterpolation<Bicubic>();
+    if (surface->slice(1.3) == oldSlice)
+        BOOST_ERROR("stale slice returned after volatility update");
+    for (Size i=0; i<testTimes.size(); ++i) {
+        for (Size j=0; j<testStrikes.size(); ++j) {
+            const Time t = testTimes[i];
+            const Real k = testStrikes[j];
+            const Real calculated = surface->blackVariance(t, k, true);
+            const Real expected = rebuilt.blackVariance(t, k, true);
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce variance after update"
+                            << "\n    time:       " << t
+                            << "\n    strike:     " << k
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // slices must stay usable after their surface is gone, also for
+    // interpolations without a one-dimensional counterpart
+    for (Size n=0; n<2; ++n) {
+        std::vector<boost::shared_ptr<const BlackVarianceSurface::Slice> >
+            slices;
+        std::vector<Real> expected;
+        {
+            BlackVarianceSurface temporary(
+                today, calendar, dates, strikes, newVols, dayCounter,
+                BlackVarianceSurface::ConstantExtrapolation,
+                BlackVarianceSurface::InterpolatorDefaultExtrapolation);
+            if (n == 0)
+                temporary.setInterpolation<Bicubic>();
+            else
+                temporary.setInterpolation<BackwardflatLinear>();
+            for (Size i=0; i<testTimes.size(); ++i) {
+                slices.push_back(temporary.slice(testTimes[i]));
+                for (Size j=0; j<testStrikes.size(); ++j)
+                    expected.push_back(temporary.blackVariance(
+                        testTimes[i], testStrikes[j], true));
+            }
+        }
+        for (Size i=0; i<testTimes.size(); ++i) {
+            for (Size j=0; j<testStrikes.size(); ++j) {
+                const Real calculated =
+                    slices[i]->blackVariance(testStrikes[j]);
+                const Real e = expected[i*testStrikes.size()+j];
+                if (std::fabs(calculated - e) > 1.0e-14)
+                    BOOST_ERROR("slice differs from its former surface"
+                                << "\n    interpolation: "
+                                << (n == 0 ? "bicubic" :
+                                             "backward-flat linear")
+                                << "\n    time:       " << testTimes[i]
+                                << "\n    strike:     " << testStrikes[j]
+                                << "\n    slice:      " << calculated
+                                << "\n    expected:   " << e);
+            }
+        }
+    }
+}
+
 void EuropeanOptionTest::testAnalyticEngineDiscountCurve() {
     BOOST_TEST_MESSAGE(
         "Testing separate discount curve for analytic European engine...");
@@ -1706,11 +2160,19 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testFdEngines));
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testMcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                            EuropeanOptionTest::testMcEnginesNormalAccuracy));
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testQmcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                            EuropeanOptionTest::testCachedLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                            EuropeanOptionTest::testBatchedLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                        EuropeanOptionTest::testBlackVarianceSurfaceSlices));
 
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testAnalyticEngineDiscountCurve));
     suite->add(QUANTLIB_TEST_CASE(EuropeanOptionTest::testPDESchemes));
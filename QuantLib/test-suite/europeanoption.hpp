@@ -44,9 +44,13 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMcEnginesNormalAccuracy();
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
+    static void testCachedLocalVolatility();
+    static void testBatchedLocalVolatility();
+    static void testBlackVarianceSurfaceSlices();
     static void testAnalyticEngineDiscountCurve();
     static void testPDESchemes();
 
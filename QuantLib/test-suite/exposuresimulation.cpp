@@ -0,0 +1,214 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "exposuresimulation.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/exposuresimulation.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+void ExposureSimulationTest::testSwaptionExposure() {
+
+    BOOST_TEST_MESSAGE("Testing simulated exposure of a forward "
+                       "starting swap against swaption prices...");
+
+    SavedSettings backup;
+
+    Date today(15, January, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(today, 0.03, Actual365Fixed())));
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(yts));
+
+    boost::shared_ptr<Gsr> model(new Gsr(
+        yts, std::vector<Date>(), std::vector<Real>(1, 0.01), 0.01));
+    boost::shared_ptr<PricingEngine> swaptionEngine(
+        new Gaussian1dSwaptionEngine(model, 64, 7.0));
+
+    Period forwardStarts[] = { 1*Years, 3*Years, 5*Years };
+    Rate strikes[] = { 0.02, 0.03, 0.04 };
+
+    for (Size i=0; i<LENGTH(forwardStarts); ++i) {
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            boost::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(5*Years, euribor6m, strikes[j],
+                                forwardStarts[i])
+                .withNominal(100.0);
+            // the exposure at the first fixing is the swaption payoff
+            Date expiry = boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                   swap->floatingLeg().front())->fixingDate();
+            Swaption swaption(swap, boost::shared_ptr<Exercise>(
+                                  new EuropeanExercise(expiry)));
+            swaption.setPricingEngine(swaptionEngine);
+
+            ExposureSimulation simulation(
+                model, std::vector<boost::shared_ptr<VanillaSwap> >(1, swap),
+                std::vector<boost::shared_ptr<FixedRateBond> >(),
+                std::vector<Date>(1, expiry), 20000);
+
+            Real expected = swaption.NPV();
+            Real calculated = simulation.discountedExpectedExposure()[0];
+            Real tolerance = 0.02 * expected + 0.01;
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption price with "
+                            "simulated exposure:"
+                            << "\n    forward start: " << forwardStarts[i]
+                            << "\n    strike:        " << strikes[j]
+                            << "\n    swaption:      " << expected
+                            << "\n    exposure:      " << calculated
+                            << "\n    tolerance:     " << tolerance);
+        }
+    }
+}
+
+void ExposureSimulationTest::testNettingSet() {
+
+    BOOST_TEST_MESSAGE("Testing simulated exposure of a netting set...");
+
+    SavedSettings backup;
+
+    Date today(15, January, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(today, 0.03, Actual365Fixed())));
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(yts));
+    // past fixing of the coupon alive at the evaluation date
+    euribor6m->addFixing(Date(13, October, 2014), 0.025);
+
+    boost::shared_ptr<Gsr> model(new Gsr(
+        yts, std::vector<Date>(), std::vector<Real>(1, 0.008), 0.02));
+
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    swaps.push_back(MakeVanillaSwap(10*Years, euribor6m, 0.035)
+                    .withEffectiveDate(Date(15, October, 2014))
+                    .withNominal(100.0));
+    swaps.push_back(MakeVanillaSwap(4*Years, euribor6m, 0.025, 1*Years)
+                    .withType(VanillaSwap::Receiver)
+                    .withFloatingLegSpread(0.001)
+                    .withNominal(50.0));
+
+    Schedule schedule(Date(20, March, 2013), Date(20, March, 2020),
+                      1*Years, TARGET(), Following, Following,
+                      DateGeneration::Backward, false);
+    std::vector<boost::shared_ptr<FixedRateBond> > bonds(1,
+        boost::shared_ptr<FixedRateBond>(
+            new FixedRateBond(2, 30.0, schedule,
+                              std::vector<Rate>(1, 0.04),
+                              Thirty360())));
+
+    std::vector<Date> dates;
+    for (Size i=1; i<=40; ++i)
+        dates.push_back(TARGET().advance(today, 3*i, Months));
+
+    ExposureSimulation simulation(model, swaps, bonds, dates, 20000);
+
+    // the expected deflated value is the value of the remaining flows
+    std::vector<Leg> legs;
+    std::vector<Real> signs;
+    for (Size i=0; i<swaps.size(); ++i) {
+        Real sign = swaps[i]->type() == VanillaSwap::Payer ? -1.0 : 1.0;
+        legs.push_back(swaps[i]->fixedLeg());
+        signs.push_back(sign);
+        legs.push_back(swaps[i]->floatingLeg());
+        signs.push_back(-sign);
+    }
+    legs.push_back(bonds[0]->cashflows());
+    signs.push_back(1.0);
+
+    const std::vector<Real>& dee = simulation.discountedExpectedExposure();
+    const std::vector<Real>& dene =
+        simulation.discountedExpectedNegativeExposure();
+
+    for (Size k=0; k<dates.size(); ++k) {
+        Real expected = 0.0;
+        for (Size l=0; l<legs.size(); ++l)
+            for (Size i=0; i<legs[l].size(); ++i)
+                if (legs[l][i]->date() > dates[k])
+                    expected += signs[l] * legs[l][i]->amount()
+                              * yts->discount(legs[l][i]->date());
+        Real calculated = dee[k] - dene[k];
+        Real tolerance = 0.2;
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce value of remaining flows:"
+                        << "\n    date:       " << dates[k]
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated
+                        << "\n    tolerance:  " << tolerance);
+    }
+
+    Real recovery = 0.4;
+    Handle<DefaultProbabilityTermStructure> hazard(
+        boost::shared_ptr<DefaultProbabilityTermStructure>(
+            new FlatHazardRate(today, 0.02, Actual365Fixed())));
+    Real expected = 0.0;
+    Probability previous = 1.0;
+    for (Size k=0; k<dates.size(); ++k) {
+        Probability p = hazard->survivalProbability(dates[k]);
+        expected += (1.0 - recovery) * dee[k] * (previous - p);
+        previous = p;
+    }
+    Real calculated = simulation.cva(hazard, recovery);
+    if (std::fabs(calculated - expected) > 1.0e-12)
+        BOOST_ERROR("failed to reproduce cva:"
+                    << "\n    expected:   " << expected
+                    << "\n    calculated: " << calculated);
+
+    // a new fixing of the alive coupon must invalidate the cached
+    // exposures at a date before its payment
+    boost::shared_ptr<ExposureSimulation> early(new ExposureSimulation(
+        model, swaps, bonds, std::vector<Date>(1, Date(16, February, 2015)),
+        2000));
+    Real before = early->discountedExpectedExposure()[0]
+                - early->discountedExpectedNegativeExposure()[0];
+    Flag flag;
+    flag.registerWith(early);
+    euribor6m->addFixing(Date(13, October, 2014), 0.03, true);
+    if (!flag.isUp())
+        BOOST_ERROR("simulation not notified of a new fixing");
+    Real after = early->discountedExpectedExposure()[0]
+               - early->discountedExpectedNegativeExposure()[0];
+    boost::shared_ptr<Coupon> coupon =
+        boost::dynamic_pointer_cast<Coupon>(swaps[0]->floatingLeg().front());
+    Real expectedChange = coupon->nominal() * coupon->accrualPeriod()
+                        * 0.005 * yts->discount(coupon->date());
+    if (std::fabs(after - before - expectedChange) > 1.0e-3)
+        BOOST_ERROR("failed to reproduce the effect of a new fixing:"
+                    << "\n    before:     " << before
+                    << "\n    after:      " << after
+                    << "\n    expected change: " << expectedChange);
+}
+
+test_suite* ExposureSimulationTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Exposure simulation tests");
+    suite->add(QUANTLIB_TEST_CASE(
+        ExposureSimulationTest::testSwaptionExposure));
+    suite->add(QUANTLIB_TEST_CASE(ExposureSimulationTest::testNettingSet));
+    return suite;
+}
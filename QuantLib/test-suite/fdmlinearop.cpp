@@ -760,6 +760,58 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
 }
 
 
+void FdmLinearOpTest::testTripleBandSolveSerialVsParallel() {
+
+    BOOST_TEST_MESSAGE("Testing serial and parallel triple-band solutions...");
+
+    // large enough for the lines to be solved concurrently
+    Size dims[] = {50, 40, 30};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries(
+        dim.size(), std::pair<Real, Real>(-1.0, 2.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array r(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        r[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const Real a = -0.3, b = 1.0;
+    for (Size d=0; d < dim.size(); ++d) {
+        SecondDerivativeOp op(d, mesher);
+        op.axpyb(Array(1, 0.5), FirstDerivativeOp(d, mesher), op, Array());
+
+        Array serial;
+        {
+            SerialSection serialSection;
+            serial = op.solve_splitting(r, a, b);
+        }
+        const Array parallel = op.solve_splitting(r, a, b);
+        const Array residual = a*op.apply(parallel) + b*parallel - r;
+
+        for (Size i=0; i < r.size(); ++i) {
+            if (parallel[i] != serial[i]) {
+                BOOST_FAIL("serial and parallel solutions differ"
+                           << "\n direction     : " << d
+                           << "\n index         : " << i
+                           << std::setprecision(16)
+                           << "\n serial        : " << serial[i]
+                           << "\n parallel      : " << parallel[i]);
+            }
+            if (std::fabs(residual[i]) > 1e-10) {
+                BOOST_FAIL("parallel solution does not solve the system"
+                           << "\n direction     : " << d
+                           << "\n index         : " << i
+                           << "\n residual      : " << residual[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1759,6 +1811,8 @@ test_suite* FdmLinearOpTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testDerivativeWeightsOnNonUniformGrids));
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(
+        FdmLinearOpTest::testTripleBandSolveSerialVsParallel));
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(FdmLinearOpTest::testFdmHestonExpress));
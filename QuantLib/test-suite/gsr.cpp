@@ -285,9 +285,220 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testStateGrids() {
+
+    BOOST_TEST_MESSAGE("Testing GSR model state grids...");
+
+    SavedSettings backup;
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> yts2(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.02, Actual365Fixed())));
+
+    std::vector<Date> stepDates;
+    std::vector<Handle<Quote> > vols;
+    boost::shared_ptr<SimpleQuote> vol0(new SimpleQuote(0.01)),
+        vol1(new SimpleQuote(0.012));
+    stepDates.push_back(TARGET().advance(refDate, 3 * Years));
+    vols.push_back(Handle<Quote>(vol0));
+    vols.push_back(Handle<Quote>(vol1));
+    Handle<Quote> reversion(
+        boost::shared_ptr<Quote>(new SimpleQuote(0.02)));
+    boost::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversion, 50.0));
+    boost::shared_ptr<IborIndex> ibor(new Euribor6M);
+    boost::shared_ptr<IborIndex> ibor2(new Euribor6M(yts2));
+
+    // the grids must reproduce the pointwise values exactly, both for
+    // the model curve (cached) and for another curve (not cached)
+
+    Real yStdDevs = 7.0;
+    int gridPoints = 16;
+    Date fixing = TARGET().advance(refDate, 5 * Years);
+    Date expiry = TARGET().advance(refDate, 4 * Years);
+    Time t = yts->timeFromReference(expiry);
+    std::vector<Time> T;
+    T.push_back(t + 0.5);
+    T.push_back(t + 2.0);
+    T.push_back(t + 7.5);
+
+    for (Size pass = 0; pass < 2; ++pass) {
+        Array y = model->yGrid(yStdDevs, gridPoints);
+        for (Size c = 0; c < 2; ++c) {
+            const Handle<YieldTermStructure> &curve =
+                c == 0 ? Handle<YieldTermStructure>() : yts2;
+            const boost::shared_ptr<IborIndex> &index =
+                c == 0 ? ibor : ibor2;
+            Matrix zerobonds =
+                model->zerobondGrid(T, t, yStdDevs, gridPoints, curve);
+            Array numeraires =
+                model->numeraireGrid(t, yStdDevs, gridPoints, curve);
+            Array forwards = model->forwardRateGrid(fixing, expiry, yStdDevs,
+                                                    gridPoints, index);
+            for (Size i = 0; i < y.size(); ++i) {
+                for (Size j = 0; j < T.size(); ++j) {
+                    Real expected = model->zerobond(T[j], t, y[i], curve);
+                    if (zerobonds[i][j] != expected)
+                        BOOST_ERROR("zerobond grid value at y="
+                                    << y[i] << ", T=" << T[j] << " ("
+                                    << zerobonds[i][j]
+                                    << ") differs from pointwise value ("
+                                    << expected << ")");
+                }
+                Real expected = model->numeraire(t, y[i], curve);
+                if (numeraires[i] != expected)
+                    BOOST_ERROR("numeraire grid value at y="
+                                << y[i] << " (" << numeraires[i]
+                                << ") differs from pointwise value ("
+                                << expected << ")");
+                expected = model->forwardRate(fixing, expiry, y[i], index);
+                if (forwards[i] != expected)
+                    BOOST_ERROR("forward rate grid value at y="
+                                << y[i] << " (" << forwards[i]
+                                << ") differs from pointwise value ("
+                                << expected << ")");
+            }
+        }
+        Matrix grids = model->yGrids(yStdDevs, gridPoints, t + 1.0, t);
+        for (Size i = 0; i < y.size(); ++i) {
+            Array expected = model->yGrid(yStdDevs, gridPoints, t + 1.0, t,
+                                          y[i]);
+            for (Size j = 0; j < expected.size(); ++j) {
+                if (grids[i][j] != expected[j])
+                    BOOST_ERROR("conditional grid value ("
+                                << grids[i][j]
+                                << ") differs from pointwise value ("
+                                << expected[j] << ")");
+            }
+        }
+        // the second pass is served from the cache
+    }
+
+    // Bermudan prices must follow the model parameters, i.e. the
+    // cached grids must be flushed when they change
+
+    boost::shared_ptr<SwapIndex> swpIdx(
+        new EuriborSwapIsdaFixA(10 * Years, yts));
+    std::vector<Date> exerciseDates;
+    boost::shared_ptr<VanillaSwap> underlying =
+        MakeVanillaSwap(10 * Years, swpIdx->iborIndex(), 0.03)
+            .withEffectiveDate(swpIdx->valueDate(expiry))
+            .withFixedLegCalendar(swpIdx->fixingCalendar())
+            .withFixedLegDayCount(swpIdx->dayCounter())
+            .withFixedLegTenor(swpIdx->fixedLegTenor())
+            .withFixedLegConvention(swpIdx->fixedLegConvention())
+            .withFixedLegTerminationDateConvention(
+                 swpIdx->fixedLegConvention());
+    for (Size i = 0; i < underlying->fixedLeg().size() - 1; ++i) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(underlying->fixedLeg()[i]);
+        exerciseDates.push_back(
+            swpIdx->fixingDate(coupon->accrualStartDate()));
+    }
+    boost::shared_ptr<Exercise> exercise(
+        new BermudanExercise(exerciseDates));
+    boost::shared_ptr<Swaption> swaption(new Swaption(underlying, exercise));
+    boost::shared_ptr<NonstandardSwaption> nonstdswaption(
+        new NonstandardSwaption(*swaption));
+
+    swaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dSwaptionEngine(model, 32, 7.0, true, false)));
+    nonstdswaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dNonstandardSwaptionEngine(model, 32, 7.0, true,
+                                                false)));
+
+    Real tol = 1E-12;
+
+    for (Size k = 0; k < 3; ++k) {
+        if (k == 1) {
+            vol1->setValue(0.015);
+        } else if (k == 2) {
+            Array params = model->params();
+            params[1] = 0.008; // first volatility
+            model->setParams(params);
+        }
+        Real npv = swaption->NPV();
+        Real nonstdNpv = nonstdswaption->NPV();
+
+        std::vector<Real> freshVols(model->volatility().begin(),
+                                    model->volatility().end());
+        boost::shared_ptr<Gsr> fresh(new Gsr(yts, stepDates, freshVols,
+                                             model->reversion()[0], 50.0));
+        boost::shared_ptr<Swaption> swaption2(
+            new Swaption(underlying, exercise));
+        boost::shared_ptr<NonstandardSwaption> nonstdswaption2(
+            new NonstandardSwaption(*swaption2));
+        swaption2->setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dSwaptionEngine(fresh, 32, 7.0, true, false)));
+        nonstdswaption2->setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dNonstandardSwaptionEngine(fresh, 32, 7.0, true,
+                                                    false)));
+        Real expected = swaption2->NPV();
+        Real nonstdExpected = nonstdswaption2->NPV();
+
+        if (fabs(npv - expected) > tol)
+            BOOST_ERROR("Gaussian1dSwaptionEngine NPV ("
+                        << npv << ") differs from NPV on a fresh model ("
+                        << expected << ") in scenario " << k);
+        if (fabs(nonstdNpv - nonstdExpected) > tol)
+            BOOST_ERROR("Gaussian1dNonstandardSwaptionEngine NPV ("
+                        << nonstdNpv
+                        << ") differs from NPV on a fresh model ("
+                        << nonstdExpected << ") in scenario " << k);
+    }
+
+    // engines pricing concurrently on the same model share the grids,
+    // which are flushed by the parameter change below
+
+    Real strikes[] = {0.02, 0.025, 0.03, 0.035, 0.04, 0.045, 0.05, 0.055};
+    const long n = LENGTH(strikes);
+    std::vector<boost::shared_ptr<Swaption> > concurrent, serial;
+    boost::shared_ptr<Gsr> serialModel(
+        new Gsr(yts, stepDates, vols, reversion, 50.0));
+    for (long i = 0; i < n; ++i) {
+        boost::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(10 * Years, swpIdx->iborIndex(), strikes[i])
+                .withEffectiveDate(swpIdx->valueDate(expiry))
+                .withFixedLegCalendar(swpIdx->fixingCalendar())
+                .withFixedLegDayCount(swpIdx->dayCounter())
+                .withFixedLegTenor(swpIdx->fixedLegTenor())
+                .withFixedLegConvention(swpIdx->fixedLegConvention())
+                .withFixedLegTerminationDateConvention(
+                     swpIdx->fixedLegConvention());
+        concurrent.push_back(
+            boost::shared_ptr<Swaption>(new Swaption(swap, exercise)));
+        concurrent.back()->setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dSwaptionEngine(model, 32, 7.0, true, false)));
+        serial.push_back(
+            boost::shared_ptr<Swaption>(new Swaption(swap, exercise)));
+        serial.back()->setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dSwaptionEngine(serialModel, 32, 7.0, true,
+                                         false)));
+    }
+    vol0->setValue(0.011);
+
+    std::vector<Real> npvs(n);
+    #pragma omp parallel for
+    for (long i = 0; i < n; ++i)
+        npvs[i] = concurrent[i]->NPV();
+
+    for (long i = 0; i < n; ++i) {
+        Real expected = serial[i]->NPV();
+        if (fabs(npvs[i] - expected) > tol)
+            BOOST_ERROR("Gaussian1dSwaptionEngine NPV ("
+                        << npvs[i] << ") with strike " << strikes[i]
+                        << " priced concurrently differs from serial NPV ("
+                        << expected << ")");
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(GsrTest::testStateGrids));
     return suite;
 }
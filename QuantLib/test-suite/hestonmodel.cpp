@@ -301,6 +301,215 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+             "Testing parallel Heston model calibration against serial one...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    boost::shared_ptr<HestonModel> models[2];
+    for (Size j=0; j < LENGTH(models); ++j) {
+        models[j] = boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+    }
+
+    // serial calibration with a single shared engine
+    const boost::shared_ptr<PricingEngine> engine =
+        boost::make_shared<AnalyticHestonEngine>(models[0], 64);
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+    models[0]->calibrate(options, om, endCriteria);
+
+    // parallel calibration with one engine per helper
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(
+            boost::make_shared<AnalyticHestonEngine>(models[1], 64));
+
+    models[1]->enableParallelCalibration();
+    models[1]->calibrate(options, om, endCriteria);
+
+    const Array serial = models[0]->params();
+    const Array parallel = models[1]->params();
+    for (Size i=0; i < serial.size(); ++i) {
+        if (std::fabs(serial[i] - parallel[i]) > 1e-12) {
+            BOOST_FAIL("Failed to reproduce serial calibration"
+                       << "\n    parameter:  " << i
+                       << "\n    serial:     " << serial[i]
+                       << "\n    parallel:   " << parallel[i]);
+        }
+    }
+    if (models[1]->functionEvaluation() !=
+        models[0]->functionEvaluation()) {
+        BOOST_FAIL("Failed to reproduce number of function evaluations"
+                   << "\n    serial:     " << models[0]->functionEvaluation()
+                   << "\n    parallel:   " << models[1]->functionEvaluation());
+    }
+    if (models[1]->evaluationTimes().empty()) {
+        BOOST_FAIL("No evaluation times recorded during calibration");
+    }
+}
+
+void HestonModelTest::testAnalyticCalibrationGradient() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration using analytic gradients...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    const boost::shared_ptr<HestonModel> model(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const boost::shared_ptr<PricingEngine> engine =
+        boost::make_shared<AnalyticHestonEngine>(model, 64);
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    // analytic vs. finite-difference price derivatives
+    const Array params = model->params();
+    const Real h = 1e-5;
+    for (Size i = 0; i < options.size(); i+=7) {
+        const Array calculated = options[i]->modelValueGradient();
+        if (calculated.size() != params.size())
+            BOOST_FAIL("analytic gradient not available");
+
+        for (Size j = 0; j < params.size(); ++j) {
+            Array p(params);
+            p[j] += h;
+            model->setParams(p);
+            const Real up = options[i]->modelValue();
+            p[j] -= 2*h;
+            model->setParams(p);
+            const Real down = options[i]->modelValue();
+            model->setParams(params);
+
+            const Real expected = (up - down)/(2*h);
+            const Real tol = 1e-3 + 1e-4*std::fabs(expected);
+            if (std::fabs(calculated[j] - expected) > tol) {
+                BOOST_ERROR("Failed to reproduce price derivative"
+                            << "\n    helper:     " << i
+                            << "\n    parameter:  " << j
+                            << "\n    calculated: " << calculated[j]
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tol);
+            }
+        }
+    }
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < options.size(); ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
+void HestonModelTest::testBatchPricing() {
+    BOOST_TEST_MESSAGE("Testing batch pricing with analytic Heston engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+    const DayCounter dayCounter = Actual365Fixed();
+    const Date exerciseDate = settlementDate + 18*Months;
+
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonModel> model(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7)));
+
+    const boost::shared_ptr<Exercise> exercise(
+        boost::make_shared<EuropeanExercise>(exerciseDate));
+
+    std::vector<Option::Type> types;
+    std::vector<Real> strikes;
+    for (Real strike = 60.0; strike < 145.0; strike += 10.0) {
+        types.push_back(types.size() % 2 ? Option::Put : Option::Call);
+        strikes.push_back(strike);
+    }
+
+    const boost::shared_ptr<AnalyticHestonEngine> engines[] = {
+        boost::make_shared<AnalyticHestonEngine>(model, 144),
+        boost::make_shared<AnalyticHestonEngine>(model, 1e-8, 10000)
+    };
+
+    const Real tol = 1e-12;
+    for (Size k=0; k < 2; ++k) {
+        for (Size n=0; n < LENGTH(engines); ++n) {
+            // shared integrand values must be discarded on model updates
+            if (k == 1)
+                model->setParams(model->params()*1.1);
+
+            const Array batch =
+                engines[n]->prices(exerciseDate, types, strikes);
+
+            for (Size i=0; i < strikes.size(); ++i) {
+                VanillaOption option(
+                    boost::make_shared<PlainVanillaPayoff>(
+                        types[i], strikes[i]), exercise);
+
+                option.setPricingEngine(
+                    (n == 0)
+                    ? boost::make_shared<AnalyticHestonEngine>(model, 144)
+                    : boost::make_shared<AnalyticHestonEngine>(
+                                                     model, 1e-8, 10000));
+                const Real expected = option.NPV();
+
+                option.setPricingEngine(engines[n]);
+                const Real shared = option.NPV();
+
+                if (std::fabs(batch[i] - expected) > tol
+                    || std::fabs(shared - expected) > tol) {
+                    BOOST_FAIL("failed to reproduce single option price"
+                               << "\n    strike:     " << strikes[i]
+                               << "\n    engine:     " << n
+                               << "\n    batch:      " << batch[i]
+                               << "\n    shared:     " << shared
+                               << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -2676,6 +2885,10 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testBlackCalibration));
     suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testParallelCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                      HestonModelTest::testAnalyticCalibrationGradient));
+    suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testBatchPricing));
     suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(HestonModelTest::testDifferentIntegrals));
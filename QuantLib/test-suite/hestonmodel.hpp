@@ -30,6 +30,9 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
+    static void testAnalyticCalibrationGradient();
+    static void testBatchPricing();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
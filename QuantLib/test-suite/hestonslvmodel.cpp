@@ -2468,6 +2468,106 @@ void HestonSLVModelTest::testMoustacheGraph() {
     }
 }
 
+namespace {
+    void checkSliceTimings(const std::vector<Real>& timings,
+                           const std::string& model) {
+        if (timings.empty())
+            BOOST_ERROR("no slice timings for the " << model << " model");
+
+        Real total = 0.0;
+        for (Size i=0; i < timings.size(); ++i) {
+            if (timings[i] < 0.0)
+                BOOST_ERROR("negative slice timing for the " << model
+                            << " model\n slice  : " << i
+                            << "\n timing : " << timings[i]);
+            total += timings[i];
+        }
+        if (total <= 0.0)
+            BOOST_ERROR("total slice timing for the " << model
+                        << " model should be positive");
+    }
+
+    void checkSameLeverage(
+        const boost::shared_ptr<LocalVolTermStructure>& serial,
+        const boost::shared_ptr<LocalVolTermStructure>& parallel,
+        const std::string& model) {
+
+        const Time times[] = { 0.05, 0.1, 0.25, 0.4, 0.5 };
+        for (Size i=0; i < LENGTH(times); ++i) {
+            for (Real s=60.0; s < 160.0; s+=5.0) {
+                const Volatility expected = serial->localVol(times[i], s, true);
+                const Volatility calculated
+                    = parallel->localVol(times[i], s, true);
+                if (calculated != expected)
+                    BOOST_ERROR("serial and parallel calibrations of the "
+                                << model << " model differ"
+                                << "\n time       : " << times[i]
+                                << "\n spot       : " << s
+                                << std::setprecision(16)
+                                << "\n serial     : " << expected
+                                << "\n parallel   : " << calculated);
+            }
+        }
+    }
+}
+
+void HestonSLVModelTest::testSerialVsParallelCalibration() {
+    BOOST_TEST_MESSAGE(
+        "Testing serial vs parallel Heston SLV calibration...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = ActualActual();
+    const Date todaysDate(5, Jan, 2016);
+    const Date maturityDate = todaysDate + Period(6, Months);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Handle<LocalVolTermStructure> localVol(
+        boost::make_shared<LocalConstantVol>(todaysDate, 0.3, dc));
+
+    const Handle<HestonModel> hestonModel(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75)));
+
+    const HestonSLVFokkerPlanckFdmParams params =
+        { 51, 31, 50, 25, 3.0, 0, 2,
+          0.1, 1e-4, 10000,
+          1e-8, 1e-8, 0.0, 1.0, 1.0, 1.0, 1e-6,
+          FdmHestonGreensFct::Gaussian,
+          FdmSquareRootFwdOp::Plain,
+          FdmSchemeDesc::ModifiedCraigSneyd()
+        };
+
+    const boost::shared_ptr<BrownianGeneratorFactory> brownianFactory(
+        new MTBrownianGeneratorFactory(1234ul));
+
+    boost::shared_ptr<LocalVolTermStructure> fdmSerial, mcSerial;
+    {
+        SerialSection serialSection;
+        fdmSerial = HestonSLVFDMModel(
+            localVol, hestonModel, maturityDate, params).leverageFunction();
+        mcSerial = HestonSLVMCModel(
+            localVol, hestonModel, brownianFactory,
+            maturityDate, 50, 51, 4096).leverageFunction();
+    }
+
+    const HestonSLVFDMModel fdmModel(
+        localVol, hestonModel, maturityDate, params);
+    const HestonSLVMCModel mcModel(
+        localVol, hestonModel, brownianFactory, maturityDate, 50, 51, 4096);
+
+    checkSameLeverage(fdmSerial, fdmModel.leverageFunction(), "FDM");
+    checkSameLeverage(mcSerial, mcModel.leverageFunction(), "Monte Carlo");
+
+    checkSliceTimings(fdmModel.sliceTimings(), "FDM");
+    checkSliceTimings(mcModel.sliceTimings(), "Monte Carlo");
+}
+
 
 test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston Stochastic Local Volatility tests");
@@ -2482,6 +2582,7 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(HestonSLVModelTest::testBarrierPricingViaHestonLocalVol));
     suite->add(QUANTLIB_TEST_CASE(HestonSLVModelTest::testMonteCarloVsFdmPricing));
     suite->add(QUANTLIB_TEST_CASE(HestonSLVModelTest::testLocalVolsvSLVPropDensity));
+    suite->add(QUANTLIB_TEST_CASE(HestonSLVModelTest::testSerialVsParallelCalibration));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(HestonSLVModelTest::testHestonFokkerPlanckFwdEquation));
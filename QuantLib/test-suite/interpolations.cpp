@@ -1299,6 +1299,8 @@ void InterpolationTest::testSabrInterpolation(){
     std::vector<boost::shared_ptr<OptimizationMethod> > methods_;
     methods_.push_back( boost::shared_ptr<OptimizationMethod>(new Simplex(0.01)));
     methods_.push_back( boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt(1e-8, 1e-8, 1e-8)));
+    // using the analytic jacobian of the SABR expansion
+    methods_.push_back( boost::shared_ptr<OptimizationMethod>(new LevenbergMarquardt(1e-8, 1e-8, 1e-8, true)));
     // Initialize end criteria
     boost::shared_ptr<EndCriteria> endCriteria(new
                   EndCriteria(100000, 100, 1e-8, 1e-8, 1e-8));
@@ -1388,6 +1390,47 @@ void InterpolationTest::testSabrInterpolation(){
 }
 
 
+void InterpolationTest::testSabrVolatilityGradient() {
+
+    BOOST_TEST_MESSAGE("Testing analytic Sabr volatility gradient...");
+
+    const Time expiry = 1.5;
+    const Real forward = 0.039;
+    const Real strikes[] = { 0.01, 0.03, 0.039, 0.039+1e-10, 0.06, 0.12 };
+    const Real params[][4] = { { 0.3, 0.6, 0.02, 0.01 },
+                               { 0.05, 0.0, 0.8, -0.7 },
+                               { 0.4, 1.0, 0.5, 0.5 } };
+    const Real h = 1e-6;
+
+    for (Size i=0; i<LENGTH(params); ++i) {
+        for (Size k=0; k<LENGTH(strikes); ++k) {
+            const Array calculated = unsafeSabrVolatilityGradient(
+                strikes[k], forward, expiry, params[i][0], params[i][1],
+                params[i][2], params[i][3]);
+            for (Size j=0; j<4; ++j) {
+                Real p[4] = { params[i][0], params[i][1],
+                              params[i][2], params[i][3] };
+                p[j] += h;
+                const Real up = unsafeSabrVolatility(
+                    strikes[k], forward, expiry, p[0], p[1], p[2], p[3]);
+                p[j] -= 2*h;
+                const Real down = unsafeSabrVolatility(
+                    strikes[k], forward, expiry, p[0], p[1], p[2], p[3]);
+                const Real expected = (up-down)/(2*h);
+                if (std::fabs(calculated[j]-expected) > 1e-7) {
+                    BOOST_ERROR("failed to reproduce Sabr volatility "
+                                "derivative" <<
+                                "\n    strike:     " << strikes[k] <<
+                                "\n    parameter:  " << j <<
+                                "\n    expected:   " << expected <<
+                                "\n    calculated: " << calculated[j]);
+                }
+            }
+        }
+    }
+}
+
+
 void InterpolationTest::testKernelInterpolation() {
 
     BOOST_TEST_MESSAGE("Testing kernel 1D interpolation...");
@@ -2305,6 +2348,7 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testBackwardFlat));
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testForwardFlat));
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testSabrInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testSabrVolatilityGradient));
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testKernelInterpolation));
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testKernelInterpolation2D));
     suite->add(QUANTLIB_TEST_CASE(InterpolationTest::testBicubicDerivatives));
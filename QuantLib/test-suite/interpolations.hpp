@@ -45,6 +45,7 @@ class InterpolationTest {
     static void testBackwardFlat();
     static void testForwardFlat();
     static void testSabrInterpolation();
+    static void testSabrVolatilityGradient();
     static void testKernelInterpolation();
     static void testKernelInterpolation2D();
     static void testBicubicDerivatives();
@@ -42,6 +42,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -77,6 +78,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/stopwatch.hpp>
 #include <ql/math/integrals/segmentintegral.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
 #include <ql/termstructures/volatility/abcd.hpp>
@@ -111,6 +113,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/preprocessor/iteration/local.hpp>
 #include <boost/bind.hpp>
+#include <iomanip>
+#include <numeric>
 #include <sstream>
 
 #if defined(BOOST_MSVC)
@@ -711,6 +715,25 @@ namespace {
             }
     }
 
+    std::vector<boost::shared_ptr<MarketModelEvolver> > makeInnerEvolvers(
+        const boost::shared_ptr<MarketModel>& marketModel,
+        const std::vector<Size>& numeraires,
+        const std::valarray<bool>& isExerciseTime,
+        Size skippedPaths) {
+            std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers;
+            for (Size s=0; s<isExerciseTime.size(); ++s) {
+                if (isExerciseTime[s]) {
+                    SobolBrownianGeneratorFactory iFactory(
+                        SobolBrownianGenerator::Diagonal, seed_+s,
+                        SobolRsg::Jaeckel, skippedPaths);
+                    innerEvolvers.push_back(
+                        makeMarketModelEvolver(marketModel, numeraires,
+                                               iFactory, Pc, s));
+                }
+            }
+            return innerEvolvers;
+    }
+
 }
 
 
@@ -898,6 +921,93 @@ void MarketModelTest::testOneStepNormalForwardsAndOptionlets() {
         }
 }
 
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing accounting engine with multiple evolvers...");
+
+    setup();
+
+    std::vector<Rate> forwardStrikes(todaysForwards.size());
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i) {
+        forwardStrikes[i] = todaysForwards[i] + 0.01;
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    }
+
+    OneStepForwards forwards(rateTimes, accruals,
+        paymentTimes, forwardStrikes);
+    OneStepOptionlets optionlets(rateTimes, accruals,
+        paymentTimes, optionletPayoffs);
+
+    MultiProductComposite product;
+    product.add(forwards);
+    product.add(optionlets);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    Size factors = todaysForwards.size();
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    Size paths = 4095;
+
+    // reference values from a single evolver
+    SobolBrownianGeneratorFactory generatorFactory(
+        SobolBrownianGenerator::Diagonal, seed_);
+    AccountingEngine serialEngine(
+        makeMarketModelEvolver(marketModel, numeraires,
+                               generatorFactory, Pc),
+        product, initialNumeraireValue);
+    SequenceStatisticsInc serialStats(product.numberOfProducts());
+    serialEngine.multiplePathValues(serialStats, paths);
+    std::vector<Real> expectedMean = serialStats.mean();
+    std::vector<Real> expectedError = serialStats.errorEstimate();
+
+    Size workers = 4;
+    Size batchSizes[] = { 100, 4096 };
+    for (Size k=0; k<LENGTH(batchSizes); ++k) {
+        // the same Sobol sequence, split among several evolvers; they
+        // are rebuilt for each run so that all runs draw the same paths
+        std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers(workers);
+        Size skippedPaths = 0;
+        for (Size w=0; w<workers; ++w) {
+            SobolBrownianGeneratorFactory factory(
+                SobolBrownianGenerator::Diagonal, seed_,
+                SobolRsg::Jaeckel, skippedPaths);
+            evolvers[w] = makeMarketModelEvolver(marketModel, numeraires,
+                                                 factory, Pc);
+            skippedPaths += paths/workers + (w < paths%workers ? 1 : 0);
+        }
+
+        AccountingEngine parallelEngine(evolvers, product,
+                                        initialNumeraireValue,
+                                        batchSizes[k]);
+        SequenceStatisticsInc parallelStats(product.numberOfProducts());
+        parallelEngine.multiplePathValues(parallelStats, paths);
+        std::vector<Real> calculatedMean = parallelStats.mean();
+        std::vector<Real> calculatedError = parallelStats.errorEstimate();
+
+        Real tolerance = 1.0e-12;
+        for (Size i=0; i<product.numberOfProducts(); ++i) {
+            if (std::fabs(calculatedMean[i]-expectedMean[i]) > tolerance
+                || std::fabs(calculatedError[i]-expectedError[i])
+                                                              > tolerance)
+                BOOST_ERROR("failed to reproduce single-evolver results"
+                            << "\n    batch size:       " << batchSizes[k]
+                            << "\n    product:          " << i
+                            << "\n    expected mean:    " << expectedMean[i]
+                            << "\n    calculated mean:  " << calculatedMean[i]
+                            << "\n    expected error:   " << expectedError[i]
+                            << "\n    calculated error: "
+                            << calculatedError[i]);
+        }
+    }
+}
+
 void MarketModelTest::testInverseFloater() 
 {
 
@@ -1593,6 +1703,107 @@ void MarketModelTest::testCallableSwapNaif() {
         }
 }
 
+void MarketModelTest::testParallelUpperBound() {
+
+    BOOST_TEST_MESSAGE("Testing upper-bound engine with multiple evolvers...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+        fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct dummyProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+        ExerciseAdapter(nullRebate));
+    EvolutionDescription evolution = dummyProduct.evolution();
+    std::vector<Size> numeraires = makeMeasure(dummyProduct, MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationAbcdVolatility);
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    Size outerPaths = 31, innerPaths = 64;
+
+    // reference values from a single outer evolver
+    SobolBrownianGeneratorFactory generatorFactory(
+        SobolBrownianGenerator::Diagonal, seed_+142);
+    UpperBoundEngine serialEngine(
+        makeMarketModelEvolver(marketModel, numeraires, generatorFactory, Pc),
+        makeInnerEvolvers(marketModel, numeraires, isExerciseTime, 0),
+        receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    Statistics serialStats;
+    serialEngine.multiplePathValues(serialStats, outerPaths, innerPaths);
+
+    // the same Sobol sequences, split among several evolvers; each
+    // inner simulation draws innerPaths paths from its evolver
+    Size workers = 3;
+    std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers(workers);
+    std::vector<std::vector<boost::shared_ptr<MarketModelEvolver> > >
+                                                     innerEvolvers(workers);
+    Size skippedPaths = 0;
+    for (Size w=0; w<workers; ++w) {
+        SobolBrownianGeneratorFactory factory(
+            SobolBrownianGenerator::Diagonal, seed_+142,
+            SobolRsg::Jaeckel, skippedPaths);
+        evolvers[w] = makeMarketModelEvolver(marketModel, numeraires,
+                                             factory, Pc);
+        innerEvolvers[w] = makeInnerEvolvers(marketModel, numeraires,
+                                             isExerciseTime,
+                                             skippedPaths*innerPaths);
+        skippedPaths += outerPaths/workers + (w < outerPaths%workers ? 1 : 0);
+    }
+    UpperBoundEngine parallelEngine(evolvers, innerEvolvers,
+        receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    Statistics parallelStats;
+    parallelEngine.multiplePathValues(parallelStats, outerPaths, innerPaths);
+
+    Real tolerance = 1.0e-12;
+    if (std::fabs(parallelStats.mean()-serialStats.mean()) > tolerance
+        || std::fabs(parallelStats.errorEstimate()
+                     -serialStats.errorEstimate()) > tolerance)
+        BOOST_ERROR("failed to reproduce single-evolver upper bound"
+                    << "\n    expected:   " << serialStats.mean()
+                    << " +/- " << serialStats.errorEstimate()
+                    << "\n    calculated: " << parallelStats.mean()
+                    << " +/- " << parallelStats.errorEstimate());
+
+    // with a loose enough tolerance, the inner simulations stop
+    // after the first block of paths
+    Size blockSize = 128;
+    UpperBoundEngine fixedEngine(
+        makeMarketModelEvolver(marketModel, numeraires, generatorFactory, Pc),
+        makeInnerEvolvers(marketModel, numeraires, isExerciseTime, 0),
+        receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    Statistics fixedStats;
+    fixedEngine.multiplePathValues(fixedStats, outerPaths, blockSize);
+
+    UpperBoundEngine stoppingEngine(
+        makeMarketModelEvolver(marketModel, numeraires, generatorFactory, Pc),
+        makeInnerEvolvers(marketModel, numeraires, isExerciseTime, 0),
+        receiverSwap, nullRebate, receiverSwap, nullRebate,
+        naifStrategy, initialNumeraireValue);
+    Statistics stoppingStats;
+    stoppingEngine.multiplePathValues(stoppingStats, outerPaths,
+                                      8*blockSize, 1.0);
+
+    if (std::fabs(stoppingStats.mean()-fixedStats.mean()) > tolerance)
+        BOOST_ERROR("unexpected upper bound with early termination"
+                    << "\n    expected:   " << fixedStats.mean()
+                    << "\n    calculated: " << stoppingStats.mean());
+}
+
 void MarketModelTest::testCallableSwapLS() {
 
     BOOST_TEST_MESSAGE("Pricing callable swap with Longstaff-Schwartz exercise strategy in a LIBOR market model...");
@@ -4733,6 +4944,247 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testPathMajorDriftCalculator() {
+
+    // Test equivalence between the path-major batch computeReduced()
+    // and the single-path one
+
+    BOOST_TEST_MESSAGE("Testing path-major drift calculation...");
+
+    setup();
+
+    Real tolerance = 1.0e-16;
+    // not a multiple of the usual vector widths, so that the
+    // remainder loop is exercised as well
+    Size nPaths = 13;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Real> rateTaus = evolution.rateTaus();
+    std::vector<Size> numeraires = moneyMarketPlusMeasure(evolution,
+        measureOffset_);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfRates = todaysForwards.size();
+    Size numberOfSteps = evolutionTimes.size();
+
+    Matrix forwards(numberOfRates, nPaths);
+    for (Size i=0; i<numberOfRates; ++i)
+        for (Size k=0; k<nPaths; ++k)
+            forwards[i][k] = todaysForwards[i]*(0.5+Real(k)/nPaths);
+
+    Size testedFactors[] = { 1, 3, numberOfRates };
+    for (Size f=0; f<LENGTH(testedFactors); ++f) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[f],
+                            ExponentialCorrelationAbcdVolatility);
+        std::vector<Rate> displacements = marketModel->displacements();
+        for (Size j=0; j<numberOfSteps; ++j) {
+            const Matrix& A = marketModel->pseudoRoot(j);
+            for (Size h=alive[j]; h<numeraires.size(); ++h) {
+                LMMDriftCalculator driftcalculator(A, displacements, rateTaus,
+                    numeraires[h], alive[j]);
+                Matrix drifts(numberOfRates, nPaths, 0.0);
+                driftcalculator.computeReduced(forwards, drifts);
+                std::vector<Rate> fwds(numberOfRates);
+                std::vector<Real> expected(numberOfRates, 0.0);
+                for (Size k=0; k<nPaths; ++k) {
+                    for (Size i=0; i<numberOfRates; ++i)
+                        fwds[i] = forwards[i][k];
+                    driftcalculator.computeReduced(fwds, expected);
+                    for (Size i=alive[j]; i<numberOfRates; ++i) {
+                        Real error = std::fabs(drifts[i][k]-expected[i]);
+                        if (error>tolerance)
+                            BOOST_ERROR(testedFactors[f] << " factors, " <<
+                                io::ordinal(j+1) << " step, " <<
+                                io::ordinal(h+1) << " numeraire, " <<
+                                io::ordinal(i+1) << " drift, " <<
+                                io::ordinal(k+1) << " path" <<
+                                "\n single path =" << expected[i] <<
+                                "\n path-major  =" << drifts[i][k] <<
+                                "\n       error =" << error <<
+                                "\n   tolerance =" << tolerance);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testPcBatchEvolver() {
+
+    // Test equivalence between the batch predictor-corrector evolver
+    // and the single-path one
+
+    BOOST_TEST_MESSAGE("Testing batch predictor-corrector evolver...");
+
+    setup();
+
+    // the single-path evolver computes full-factor drifts without
+    // factor reduction, hence the round-off differences
+    Real tolerance = 1.0e-12;
+    // not a multiple of the usual vector widths
+    Size batchSize = 13, batches = 3;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfRates = todaysForwards.size();
+    Size numberOfSteps = evolutionTimes.size();
+
+    std::vector<std::vector<Size> > measures;
+    measures.push_back(terminalMeasure(evolution));
+    measures.push_back(moneyMarketMeasure(evolution));
+
+    Size testedFactors[] = { 3, numberOfRates };
+    for (Size f=0; f<LENGTH(testedFactors); ++f) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[f],
+                            ExponentialCorrelationAbcdVolatility);
+        for (Size m=0; m<measures.size(); ++m) {
+            SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+            LogNormalFwdRatePc evolver(marketModel, generatorFactory,
+                                       measures[m]);
+            LogNormalFwdRatePcBatch batchEvolver(marketModel,
+                                                 generatorFactory,
+                                                 measures[m], batchSize);
+            std::vector<Matrix> expected(numberOfSteps,
+                                         Matrix(numberOfRates, batchSize));
+            for (Size b=0; b<batches; ++b) {
+                for (Size k=0; k<batchSize; ++k) {
+                    evolver.startNewPath();
+                    for (Size j=0; j<numberOfSteps; ++j) {
+                        evolver.advanceStep();
+                        const std::vector<Rate>& fwds =
+                            evolver.currentState().forwardRates();
+                        for (Size i=0; i<numberOfRates; ++i)
+                            expected[j][i][k] = fwds[i];
+                    }
+                }
+                batchEvolver.startNewBatch();
+                for (Size j=0; j<numberOfSteps; ++j) {
+                    batchEvolver.advanceStep();
+                    const Matrix& fwds = batchEvolver.currentForwards();
+                    for (Size i=alive[j]; i<numberOfRates; ++i) {
+                        for (Size k=0; k<batchSize; ++k) {
+                            Real error = std::fabs(fwds[i][k]-
+                                                   expected[j][i][k]);
+                            if (error>tolerance)
+                                BOOST_FAIL(testedFactors[f] << " factors, "
+                                    << (m == 0 ? "terminal" : "money market")
+                                    << " measure, " <<
+                                    io::ordinal(b*batchSize+k+1) << " path, "
+                                    << io::ordinal(j+1) << " step, " <<
+                                    io::ordinal(i+1) << " forward" <<
+                                    "\n single path =" << expected[j][i][k] <<
+                                    "\n batch       =" << fwds[i][k] <<
+                                    "\n       error =" << error <<
+                                    "\n   tolerance =" << tolerance);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+    // sum of the forwards at the end of each path
+    Real evolveSinglePaths(const boost::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size paths) {
+        SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+        LogNormalFwdRatePc evolver(marketModel, generatorFactory, numeraires);
+        Size steps = marketModel->evolution().numberOfSteps();
+        Real sum = 0.0;
+        for (Size k=0; k<paths; ++k) {
+            evolver.startNewPath();
+            for (Size j=0; j<steps; ++j)
+                evolver.advanceStep();
+            const std::vector<Rate>& fwds =
+                evolver.currentState().forwardRates();
+            sum += std::accumulate(fwds.begin(), fwds.end(), 0.0);
+        }
+        return sum;
+    }
+
+    Real evolveBatches(const boost::shared_ptr<MarketModel>& marketModel,
+                       const std::vector<Size>& numeraires,
+                       Size paths, Size batchSize) {
+        SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+        LogNormalFwdRatePcBatch evolver(marketModel, generatorFactory,
+                                        numeraires, batchSize);
+        Size steps = marketModel->evolution().numberOfSteps();
+        Real sum = 0.0;
+        for (Size b=0; b<paths/batchSize; ++b) {
+            evolver.startNewBatch();
+            for (Size j=0; j<steps; ++j)
+                evolver.advanceStep();
+            const Matrix& fwds = evolver.currentForwards();
+            sum += std::accumulate(fwds.begin(), fwds.end(), 0.0);
+        }
+        return sum;
+    }
+
+}
+
+void MarketModelTest::testPcBatchEvolverPerformance() {
+
+    BOOST_TEST_MESSAGE("Benchmarking batch predictor-corrector evolver...");
+
+    setup();
+
+    // same evolution, factors and paths as the benchmark cases in
+    // marketmodel_smm and marketmodel_cms
+    Size paths = paths_+1;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, todaysForwards.size(),
+                        ExponentialCorrelationAbcdVolatility);
+
+    std::vector<std::vector<Size> > measures;
+    measures.push_back(terminalMeasure(evolution));
+    measures.push_back(moneyMarketMeasure(evolution));
+    std::string names[] = { "terminal measure", "money market measure" };
+
+    Size batchSizes[] = { 8, 64, 512 };
+    for (Size m=0; m<measures.size(); ++m) {
+        StopWatch watch;
+        Real expected = evolveSinglePaths(marketModel, measures[m], paths);
+        Real singleTime = watch.elapsed();
+        BOOST_TEST_MESSAGE("    " << names[m] << ", " << paths << " paths:");
+        BOOST_TEST_MESSAGE("    " << std::setw(24) << std::left
+                           << "single path" << std::fixed
+                           << std::setprecision(1) << 1.0e3*singleTime
+                           << " ms");
+        for (Size b=0; b<LENGTH(batchSizes); ++b) {
+            watch.restart();
+            Real calculated = evolveBatches(marketModel, measures[m], paths,
+                                            batchSizes[b]);
+            Real batchTime = watch.elapsed();
+            std::ostringstream name;
+            name << "batches of " << batchSizes[b];
+            BOOST_TEST_MESSAGE("    " << std::setw(24) << std::left
+                               << name.str() << std::fixed
+                               << std::setprecision(1) << 1.0e3*batchTime
+                               << " ms, speedup "
+                               << std::setprecision(2)
+                               << singleTime/batchTime);
+            if (std::fabs(calculated-expected) > 1.0e-12*paths)
+                BOOST_ERROR("batches of " << batchSizes[b]
+                            << " evolved different paths:"
+                            << std::setprecision(12)
+                            << "\n    single path: " << expected
+                            << "\n    batch:       " << calculated);
+        }
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4874,6 +5326,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testOneStepForwardsAndOptionlets));
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testOneStepNormalForwardsAndOptionlets));
+    suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testParallelAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testParallelUpperBound));
 
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testGreeks));
 
@@ -4884,6 +5338,9 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(
+                         MarketModelTest::testPathMajorDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testPcBatchEvolver));
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testAbcdDegenerateCases));
@@ -4914,6 +5371,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
         suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testAllMultiStepProducts));
         suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testCallableSwapNaif));
         suite->add(QUANTLIB_TEST_CASE(MarketModelTest::testCallableSwapLS));
+        suite->add(QUANTLIB_TEST_CASE(
+                         MarketModelTest::testPcBatchEvolverPerformance));
     }
 
     return suite;
@@ -39,7 +39,9 @@ class MarketModelTest {
     static void testAllMultiStepProducts();
     static void testOneStepForwardsAndOptionlets();
     static void testOneStepNormalForwardsAndOptionlets();
+    static void testParallelAccountingEngine();
     static void testCallableSwapNaif();
+    static void testParallelUpperBound();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson(
         MarketModelType marketModel, unsigned testedFactor);
@@ -52,6 +54,9 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testPathMajorDriftCalculator();
+    static void testPcBatchEvolver();
+    static void testPcBatchEvolverPerformance();
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
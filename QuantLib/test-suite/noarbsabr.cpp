@@ -22,8 +22,12 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include <cstdio>
+#include <fstream>
+
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/experimental/volatility/noarbsabrsmilesection.hpp>
+#include <ql/experimental/volatility/svismilesection.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -122,11 +126,253 @@ void NoArbSabrTest::testConsistencyWithHagan() {
 
 }
 
+void NoArbSabrTest::testBatchEvaluation() {
+
+    BOOST_TEST_MESSAGE("Testing batch evaluation of sabr, noarb-sabr and svi "
+                       "smile sections");
+
+    Real tau = 1.0;
+    Real beta = 0.5;
+    Real alpha = 0.026;
+    Real rho = -0.1;
+    Real nu = 0.4;
+    Real f = 0.0488;
+
+    SabrSmileSection sabr(tau,f,boost::assign::list_of(alpha)(beta)(nu)(rho),
+                          0.01);
+    NoArbSabrSmileSection noarbsabr(tau,f,boost::assign::list_of(alpha)(beta)(nu)(rho));
+
+    // unsorted, with duplicates and with a strike at the forward
+    std::vector<Rate> strikes;
+    for (Size i=0; i<150; ++i)
+        strikes.push_back(0.0001 + 0.0007*((37*i) % 150));
+    strikes.push_back(f);
+    strikes.push_back(strikes[10]);
+    strikes.push_back(-0.005);
+
+    std::vector<Volatility> vols;
+    std::vector<Real> calls, puts;
+
+    sabr.volatilities(strikes, vols);
+    sabr.optionPrices(strikes, calls);
+    sabr.optionPrices(strikes, puts, Option::Put, 0.95);
+    for (Size i=0; i<strikes.size(); ++i) {
+        // the closed form is evaluated with the same operations
+        if (vols[i] != sabr.volatility(strikes[i]) ||
+            calls[i] != sabr.optionPrice(strikes[i]) ||
+            puts[i] != sabr.optionPrice(strikes[i], Option::Put, 0.95))
+            BOOST_ERROR("batch sabr evaluation differs from single strike "
+                        "one at strike " << strikes[i]
+                        << "\n    volatility: " << vols[i] << " vs "
+                        << sabr.volatility(strikes[i])
+                        << "\n    call:       " << calls[i] << " vs "
+                        << sabr.optionPrice(strikes[i])
+                        << "\n    put:        " << puts[i] << " vs "
+                        << sabr.optionPrice(strikes[i], Option::Put, 0.95));
+    }
+
+    strikes.pop_back();
+    noarbsabr.volatilities(strikes, vols);
+    noarbsabr.optionPrices(strikes, calls);
+    noarbsabr.optionPrices(strikes, puts, Option::Put, 0.95);
+    // the integrals are accumulated piecewise, so that prices agree
+    // up to the accuracy of the numerical integration only (far out
+    // of the money the piecewise integrals are actually the more
+    // accurate ones); the implied volatilities of such options amplify
+    // this difference and are compared for premia above 1E-5 only
+    Real priceTol = 1E-7, volTol = 1E-5, minPremium = 1E-5;
+    for (Size i=0; i<strikes.size(); ++i) {
+        Real call = noarbsabr.optionPrice(strikes[i]);
+        Real put = noarbsabr.optionPrice(strikes[i], Option::Put, 0.95);
+        Real vol = noarbsabr.volatility(strikes[i]);
+        bool checkVol = std::min(call, put) > minPremium;
+        if (std::fabs(calls[i] - call) > priceTol ||
+            std::fabs(puts[i] - put) > priceTol ||
+            (checkVol && std::fabs(vols[i] - vol) > volTol))
+            BOOST_ERROR("batch noarb-sabr evaluation differs from single "
+                        "strike one at strike " << strikes[i]
+                        << "\n    volatility: " << vols[i] << " vs " << vol
+                        << "\n    call:       " << calls[i] << " vs " << call
+                        << "\n    put:        " << puts[i] << " vs " << put);
+    }
+
+    // a, b, sigma, rho, m
+    SviSmileSection svi(tau, f, boost::assign::list_of(0.02)(0.1)(0.2)(-0.3)
+                                                      (0.01));
+    svi.volatilities(strikes, vols);
+    svi.optionPrices(strikes, calls);
+    svi.optionPrices(strikes, puts, Option::Put, 0.95);
+    for (Size i=0; i<strikes.size(); ++i) {
+        if (vols[i] != svi.volatility(strikes[i]) ||
+            calls[i] != svi.optionPrice(strikes[i]) ||
+            puts[i] != svi.optionPrice(strikes[i], Option::Put, 0.95))
+            BOOST_ERROR("batch svi evaluation differs from single strike "
+                        "one at strike " << strikes[i]
+                        << "\n    volatility: " << vols[i] << " vs "
+                        << svi.volatility(strikes[i])
+                        << "\n    call:       " << calls[i] << " vs "
+                        << svi.optionPrice(strikes[i])
+                        << "\n    put:        " << puts[i] << " vs "
+                        << svi.optionPrice(strikes[i], Option::Put, 0.95));
+    }
+}
+
+void NoArbSabrTest::testAbsorptionTableFile() {
+    // the table is checked against the one compiled into the library
+    #ifndef QL_NOARBSABR_EXTERNAL_TABLE
+
+    BOOST_TEST_MESSAGE("Testing no-arbitrage Sabr absorption table file...");
+
+    NoArbSabrAbsorptionTable& table = NoArbSabrAbsorptionTable::instance();
+    const std::string fileName = "noarbsabr_absorption_table.bin";
+
+    // sigmaI, beta, rho, nu, tau on and between the grid points
+    Real params[][5] = { { 1.0, 0.01, 0.75, 0.1, 0.25 },
+                         { 0.35, 0.10, -0.75, 0.1, 14.75 },
+                         { 0.24, 0.90, 0.50, 0.8, 25.75 },
+                         { 0.33, 0.43, 0.12, 0.33, 3.1 },
+                         { 0.07, 0.95, -0.6, 0.05, 0.1 } };
+    Size n = LENGTH(params);
+    Real forward = 0.03;
+    std::vector<Real> builtIn(n);
+    for (Size i=0; i<n; ++i) {
+        Real alpha = params[i][0] / std::pow(forward, params[i][1] - 1.0);
+        builtIn[i] = detail::D0Interpolator(forward, params[i][4], alpha,
+                                            params[i][1], params[i][3],
+                                            params[i][2])();
+    }
+
+    table.save(fileName);
+    table.load(fileName);
+    std::remove(fileName.c_str());
+
+    if (table.builtIn())
+        BOOST_ERROR("loaded table reported as built-in one");
+    const NoArbSabrAbsorptionTable::View loaded = table.view();
+    for (Size i=0; i<n; ++i) {
+        Real alpha = params[i][0] / std::pow(forward, params[i][1] - 1.0);
+        Real d0 = detail::D0Interpolator(forward, params[i][4], alpha,
+                                         params[i][1], params[i][3],
+                                         params[i][2])();
+        if (d0 != builtIn[i])
+            BOOST_ERROR("absorption probability from loaded table ("
+                        << d0 << ") differs from built-in one ("
+                        << builtIn[i] << ") at sigmaI=" << params[i][0]
+                        << ", beta=" << params[i][1] << ", rho="
+                        << params[i][2] << ", nu=" << params[i][3]
+                        << ", tau=" << params[i][4]);
+    }
+
+    table.useBuiltIn();
+    if (!table.builtIn())
+        BOOST_ERROR("built-in table not restored");
+
+    // the view keeps the loaded table alive
+    for (Size i=0; i<NoArbSabrAbsorptionTable::size; ++i) {
+        if (loaded[i] != detail::sabrabsprob[i]) {
+            BOOST_ERROR("loaded absorption count (" << loaded[i]
+                        << ") at index " << i
+                        << " differs from the built-in one ("
+                        << detail::sabrabsprob[i] << ")");
+            break;
+        }
+    }
+
+    {
+        std::ofstream out(fileName.c_str(), std::ios::binary);
+        out << "not a table";
+    }
+    bool failed = false;
+    try {
+        table.load(fileName);
+    } catch (Error&) {
+        failed = true;
+    }
+    std::remove(fileName.c_str());
+    if (!failed)
+        BOOST_ERROR("invalid absorption table file loaded");
+    if (!table.builtIn())
+        BOOST_ERROR("built-in table not kept after failed load");
+    #endif
+}
+
+void NoArbSabrTest::testModelCache() {
+
+    BOOST_TEST_MESSAGE("Testing no-arbitrage Sabr model cache...");
+
+    detail::NoArbSabrModelCache& cache =
+        detail::NoArbSabrModelCache::instance();
+    cache.clear();
+
+    Real tau = 1.0, beta = 0.5, alpha = 0.026, rho = -0.1, nu = 0.4,
+         f = 0.0488;
+
+    cache.setMaxSize(0);
+    NoArbSabrModel reference(tau, f, alpha, beta, nu, rho);
+    if (cache.size() != 0)
+        BOOST_ERROR("disabled cache holds " << cache.size() << " entries");
+
+    cache.setMaxSize(10000);
+    NoArbSabrModel first(tau, f, alpha, beta, nu, rho);
+    NoArbSabrModel second(tau, f, alpha, beta, nu, rho);
+    NoArbSabrModel other(tau, f, alpha, beta, nu, rho + 0.1);
+    if (cache.size() != 2)
+        BOOST_ERROR("cache holds " << cache.size()
+                    << " entries, 2 expected");
+
+    const NoArbSabrModel* models[] = { &first, &second };
+    for (Size j=0; j<LENGTH(models); ++j) {
+        if (models[j]->absorptionProbability() !=
+                reference.absorptionProbability() ||
+            models[j]->numericalForward() != reference.numericalForward())
+            BOOST_ERROR("model " << j << " differs from the uncached one:"
+                        << "\n    absorption probability: "
+                        << models[j]->absorptionProbability() << " vs "
+                        << reference.absorptionProbability()
+                        << "\n    numerical forward:      "
+                        << models[j]->numericalForward() << " vs "
+                        << reference.numericalForward());
+        for (Real k=0.005; k<0.15; k+=0.005) {
+            if (models[j]->optionPrice(k) != reference.optionPrice(k) ||
+                models[j]->density(k) != reference.density(k))
+                BOOST_ERROR("model " << j << " differs from the uncached "
+                            "one at strike " << k
+                            << "\n    price:   " << models[j]->optionPrice(k)
+                            << " vs " << reference.optionPrice(k)
+                            << "\n    density: " << models[j]->density(k)
+                            << " vs " << reference.density(k));
+        }
+    }
+
+    cache.setMaxSize(1);
+    if (cache.size() != 0)
+        BOOST_ERROR("cache not cleared when shrunk below its size");
+    cache.setMaxSize(10000);
+
+    // states calibrated before the cache was cleared, e.g. with
+    // another absorption table, are not added
+    Size generation = cache.generation();
+    detail::NoArbSabrModelCache::Key key(6, 0.0);
+    detail::NoArbSabrModelCache::State state = {};
+    cache.clear();
+    cache.add(key, state, generation);
+    if (cache.size() != 0)
+        BOOST_ERROR("outdated state added to the cache");
+    cache.add(key, state, cache.generation());
+    if (cache.size() != 1)
+        BOOST_ERROR("cache holds " << cache.size()
+                    << " entries, 1 expected");
+    cache.clear();
+}
+
 
 test_suite* NoArbSabrTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("NoArbSabrModel tests");
 
     suite->add(QUANTLIB_TEST_CASE(NoArbSabrTest::testAbsorptionMatrix));
     suite->add(QUANTLIB_TEST_CASE(NoArbSabrTest::testConsistencyWithHagan));
+    suite->add(QUANTLIB_TEST_CASE(NoArbSabrTest::testBatchEvaluation));
+    suite->add(QUANTLIB_TEST_CASE(NoArbSabrTest::testAbsorptionTableFile));
+    suite->add(QUANTLIB_TEST_CASE(NoArbSabrTest::testModelCache));
     return suite;
 }
@@ -29,6 +29,9 @@ class NoArbSabrTest {
   public:
     static void testAbsorptionMatrix();
     static void testConsistencyWithHagan();
+    static void testBatchEvaluation();
+    static void testAbsorptionTableFile();
+    static void testModelCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -822,6 +822,103 @@ void OptionletStripperTest::testSwitchStrike() {
                    << "\ntolerance:     " << io::rate(vars.tolerance));
 }
 
+void OptionletStripperTest::testIncrementalStripping() {
+    BOOST_TEST_MESSAGE("Testing incremental optionlet stripping after "
+                       "quote and evaluation date changes...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+    vars.setCapFloorTermVolSurface();
+
+    std::vector<std::vector<boost::shared_ptr<SimpleQuote> > > quotes(
+                                                     vars.optionTenors.size());
+    std::vector<std::vector<Handle<Quote> > > quoteHandles(
+                                                     vars.optionTenors.size());
+    for (Size i=0; i<vars.optionTenors.size(); ++i) {
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            quotes[i].push_back(boost::shared_ptr<SimpleQuote>(
+                                          new SimpleQuote(vars.termV[i][j])));
+            quoteHandles[i].push_back(Handle<Quote>(quotes[i][j]));
+        }
+    }
+    boost::shared_ptr<CapFloorTermVolSurface> surface(new
+        CapFloorTermVolSurface(0, vars.calendar, Following,
+                               vars.optionTenors, vars.strikes,
+                               quoteHandles, vars.dayCounter));
+
+    shared_ptr<IborIndex> iborIndex(new Euribor6M(vars.yieldTermStructure));
+
+    // tight accuracy, so that strippers starting from different guesses
+    // can be compared
+    Real accuracy = 1.0e-12;
+    Real volTolerance = 1.0e-9;
+    boost::shared_ptr<OptionletStripper1> stripper(new
+        OptionletStripper1(surface, iborIndex, Null<Rate>(), accuracy));
+
+    // cap prices must be those of the cap/floor engine
+    const std::vector<Period>& tenors = stripper->optionletFixingTenors();
+    for (Size i=0; i<tenors.size(); ++i) {
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            CapFloor::Type type = vars.strikes[j] < stripper->switchStrike() ?
+                CapFloor::Floor : CapFloor::Cap;
+            boost::shared_ptr<PricingEngine> engine(new
+                BlackCapFloorEngine(vars.yieldTermStructure,
+                                    stripper->capFloorVolatilities()[i][j],
+                                    vars.dayCounter));
+            boost::shared_ptr<CapFloor> capFloor =
+                MakeCapFloor(type, tenors[i] + iborIndex->tenor(),
+                             iborIndex, vars.strikes[j], 0*Days)
+                .withPricingEngine(engine);
+            Real expected = capFloor->NPV();
+            Real calculated = stripper->capFloorPrices()[i][j];
+            if (std::fabs(calculated - expected) > 1.0e-14)
+                BOOST_FAIL("failed to reproduce cap/floor price:"
+                           << "\n    length:     " << tenors[i] + iborIndex->tenor()
+                           << "\n    strike:     " << io::rate(vars.strikes[j])
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    for (Size step=0; step<3; ++step) {
+        switch (step) {
+          case 0:
+            // a single quote, in the middle of the surface
+            quotes[5][6]->setValue(quotes[5][6]->value() + 0.01);
+            break;
+          case 1:
+            // the last maturity only
+            quotes.back()[2]->setValue(quotes.back()[2]->value() - 0.005);
+            break;
+          case 2:
+            Settings::instance().evaluationDate() = Date(4, November, 2013);
+            break;
+        }
+
+        boost::shared_ptr<OptionletStripper1> fresh(new
+            OptionletStripper1(surface, iborIndex, Null<Rate>(), accuracy));
+
+        for (Size i=0; i<tenors.size(); ++i) {
+            for (Size j=0; j<vars.strikes.size(); ++j) {
+                Real price = stripper->capFloorPrices()[i][j];
+                Real expectedPrice = fresh->capFloorPrices()[i][j];
+                Volatility vol = stripper->optionletVolatilities(i)[j];
+                Volatility expectedVol = fresh->optionletVolatilities(i)[j];
+                if (std::fabs(price - expectedPrice) > 1.0e-14 ||
+                    std::fabs(vol - expectedVol) > volTolerance)
+                    BOOST_FAIL("incremental stripping failed at step "
+                               << step << ":"
+                               << "\n    tenor:          " << tenors[i]
+                               << "\n    strike:         " << io::rate(vars.strikes[j])
+                               << "\n    price:          " << price
+                               << "\n    expected price: " << expectedPrice
+                               << "\n    vol:            " << io::volatility(vol)
+                               << "\n    expected vol:   " << io::volatility(expectedVol));
+            }
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
 
@@ -830,6 +927,7 @@ test_suite* OptionletStripperTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(OptionletStripperTest::testFlatTermVolatilityStripping2));
     suite->add(QUANTLIB_TEST_CASE(OptionletStripperTest::testTermVolatilityStripping2));
     suite->add(QUANTLIB_TEST_CASE(OptionletStripperTest::testSwitchStrike));
+    suite->add(QUANTLIB_TEST_CASE(OptionletStripperTest::testIncrementalStripping));
 
     #if defined(QL_NEGATIVE_RATES)
     suite->add(QUANTLIB_TEST_CASE(OptionletStripperTest::testTermVolatilityStrippingNormalVol));
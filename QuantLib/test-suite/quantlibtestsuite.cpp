@@ -22,6 +22,9 @@
 #include <ql/settings.hpp>
 #include <ql/utilities/dataparsers.hpp>
 #include <ql/version.hpp>
+#ifdef QL_NOARBSABR_EXTERNAL_TABLE
+#include <ql/experimental/volatility/noarbsabr.hpp>
+#endif
 
 #ifdef QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
 #include "paralleltestrunner.hpp"
@@ -100,6 +103,7 @@
 #include "europeanoption.hpp"
 #include "everestoption.hpp"
 #include "exchangerate.hpp"
+#include "exposuresimulation.hpp"
 #include "extendedtrees.hpp"
 #include "extensibleoptions.hpp"
 #include "fastfouriertransform.hpp"
@@ -171,6 +175,7 @@
 #include "rounding.hpp"
 #include "sampledcurve.hpp"
 #include "schedule.hpp"
+#include "sensitivityanalysis.hpp"
 #include "shortratemodels.hpp"
 #include "solvers.hpp"
 #include "spreadoption.hpp"
@@ -292,6 +297,24 @@ SpeedLevel speed_level(int argc, char** argv) {
     return Slow;
 }
 
+#ifdef QL_NOARBSABR_EXTERNAL_TABLE
+void load_noarbsabr_table(int argc, char** argv) {
+    /*! The absorption table of the no-arbitrage SABR model is not
+        compiled into the library and is read from the file given
+        with --noarbsabr-table=FILE, by default the one generated by
+        tools/noarbsabr_table.py in the working directory.
+    */
+
+    std::string fileName = "noarbsabr_absorption_table.bin";
+    for (int i=1; i<argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.substr(0, 18) == "--noarbsabr-table=")
+            fileName = arg.substr(18);
+    }
+    QuantLib::NoArbSabrAbsorptionTable::instance().load(fileName);
+}
+#endif
+
 
 test_suite* init_unit_test_suite(int, char* []) {
 
@@ -299,6 +322,9 @@ test_suite* init_unit_test_suite(int, char* []) {
     char **argv = boost::unit_test::framework::master_test_suite().argv;
     configure(evaluation_date(argc, argv));
     SpeedLevel speed = speed_level(argc, argv);
+    #ifdef QL_NOARBSABR_EXTERNAL_TABLE
+    load_noarbsabr_table(argc, argv);
+    #endif
 
     const QuantLib::Settings& settings = QuantLib::Settings::instance();
     std::ostringstream header;
@@ -476,6 +502,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(DoubleBinaryOptionTest::suite());
     test->add(EuropeanOptionTest::experimental());
     test->add(EverestOptionTest::suite());
+    test->add(ExposureSimulationTest::suite());
     test->add(ExtendedTreesTest::suite());
     test->add(ExtensibleOptionsTest::suite());
     test->add(GaussianQuadraturesTest::experimental());
@@ -493,6 +520,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(PartialTimeBarrierOptionTest::suite());
     test->add(QuantoOptionTest::experimental());
     test->add(RiskNeutralDensityCalculatorTest::experimental(speed));
+    test->add(SensitivityAnalysisTest::suite());
     test->add(SpreadOptionTest::suite());
     test->add(SquareRootCLVModelTest::experimental());
     test->add(SwingOptionTest::suite(speed));
@@ -0,0 +1,154 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "sensitivityanalysis.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    // swaps on a swap curve and a bond on an unrelated deposit curve
+    SensitivityMarket buildMarket() {
+        SensitivityMarket market;
+        Calendar calendar = TARGET();
+
+        std::vector<boost::shared_ptr<RateHelper> > swapHelpers;
+        Size swapTenors[] = { 2, 3, 5, 7, 10 };
+        for (Size i=0; i<LENGTH(swapTenors); ++i) {
+            boost::shared_ptr<SimpleQuote> rate(
+                new SimpleQuote(0.02 + 0.002*i));
+            market.quotes.push_back(Handle<SimpleQuote>(rate));
+            swapHelpers.push_back(boost::shared_ptr<RateHelper>(
+                new SwapRateHelper(Handle<Quote>(rate),
+                                   swapTenors[i]*Years, calendar, Annual,
+                                   Unadjusted, Thirty360(),
+                                   boost::shared_ptr<IborIndex>(
+                                       new Euribor6M))));
+        }
+        Handle<YieldTermStructure> swapCurve(
+            boost::shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount, LogLinear>(
+                    0, calendar, swapHelpers, Actual360())));
+
+        std::vector<boost::shared_ptr<RateHelper> > depositHelpers;
+        Size depositTenors[] = { 3, 6, 12 };
+        for (Size i=0; i<LENGTH(depositTenors); ++i) {
+            boost::shared_ptr<SimpleQuote> rate(
+                new SimpleQuote(0.01 + 0.001*i));
+            market.quotes.push_back(Handle<SimpleQuote>(rate));
+            depositHelpers.push_back(boost::shared_ptr<RateHelper>(
+                new DepositRateHelper(Handle<Quote>(rate),
+                                      depositTenors[i]*Months, 2, calendar,
+                                      ModifiedFollowing, false,
+                                      Actual360())));
+        }
+        Handle<YieldTermStructure> depositCurve(
+            boost::shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount, LogLinear>(
+                    0, calendar, depositHelpers, Actual360())));
+
+        boost::shared_ptr<IborIndex> index(new Euribor6M(swapCurve));
+        boost::shared_ptr<PricingEngine> swapEngine(
+            new DiscountingSwapEngine(swapCurve));
+        Size tenors[] = { 2, 4, 6, 9 };
+        for (Size i=0; i<LENGTH(tenors); ++i) {
+            boost::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(tenors[i]*Years, index, 0.025)
+                .withNominal(100.0)
+                .withPricingEngine(swapEngine);
+            market.instruments.push_back(swap);
+        }
+
+        Date today = Settings::instance().evaluationDate();
+        boost::shared_ptr<Bond> bond(new FixedRateBond(
+            2, calendar, 100.0, today, today + 9*Months, 3*Months,
+            std::vector<Rate>(1, 0.02), Actual360()));
+        bond->setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new DiscountingBondEngine(depositCurve)));
+        market.instruments.push_back(bond);
+
+        return market;
+    }
+
+}
+
+void SensitivityAnalysisTest::testBucketMatrix() {
+
+    BOOST_TEST_MESSAGE("Testing bucket sensitivity matrix "
+                       "on several market copies...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, January, 2015);
+
+    std::vector<std::vector<Real> > delta, gamma;
+    bucketAnalysis(delta, gamma, buildMarket, 0.0001, Centered, 3);
+
+    // reference: one instrument at a time on a single copy
+    SensitivityMarket market = buildMarket();
+    const Size n = market.quotes.size(), m = market.instruments.size();
+    const Size swapQuotes = 5, swaps = 4;
+
+    if (delta.size() != n || gamma.size() != n)
+        BOOST_FAIL("wrong number of rows: " << delta.size() << " and "
+                   << gamma.size() << " instead of " << n);
+
+    Real tolerance = 1.0e-6;
+    for (Size k=0; k<m; ++k) {
+        std::pair<std::vector<Real>, std::vector<Real> > expected =
+            bucketAnalysis(market.quotes,
+                           std::vector<boost::shared_ptr<Instrument> >(
+                               1, market.instruments[k]),
+                           std::vector<Real>(), 0.0001, Centered);
+        for (Size i=0; i<n; ++i) {
+            bool dependent = (i < swapQuotes) == (k < swaps);
+            if (!dependent && (delta[i][k] != 0.0 || gamma[i][k] != 0.0))
+                BOOST_ERROR("nonzero sensitivity of instrument #" << k
+                            << " to unrelated quote #" << i << ": "
+                            << delta[i][k] << ", " << gamma[i][k]);
+            if (std::fabs(delta[i][k] - expected.first[i]) > tolerance ||
+                std::fabs(gamma[i][k] - expected.second[i])
+                                                > 1.0e4*tolerance)
+                BOOST_ERROR("failed to reproduce serial sensitivities:"
+                            << "\n    instrument: " << k
+                            << "\n    quote:      " << i
+                            << "\n    delta:      " << delta[i][k]
+                            << "\n    expected:   " << expected.first[i]
+                            << "\n    gamma:      " << gamma[i][k]
+                            << "\n    expected:   " << expected.second[i]);
+        }
+    }
+}
+
+test_suite* SensitivityAnalysisTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Sensitivity analysis tests");
+    suite->add(QUANTLIB_TEST_CASE(SensitivityAnalysisTest::testBucketMatrix));
+    return suite;
+}
@@ -129,6 +129,94 @@ void ShortRateModelTest::testCachedHullWhite() {
     }
 }
 
+void ShortRateModelTest::testHullWhiteAnalyticGradient() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration using analytic gradients...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    boost::shared_ptr<PricingEngine> engine(
+                                         new JamshidianSwaptionEngine(model));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > swaptions;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+        helper->setPricingEngine(engine);
+        swaptions.push_back(helper);
+    }
+
+    // analytic vs. finite-difference price derivatives
+    const Array params = model->params();
+    const Real h = 1e-7;
+    for (Size i=0; i<swaptions.size(); i++) {
+        const Array calculated = swaptions[i]->modelValueGradient();
+        if (calculated.size() != params.size())
+            BOOST_FAIL("analytic gradient not available");
+
+        for (Size j=0; j<params.size(); j++) {
+            Array p(params);
+            p[j] += h;
+            model->setParams(p);
+            const Real up = swaptions[i]->modelValue();
+            p[j] -= 2*h;
+            model->setParams(p);
+            const Real down = swaptions[i]->modelValue();
+            model->setParams(params);
+
+            const Real expected = (up - down)/(2*h);
+            const Real tolerance = 1e-6 + 1e-5*std::fabs(expected);
+            if (std::fabs(calculated[j] - expected) > tolerance) {
+                BOOST_ERROR("Failed to reproduce price derivative:\n"
+                            << "swaption:   " << i << "\n"
+                            << "parameter:  " << j << "\n"
+                            << "calculated: " << calculated[j] << "\n"
+                            << "expected:   " << expected);
+            }
+        }
+    }
+
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8,true);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+    #if defined(QL_USE_INDEXED_COUPON)
+    Real cachedA = 0.0463679, cachedSigma = 0.00579831;
+    #else
+    Real cachedA = 0.0464041, cachedSigma = 0.00579912;
+    #endif
+    Real tolerance = 1.0e-5;
+    Array xMinCalculated = model->params();
+    if (std::fabs(xMinCalculated[0]-cachedA) > tolerance
+        || std::fabs(xMinCalculated[1]-cachedSigma) > tolerance) {
+        BOOST_ERROR("Failed to reproduce cached calibration results:\n"
+                    << "calculated: a = " << xMinCalculated[0] << ", "
+                    << "sigma = " << xMinCalculated[1] << "\n"
+                    << "expected:   a = " << cachedA << ", "
+                    << "sigma = " << cachedSigma);
+    }
+}
+
 void ShortRateModelTest::testCachedHullWhiteFixedReversion() {
     BOOST_TEST_MESSAGE("Testing Hull-White calibration with fixed reversion against cached values...");
 
@@ -463,6 +551,7 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
 
     suite->add(QUANTLIB_TEST_CASE(ShortRateModelTest::testCachedHullWhite));
+    suite->add(QUANTLIB_TEST_CASE(ShortRateModelTest::testHullWhiteAnalyticGradient));
     suite->add(QUANTLIB_TEST_CASE(ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(ShortRateModelTest::testFuturesConvexityBias));
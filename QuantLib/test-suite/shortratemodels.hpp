@@ -30,6 +30,7 @@ class ShortRateModelTest {
   public:
     static void testFuturesConvexityBias();
     static void testCachedHullWhite();
+    static void testHullWhiteAnalyticGradient();
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
     static void testSwaps();
@@ -442,6 +442,170 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testIncrementalCalibration() {
+    BOOST_TEST_MESSAGE("Testing incremental sabr calibration of volatility cube...");
+
+    CommonVars vars;
+
+    Size nOptions = vars.cube.tenors.options.size();
+    Size nSwaps = vars.cube.tenors.swaps.size();
+    std::vector<std::vector<Handle<Quote> > > parametersGuess(nOptions*nSwaps);
+    for (Size i=0; i<nOptions*nSwaps; i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             false);
+
+    Matrix evaluations = volCube.sparseCalibrationEvaluations();
+    for (Size i=0; i<nOptions; i++)
+        for (Size j=0; j<nSwaps; j++)
+            if (evaluations[i][j] == 0.0)
+                BOOST_ERROR("node " << vars.cube.tenors.options[i] << "x"
+                            << vars.cube.tenors.swaps[j]
+                            << " not calibrated at first calculation");
+
+    // move a single smile quote...
+    Size changedOption = 1, changedSwap = 2;
+    boost::shared_ptr<SimpleQuote> quote =
+        boost::dynamic_pointer_cast<SimpleQuote>(
+            *vars.cube.volSpreadsHandle[changedOption*nSwaps+changedSwap][1]);
+    quote->setValue(quote->value() + 0.002);
+
+    // ...only its node must be recalibrated...
+    evaluations = volCube.sparseCalibrationEvaluations();
+    for (Size i=0; i<nOptions; i++) {
+        for (Size j=0; j<nSwaps; j++) {
+            bool changed = (i == changedOption && j == changedSwap);
+            if (changed != (evaluations[i][j] != 0.0))
+                BOOST_ERROR("node " << vars.cube.tenors.options[i] << "x"
+                            << vars.cube.tenors.swaps[j]
+                            << (changed ? " not recalibrated" :
+                                          " recalibrated")
+                            << " after change of a single quote"
+                            << "\n    evaluations: " << evaluations[i][j]);
+        }
+    }
+
+    // ...and the result must be the same as for a new cube
+    SwaptionVolCube1 newCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             false);
+
+    Matrix parameters = volCube.sparseSabrParameters();
+    Matrix expected = newCube.sparseSabrParameters();
+    for (Size i=0; i<parameters.rows(); i++)
+        for (Size j=0; j<parameters.columns(); j++)
+            if (std::fabs(parameters[i][j] - expected[i][j]) > 1.0e-14)
+                BOOST_ERROR("incrementally calibrated parameters differ"
+                            " from new calibration:"
+                            << "\n    row: " << i << ", column: " << j
+                            << "\n    calculated: " << parameters[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+
+    // with warm start, a recalibrated node starts from its previous
+    // solution; the fitted smiles must agree with a cold calibration
+    SwaptionVolCube1 warmCube(vars.atmVolMatrix,
+                              vars.cube.tenors.options,
+                              vars.cube.tenors.swaps,
+                              vars.cube.strikeSpreads,
+                              vars.cube.volSpreadsHandle,
+                              vars.swapIndexBase,
+                              vars.shortSwapIndexBase,
+                              vars.vegaWeighedSmileFit,
+                              parametersGuess,
+                              isParameterFixed,
+                              false,
+                              boost::shared_ptr<EndCriteria>(),
+                              Null<Real>(),
+                              boost::shared_ptr<OptimizationMethod>(),
+                              Null<Real>(),
+                              false,
+                              50,
+                              false,
+                              0.0001,
+                              true);
+    warmCube.sparseSabrParameters();
+
+    changedOption = 0;
+    changedSwap = 1;
+    quote = boost::dynamic_pointer_cast<SimpleQuote>(
+            *vars.cube.volSpreadsHandle[changedOption*nSwaps+changedSwap][2]);
+    quote->setValue(quote->value() - 0.003);
+
+    evaluations = warmCube.sparseCalibrationEvaluations();
+    if (evaluations[changedOption][changedSwap] == 0.0)
+        BOOST_ERROR("node " << vars.cube.tenors.options[changedOption]
+                    << "x" << vars.cube.tenors.swaps[changedSwap]
+                    << " not recalibrated with warm start");
+
+    SwaptionVolCube1 coldCube(vars.atmVolMatrix,
+                              vars.cube.tenors.options,
+                              vars.cube.tenors.swaps,
+                              vars.cube.strikeSpreads,
+                              vars.cube.volSpreadsHandle,
+                              vars.swapIndexBase,
+                              vars.shortSwapIndexBase,
+                              vars.vegaWeighedSmileFit,
+                              parametersGuess,
+                              isParameterFixed,
+                              false);
+
+    Real tolerance = 1.0e-6;
+    for (Size i=0; i<nOptions; i++) {
+        for (Size j=0; j<nSwaps; j++) {
+            const Period& optionTenor = vars.cube.tenors.options[i];
+            const Period& swapTenor = vars.cube.tenors.swaps[j];
+            Rate atmStrike = coldCube.atmStrike(optionTenor, swapTenor);
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = atmStrike + vars.cube.strikeSpreads[k];
+                Volatility warm =
+                    warmCube.volatility(optionTenor, swapTenor, strike, true);
+                Volatility cold =
+                    coldCube.volatility(optionTenor, swapTenor, strike, true);
+                if (std::fabs(warm - cold) > tolerance)
+                    BOOST_ERROR("warm-started calibration differs"
+                                " from cold calibration:"
+                                << "\n    option tenor:  " << optionTenor
+                                << "\n    swap tenor:    " << swapTenor
+                                << "\n    strike:        " << io::rate(strike)
+                                << "\n    warm start:    "
+                                << io::volatility(warm)
+                                << "\n    cold start:    "
+                                << io::volatility(cold)
+                                << "\n    tolerance:     "
+                                << io::volatility(tolerance));
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -456,6 +620,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(SwaptionVolatilityCubeTest::testSpreadedCube));
 
     suite->add(QUANTLIB_TEST_CASE(SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                      SwaptionVolatilityCubeTest::testIncrementalCalibration));
 
     return suite;
 }
@@ -24,6 +24,10 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define CHECK_DOWNCAST(Derived,Description) { \
     boost::shared_ptr<Derived> hd = boost::dynamic_pointer_cast<Derived>(h); \
     if (hd) \
@@ -130,4 +134,19 @@ namespace QuantLib {
         IndexManager::instance().clearHistories();
     }
 
+
+    #ifdef _OPENMP
+    SerialSection::SerialSection() : threads_(omp_get_max_threads()) {
+        omp_set_num_threads(1);
+    }
+
+    SerialSection::~SerialSection() {
+        omp_set_num_threads(threads_);
+    }
+    #else
+    SerialSection::SerialSection() : threads_(1) {}
+
+    SerialSection::~SerialSection() {}
+    #endif
+
 }
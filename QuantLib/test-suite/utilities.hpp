@@ -160,6 +160,18 @@ namespace QuantLib {
     };
 
 
+    /* this makes OpenMP regions run on a single thread while in scope,
+       so that results can be compared with the multi-threaded ones;
+       it does nothing if OpenMP is not enabled */
+    class SerialSection {
+      public:
+        SerialSection();
+        ~SerialSection();
+      private:
+        int threads_;
+    };
+
+
     // Allow streaming vectors to error messages.
 
     // The standard forbids defining new overloads in the std
@@ -88,9 +88,72 @@ void ZabrTest::testConsistency() {
     }
 }
 
+void ZabrTest::testBatchEvaluation() {
+
+    BOOST_TEST_MESSAGE("Testing batch evaluation of zabr smile sections...");
+
+    Real alpha = 0.08;
+    Real beta = 0.70;
+    Real nu = 0.20;
+    Real rho = -0.30;
+    Real gamma = 0.8;
+    Real tau = 5.0;
+    Real forward = 0.03;
+
+    ZabrSmileSection<ZabrShortMaturityLognormal> zabr0(
+        tau, forward, boost::assign::list_of(alpha)(beta)(nu)(rho)(gamma));
+
+    ZabrSmileSection<ZabrShortMaturityNormal> zabr1(
+        tau, forward, boost::assign::list_of(alpha)(beta)(nu)(rho)(gamma));
+
+    // unsorted, with duplicates and with a strike at the forward
+    std::vector<Rate> strikes;
+    for (Size i = 0; i < 100; ++i)
+        strikes.push_back(0.001 + 0.001 * ((37 * i) % 100));
+    strikes.push_back(forward);
+    strikes.push_back(strikes[10]);
+
+    // the batch integrates the ode once along the sorted strikes, which
+    // only differs from the single strike integration by the accuracy
+    // of the adaptive Runge-Kutta scheme
+    Real volTol = 1E-6, priceTol = 1E-7;
+
+    std::vector<Volatility> vols0, vols1;
+    std::vector<Real> calls0, calls1, puts1;
+    zabr0.volatilities(strikes, vols0);
+    zabr0.optionPrices(strikes, calls0);
+    zabr1.volatilities(strikes, vols1);
+    zabr1.optionPrices(strikes, calls1);
+    zabr1.optionPrices(strikes, puts1, Option::Put, 0.9);
+
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real k = strikes[i];
+        if (std::fabs(vols0[i] - zabr0.volatility(k)) > volTol ||
+            std::fabs(calls0[i] - zabr0.optionPrice(k)) > priceTol)
+            BOOST_ERROR("batch short maturity lognormal evaluation differs "
+                        "from single strike one at strike "
+                        << k << "\n    volatility: " << vols0[i] << " vs "
+                        << zabr0.volatility(k) << "\n    call:       "
+                        << calls0[i] << " vs " << zabr0.optionPrice(k));
+        if (std::fabs(vols1[i] - zabr1.volatility(k)) > volTol ||
+            std::fabs(calls1[i] - zabr1.optionPrice(k)) > priceTol ||
+            std::fabs(puts1[i] - zabr1.optionPrice(k, Option::Put, 0.9)) >
+                priceTol)
+            BOOST_ERROR("batch short maturity normal evaluation differs "
+                        "from single strike one at strike "
+                        << k << "\n    volatility: " << vols1[i] << " vs "
+                        << zabr1.volatility(k) << "\n    call:       "
+                        << calls1[i] << " vs " << zabr1.optionPrice(k)
+                        << "\n    put:        " << puts1[i] << " vs "
+                        << zabr1.optionPrice(k, Option::Put, 0.9));
+    }
+}
+
 test_suite *ZabrTest::suite(SpeedLevel speed) {
     test_suite *suite = BOOST_TEST_SUITE("Zabr model tests");
 
+    suite->add(QUANTLIB_TEST_CASE(ZabrTest::testBatchEvaluation));
+
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(ZabrTest::testConsistency));
     }
@@ -29,6 +29,7 @@
 class ZabrTest {
   public:
     static void testConsistency();
+    static void testBatchEvaluation();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -0,0 +1,33 @@
+#!/usr/bin/python
+
+# Writes the absorption table of the no-arbitrage SABR model from its
+# source ql/experimental/volatility/noarbsabrabsprobs.cpp in the format
+# read by NoArbSabrAbsorptionTable::load(); this is needed when the
+# library is built without the table (QL_NOARBSABR_EXTERNAL_TABLE).
+
+import re, struct, sys
+
+size = 1209600
+tag = b'QLNASAB1'
+
+if len(sys.argv) != 3:
+    sys.stderr.write('Usage: %s <noarbsabrabsprobs.cpp> <table file>\n'
+                     % sys.argv[0])
+    sys.exit(2)
+
+source = open(sys.argv[1]).read()
+start = source.find('{', source.find('sabrabsprob'))
+end = source.find('}', start)
+if start < 0 or end < 0:
+    sys.stderr.write('%s: absorption table not found\n' % sys.argv[1])
+    sys.exit(1)
+counts = [int(x) for x in re.findall(r'\d+', source[start+1:end])]
+if len(counts) != size:
+    sys.stderr.write('%s: %d absorption counts found, %d expected\n'
+                     % (sys.argv[1], len(counts), size))
+    sys.exit(1)
+
+out = open(sys.argv[2], 'wb')
+out.write(tag)
+out.write(struct.pack('<%dI' % size, *counts))
+out.close()